@@ -0,0 +1,53 @@
+#ifndef JML_CONCURRENT_HEAP_H
+#define JML_CONCURRENT_HEAP_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+#include "Heap.h"
+
+namespace JML
+{
+	// Relaxed concurrent priority queue in the style of a MultiQueue. Items are spread over queuesPerThread * numThreads locked heaps and
+	// pop takes the better top of two randomly chosen heaps, so popped items are close to, but not always exactly, the best item
+	template <typename T, bool (*comparator)(const T&, const T&) = heapGreater>
+	class ConcurrentHeap
+	{
+	private:
+		class SubQueue;
+
+	public:
+		ConcurrentHeap(std::size_t numThreads = std::thread::hardware_concurrency(), std::size_t queuesPerThread = 2);
+		ConcurrentHeap(const ConcurrentHeap<T, comparator>& heap) = delete;
+		ConcurrentHeap(ConcurrentHeap<T, comparator>&& heap) = delete;
+		~ConcurrentHeap();
+		ConcurrentHeap<T, comparator>& operator=(const ConcurrentHeap<T, comparator>& heap) = delete;
+		ConcurrentHeap<T, comparator>& operator=(ConcurrentHeap<T, comparator>&& heap) = delete;
+		std::size_t size() const;
+		bool empty() const;
+		std::size_t queueCount() const;
+		template <typename U> void insert(U&& item);
+		bool tryPop(T& item);
+		void clear();
+
+	private:
+		std::size_t numQueues{};
+		SubQueue* queues{};
+		std::atomic<std::size_t> numItems{ 0 };
+
+		std::size_t randomQueue();
+		bool popAny(T& item);
+
+		// Each heap is padded to its own cache line so that threads working on neighboring heaps don't contend
+		class alignas(64) SubQueue
+		{
+		public:
+			std::mutex lock{};
+			Heap<T, comparator> heap{};
+		};
+	};
+}
+#include "ConcurrentHeap.hpp"
+#endif
@@ -0,0 +1,161 @@
+#ifndef JML_CONCURRENT_HEAP_HPP
+#define JML_CONCURRENT_HEAP_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "Heap.h"
+
+namespace JML
+{
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	ConcurrentHeap<T, comparator>::ConcurrentHeap(std::size_t numThreads, std::size_t queuesPerThread) :
+		numQueues{ (numThreads ? numThreads : 1) * (queuesPerThread ? queuesPerThread : 1) }
+	{
+		// Sampling two distinct heaps needs at least two of them
+		if (numQueues < 2)
+			numQueues = 2;
+
+		queues = new SubQueue[numQueues];
+	}
+
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	ConcurrentHeap<T, comparator>::~ConcurrentHeap()
+	{
+		delete[] queues;
+	}
+
+	// Returns the number of items in the heap. Only exact while no other thread is inserting or popping
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	std::size_t ConcurrentHeap<T, comparator>::size() const
+	{
+		return numItems.load(std::memory_order_relaxed);
+	}
+
+	// Returns true if the heap has no items. Only exact while no other thread is inserting or popping
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	bool ConcurrentHeap<T, comparator>::empty() const
+	{
+		return numItems.load(std::memory_order_relaxed) == 0;
+	}
+
+	// Returns the number of internal heaps
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	std::size_t ConcurrentHeap<T, comparator>::queueCount() const
+	{
+		return numQueues;
+	}
+
+	// Inserts the given item into a random internal heap that isn't currently locked. Thread safe. Supports perfect forwarding
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	template <typename U> void ConcurrentHeap<T, comparator>::insert(U&& item)
+	{
+		while (true)
+		{
+			SubQueue& queue{ queues[randomQueue()] };
+			if (queue.lock.try_lock())
+			{
+				queue.heap.insert(static_cast<U&&>(item));
+				numItems.fetch_add(1, std::memory_order_relaxed);
+				queue.lock.unlock();
+				return;
+			}
+		}
+	}
+
+	// Moves the better of the tops of two random internal heaps into item and removes it. Returns false if the heap was empty. Thread safe
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	bool ConcurrentHeap<T, comparator>::tryPop(T& item)
+	{
+		for (std::size_t attempt{ 0 }; attempt < numQueues; ++attempt)
+		{
+			if (numItems.load(std::memory_order_relaxed) == 0)
+				return false;
+
+			std::size_t index1{ randomQueue() };
+			std::size_t index2{ randomQueue() };
+			if (index1 == index2)
+				index2 = (index2 + 1) % numQueues;
+
+			// Locking in index order and backing off on contention so that two poppers can never deadlock
+			SubQueue& queue1{ queues[index1 < index2 ? index1 : index2] };
+			SubQueue& queue2{ queues[index1 < index2 ? index2 : index1] };
+			if (!queue1.lock.try_lock())
+				continue;
+
+			if (!queue2.lock.try_lock())
+			{
+				queue1.lock.unlock();
+				continue;
+			}
+
+			SubQueue* best{ nullptr };
+			if (!queue1.heap.empty())
+				best = &queue1;
+
+			if (!queue2.heap.empty() && (!best || comparator(queue2.heap.top(), best->heap.top())))
+				best = &queue2;
+
+			if (best)
+			{
+				item = static_cast<T&&>(best->heap.top());
+				best->heap.pop();
+				numItems.fetch_sub(1, std::memory_order_relaxed);
+			}
+			queue2.lock.unlock();
+			queue1.lock.unlock();
+			if (best)
+				return true;
+		}
+		// Sampling keeps landing on empty or busy heaps, so falling back to a full scan
+		return popAny(item);
+	}
+
+	// Clears all items from the heap. Must not race with other operations
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void ConcurrentHeap<T, comparator>::clear()
+	{
+		for (std::size_t i{ 0 }; i < numQueues; ++i)
+		{
+			std::lock_guard<std::mutex> guard{ queues[i].lock };
+			queues[i].heap = Heap<T, comparator>{};
+		}
+		numItems.store(0, std::memory_order_relaxed);
+	}
+
+	// Returns a random heap index from a per-thread xorshift generator
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	std::size_t ConcurrentHeap<T, comparator>::randomQueue()
+	{
+		thread_local std::uint64_t state{ std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1 };
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return static_cast<std::size_t>(state % numQueues);
+	}
+
+	// Pops the top of the first non-empty heap. Returns false if every heap is empty
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	bool ConcurrentHeap<T, comparator>::popAny(T& item)
+	{
+		std::size_t start{ randomQueue() };
+		for (std::size_t i{ 0 }; i < numQueues; ++i)
+		{
+			SubQueue& queue{ queues[(start + i) % numQueues] };
+			std::lock_guard<std::mutex> guard{ queue.lock };
+			if (!queue.heap.empty())
+			{
+				item = static_cast<T&&>(queue.heap.top());
+				queue.heap.pop();
+				numItems.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+		return false;
+	}
+}
+#endif
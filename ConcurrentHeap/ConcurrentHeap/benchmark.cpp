@@ -0,0 +1,164 @@
+#if 0
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "ConcurrentHeap.h"
+#include "Heap.h"
+
+constexpr std::size_t OPS_PER_THREAD{ 1000000 };
+constexpr std::size_t PREFILL{ 1000000 };
+constexpr std::size_t RANK_ITEMS{ 1000000 };
+
+// Baseline: a single Heap behind one lock
+class LockedHeap
+{
+public:
+	template <typename U> void insert(U&& item)
+	{
+		std::lock_guard<std::mutex> guard{ lock };
+		heap.insert(static_cast<U&&>(item));
+	}
+
+	bool tryPop(int& item)
+	{
+		std::lock_guard<std::mutex> guard{ lock };
+		if (heap.empty())
+			return false;
+
+		item = heap.top();
+		heap.pop();
+		return true;
+	}
+
+private:
+	std::mutex lock{};
+	JML::Heap<int> heap{};
+};
+
+// Every thread alternates inserts and pops on a prefilled queue. Returns millions of operations per second
+template <typename Queue>
+double throughput(Queue& queue, std::size_t numThreads)
+{
+	std::mt19937 generator{ 7 };
+	for (std::size_t i{ 0 }; i < PREFILL; ++i)
+	{
+		queue.insert(static_cast<int>(generator() >> 1));
+	}
+
+	std::thread* threads{ new std::thread[numThreads] };
+	auto start{ std::chrono::steady_clock::now() };
+	for (std::size_t t{ 0 }; t < numThreads; ++t)
+	{
+		threads[t] = std::thread([&queue, t]()
+			{
+				std::mt19937 localGenerator{ static_cast<unsigned int>(t) };
+				int item{};
+				for (std::size_t i{ 0 }; i < OPS_PER_THREAD; ++i)
+				{
+					if (i % 2 == 0)
+						queue.insert(static_cast<int>(localGenerator() >> 1));
+					else
+						queue.tryPop(item);
+				}
+			});
+	}
+	for (std::size_t t{ 0 }; t < numThreads; ++t)
+	{
+		threads[t].join();
+	}
+	auto end{ std::chrono::steady_clock::now() };
+	delete[] threads;
+	double seconds{ std::chrono::duration<double>(end - start).count() };
+	return static_cast<double>(numThreads * OPS_PER_THREAD) / seconds / 1e6;
+}
+
+// Pops a prefilled heap of distinct keys from numThreads threads and measures how many better items were still in the heap at each pop
+void rankError(std::size_t numThreads)
+{
+	JML::ConcurrentHeap<int> heap{ numThreads };
+	for (std::size_t i{ 0 }; i < RANK_ITEMS; ++i)
+	{
+		heap.insert(static_cast<int>(i));
+	}
+
+	// Pops are ordered by the ticket taken right after each one
+	int* popOrder{ new int[RANK_ITEMS] };
+	std::atomic<std::size_t> ticket{ 0 };
+	std::thread* threads{ new std::thread[numThreads] };
+	for (std::size_t t{ 0 }; t < numThreads; ++t)
+	{
+		threads[t] = std::thread([&]()
+			{
+				int item{};
+				while (heap.tryPop(item))
+				{
+					popOrder[ticket.fetch_add(1)] = item;
+				}
+			});
+	}
+	for (std::size_t t{ 0 }; t < numThreads; ++t)
+	{
+		threads[t].join();
+	}
+	delete[] threads;
+
+	// A Fenwick tree over the keys counts the better (larger) keys that haven't been popped yet
+	std::size_t* tree{ new std::size_t[RANK_ITEMS + 1]{} };
+	for (std::size_t i{ 1 }; i <= RANK_ITEMS; ++i)
+	{
+		for (std::size_t j{ i }; j <= RANK_ITEMS; j += j & (~j + 1))
+		{
+			++tree[j];
+		}
+	}
+	double totalError{ 0 };
+	std::size_t maxError{ 0 };
+	for (std::size_t i{ 0 }; i < RANK_ITEMS; ++i)
+	{
+		std::size_t key{ static_cast<std::size_t>(popOrder[i]) + 1 };
+		std::size_t atOrBelow{ 0 };
+		for (std::size_t j{ key }; j > 0; j -= j & (~j + 1))
+		{
+			atOrBelow += tree[j];
+		}
+		std::size_t error{ (RANK_ITEMS - i) - atOrBelow };
+		totalError += static_cast<double>(error);
+		if (error > maxError)
+			maxError = error;
+
+		for (std::size_t j{ key }; j <= RANK_ITEMS; j += j & (~j + 1))
+		{
+			--tree[j];
+		}
+	}
+	std::cout << "  rank error with " << numThreads << " threads: mean " << totalError / RANK_ITEMS << ", max " << maxError << '\n';
+	delete[] tree;
+	delete[] popOrder;
+}
+
+int main()
+{
+	std::size_t maxThreads{ std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1 };
+	std::cout << "Throughput (million ops/s), 50% inserts and 50% pops:\n";
+	for (std::size_t numThreads{ 1 }; numThreads <= maxThreads; numThreads *= 2)
+	{
+		LockedHeap locked;
+		JML::ConcurrentHeap<int> concurrent{ numThreads };
+		double lockedOps{ throughput(locked, numThreads) };
+		double concurrentOps{ throughput(concurrent, numThreads) };
+		std::cout << "  " << numThreads << " threads: locked Heap " << lockedOps << ", ConcurrentHeap " << concurrentOps << '\n';
+	}
+
+	std::cout << "Rank error of popped items:\n";
+	for (std::size_t numThreads{ 1 }; numThreads <= maxThreads; numThreads *= 2)
+	{
+		rankError(numThreads);
+	}
+	return 0;
+}
+#endif
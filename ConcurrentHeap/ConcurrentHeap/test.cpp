@@ -0,0 +1,40 @@
+#if 1
+#include <iostream>
+#include <thread>
+
+#include "ConcurrentHeap.h"
+
+int main()
+{
+	constexpr int NUM_THREADS{ 4 };
+	constexpr int ITEMS_PER_THREAD{ 5 };
+	JML::ConcurrentHeap<int> heap{ NUM_THREADS };
+	std::cout << "Concurrent heap with " << heap.queueCount() << " internal heaps\n";
+
+	std::cout << "Inserting from " << NUM_THREADS << " threads\n";
+	std::thread threads[NUM_THREADS];
+	for (int i{ 0 }; i < NUM_THREADS; ++i)
+	{
+		threads[i] = std::thread([&heap, i]()
+			{
+				for (int j{ 0 }; j < ITEMS_PER_THREAD; ++j)
+				{
+					heap.insert(i * ITEMS_PER_THREAD + j);
+				}
+			});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	std::cout << "Size: " << heap.size() << '\n';
+
+	std::cout << "Popping (the order is only approximately descending)\n";
+	int item{};
+	while (heap.tryPop(item))
+	{
+		std::cout << item << '\n';
+	}
+	return 0;
+}
+#endif
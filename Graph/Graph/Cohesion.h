@@ -0,0 +1,34 @@
+#ifndef JML_COHESION_H
+#define JML_COHESION_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "CsrGraph.h"
+#include "Graph.h"
+#include "HashTable.h"
+#include "ThreadPool.h"
+
+namespace JML
+{
+	// Triangle counts, clustering coefficients and k-cores over CsrGraph snapshots. These read every edge as undirected and ignore self loops,
+	// edge weights and edges repeated in the other direction, so a graph that stores a -> b and b -> a for every undirected edge gives the
+	// same results as one that stores either. Transposed must be graph.transpose()
+	template <typename T, typename U, typename W>
+	std::size_t countTriangles(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, ThreadPool& pool);
+	template <typename T, typename U, typename W>
+	std::size_t countTriangles(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, std::size_t* triangles, ThreadPool& pool);
+	template <typename T, typename U, typename W>
+	std::size_t clusteringCoefficients(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, double* coefficients,
+		ThreadPool& pool);
+	template <typename T, typename U, typename W>
+	std::uint32_t coreNumbers(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, std::uint32_t* cores);
+	template <typename T, typename U, typename W>
+	std::size_t countTriangles(const Graph<T, U, W>& graph, ThreadPool& pool);
+	template <typename T, typename U, typename W>
+	HashTable<T, double> clusteringCoefficients(const Graph<T, U, W>& graph, ThreadPool& pool);
+	template <typename T, typename U, typename W>
+	HashTable<T, std::uint32_t> coreNumbers(const Graph<T, U, W>& graph);
+}
+#include "Cohesion.hpp"
+#endif
@@ -0,0 +1,521 @@
+#ifndef JML_COHESION_HPP
+#define JML_COHESION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "CsrGraph.h"
+#include "Graph.h"
+#include "HashTable.h"
+#include "Reordering.h"
+#include "ThreadPool.h"
+
+namespace JML
+{
+	// Calls common(id) for every id two ascending lists of distinct ids have in common and returns how many there are. Lists of similar
+	// length are merged a block of four ids at a time: every id of one block is compared with every id of the other without a branch, which
+	// the compiler turns into a few vector compares, and whichever block ends lower moves on. Only blocks with a match are searched again
+	// for it. A list much shorter than the other instead gallops through it, doubling its step until it passes each id and then binary
+	// searching the last step
+	template <typename F>
+	std::size_t intersect(const std::uint32_t* list1, std::size_t size1, const std::uint32_t* list2, std::size_t size2, F&& common)
+	{
+		constexpr std::size_t BLOCK{ 4 };
+		constexpr std::size_t GALLOP_RATIO{ 32 };
+
+		if (size1 > size2)
+		{
+			const std::uint32_t* swapList{ list1 };
+			list1 = list2;
+			list2 = swapList;
+			std::size_t swapSize{ size1 };
+			size1 = size2;
+			size2 = swapSize;
+		}
+
+		std::size_t count{ 0 };
+		if (size1 * GALLOP_RATIO < size2)
+		{
+			std::size_t low{ 0 };  // Every id of list2 before low is smaller than the next id of list1
+			for (std::size_t i{ 0 }; i < size1 && low < size2; ++i)
+			{
+				std::uint32_t id{ list1[i] };
+				std::size_t step{ 1 };
+				while (low + step < size2 && list2[low + step] < id)
+				{
+					step *= 2;
+				}
+				std::size_t high{ low + step < size2 ? low + step + 1 : size2 };
+				low += step / 2;
+				while (low < high)
+				{
+					std::size_t middle{ low + (high - low) / 2 };
+					if (list2[middle] < id)
+						low = middle + 1;
+					else
+						high = middle;
+				}
+				if (low < size2 && list2[low] == id)
+				{
+					common(id);
+					++count;
+					++low;
+				}
+			}
+			return count;
+		}
+
+		// A pair of ids counted here is never counted again, since at least one of the two blocks moves past it
+		std::size_t i{ 0 };
+		std::size_t j{ 0 };
+		while (i + BLOCK <= size1 && j + BLOCK <= size2)
+		{
+			std::size_t matches{ 0 };
+			for (std::size_t a{ 0 }; a < BLOCK; ++a)
+			{
+				for (std::size_t b{ 0 }; b < BLOCK; ++b)
+				{
+					matches += list1[i + a] == list2[j + b];
+				}
+			}
+			if (matches != 0)
+			{
+				for (std::size_t a{ 0 }; a < BLOCK; ++a)
+				{
+					for (std::size_t b{ 0 }; b < BLOCK; ++b)
+					{
+						if (list1[i + a] == list2[j + b])
+							common(list1[i + a]);
+					}
+				}
+			}
+			count += matches;
+			std::uint32_t last1{ list1[i + BLOCK - 1] };
+			std::uint32_t last2{ list2[j + BLOCK - 1] };
+			i += last1 <= last2 ? BLOCK : 0;
+			j += last2 <= last1 ? BLOCK : 0;
+		}
+		while (i < size1 && j < size2)
+		{
+			if (list1[i] < list2[j])
+				++i;
+			else if (list2[j] < list1[i])
+				++j;
+			else
+			{
+				common(list1[i]);
+				++count;
+				++i;
+				++j;
+			}
+		}
+		return count;
+	}
+
+	// Returns the number of ids two ascending lists of distinct ids have in common
+	inline std::size_t intersectionSize(const std::uint32_t* list1, std::size_t size1, const std::uint32_t* list2, std::size_t size2)
+	{
+		return intersect(list1, size1, list2, size2, [](std::uint32_t) {});
+	}
+
+	// Edges of a snapshot read as undirected, without self loops or repeats, over the vertices renumbered by rank: their place in order of
+	// edges in and out, from the fewest to the most. The neighbors of every rank are split into those of higher rank (above) and those of
+	// lower rank (below), each listed in ascending order, so every edge appears once from each end. Hubs rank last, so the above lists stay
+	// short however skewed the degrees are: none is longer than about the square root of twice the number of edges
+	class RankedAdjacency
+	{
+	public:
+		std::size_t numVerts{ 0 };
+		std::uint32_t* ids{ nullptr };  // Snapshot id of every rank
+		std::size_t* aboveOffsets{ nullptr };  // numVerts + 1 entries. The higher neighbors of rank r are above[aboveOffsets[r]] onward
+		std::uint32_t* above{ nullptr };
+		std::size_t* belowOffsets{ nullptr };
+		std::uint32_t* below{ nullptr };
+
+		template <typename T, typename U, typename W>
+		RankedAdjacency(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed);
+		RankedAdjacency(const RankedAdjacency& adjacency) = delete;
+		RankedAdjacency(RankedAdjacency&& adjacency) = delete;
+		~RankedAdjacency();
+		RankedAdjacency& operator=(const RankedAdjacency& adjacency) = delete;
+		RankedAdjacency& operator=(RankedAdjacency&& adjacency) = delete;
+		std::size_t degree(std::uint32_t rank) const;
+		std::size_t trianglesAsLowest(std::uint32_t rank) const;
+		template <typename F> std::size_t trianglesAsLowest(std::uint32_t rank, F&& found) const;
+	};
+
+	// Builds the lists in time linear in the size of the graph. Throws std::invalid_argument if transposed doesn't match the graph
+	template <typename T, typename U, typename W>
+	RankedAdjacency::RankedAdjacency(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed)
+	{
+		if (transposed.size() != graph.size() || transposed.edgeCount() != graph.edgeCount())
+			throw std::invalid_argument("Transposed doesn't match the graph");
+
+		numVerts = graph.size();
+		const std::size_t* offsets{ graph.offsetArray() };
+		const std::uint32_t* targets{ graph.targetArray() };
+		const std::size_t* inOffsets{ transposed.offsetArray() };
+		const std::uint32_t* inTargets{ transposed.targetArray() };
+		ids = new std::uint32_t[numVerts ? numVerts : 1];
+		sortByDegree(graph, transposed, ids, false);
+		std::uint32_t* ranks{ new std::uint32_t[numVerts ? numVerts : 1] };
+		for (std::uint32_t rank{ 0 }; rank < numVerts; ++rank)
+		{
+			ranks[ids[rank]] = rank;
+		}
+
+		// Every edge is listed at its higher end, as an outgoing edge or an incoming one, so counting them there bounds the above lists
+		aboveOffsets = new std::size_t[numVerts + 1]{};
+		for (std::uint32_t rank{ 0 }; rank < numVerts; ++rank)
+		{
+			std::uint32_t id{ ids[rank] };
+			for (const std::uint32_t* list : { targets, inTargets })
+			{
+				std::size_t begin{ list == targets ? offsets[id] : inOffsets[id] };
+				std::size_t end{ list == targets ? offsets[id + 1] : inOffsets[id + 1] };
+				for (std::size_t edge{ begin }; edge < end; ++edge)
+				{
+					if (ranks[list[edge]] < rank)
+						++aboveOffsets[ranks[list[edge]] + 1];
+				}
+			}
+		}
+		for (std::size_t rank{ 0 }; rank < numVerts; ++rank)
+		{
+			aboveOffsets[rank + 1] += aboveOffsets[rank];
+		}
+
+		// Visiting the higher ends in rank order appends to every list in ascending order, and the repeats of an edge come in a row
+		above = new std::uint32_t[aboveOffsets[numVerts] ? aboveOffsets[numVerts] : 1];
+		std::size_t* sizes{ new std::size_t[numVerts ? numVerts : 1]{} };
+		for (std::uint32_t rank{ 0 }; rank < numVerts; ++rank)
+		{
+			std::uint32_t id{ ids[rank] };
+			for (const std::uint32_t* list : { targets, inTargets })
+			{
+				std::size_t begin{ list == targets ? offsets[id] : inOffsets[id] };
+				std::size_t end{ list == targets ? offsets[id + 1] : inOffsets[id + 1] };
+				for (std::size_t edge{ begin }; edge < end; ++edge)
+				{
+					std::uint32_t lower{ ranks[list[edge]] };
+					if (lower >= rank)
+						continue;
+
+					std::uint32_t* lowerAbove{ above + aboveOffsets[lower] };
+					if (sizes[lower] == 0 || lowerAbove[sizes[lower] - 1] != rank)
+						lowerAbove[sizes[lower]++] = rank;
+				}
+			}
+		}
+		// Closing the gaps left by repeated edges
+		std::size_t next{ 0 };
+		for (std::size_t rank{ 0 }; rank < numVerts; ++rank)
+		{
+			std::size_t start{ aboveOffsets[rank] };
+			aboveOffsets[rank] = next;
+			for (std::size_t i{ 0 }; i < sizes[rank]; ++i)
+			{
+				above[next++] = above[start + i];
+			}
+		}
+		aboveOffsets[numVerts] = next;
+
+		// The below lists are the above lists transposed, filled in rank order so that they come out ascending too
+		belowOffsets = new std::size_t[numVerts + 1]{};
+		for (std::size_t i{ 0 }; i < next; ++i)
+		{
+			++belowOffsets[above[i] + 1];
+		}
+		for (std::size_t rank{ 0 }; rank < numVerts; ++rank)
+		{
+			belowOffsets[rank + 1] += belowOffsets[rank];
+			sizes[rank] = 0;
+		}
+		below = new std::uint32_t[next ? next : 1];
+		for (std::uint32_t rank{ 0 }; rank < numVerts; ++rank)
+		{
+			for (std::size_t i{ aboveOffsets[rank] }; i < aboveOffsets[rank + 1]; ++i)
+			{
+				below[belowOffsets[above[i]] + sizes[above[i]]++] = rank;
+			}
+		}
+		delete[] sizes;
+		delete[] ranks;
+	}
+
+	inline RankedAdjacency::~RankedAdjacency()
+	{
+		delete[] ids;
+		delete[] aboveOffsets;
+		delete[] above;
+		delete[] belowOffsets;
+		delete[] below;
+	}
+
+	// Returns the number of neighbors of the rank
+	inline std::size_t RankedAdjacency::degree(std::uint32_t rank) const
+	{
+		return aboveOffsets[rank + 1] - aboveOffsets[rank] + belowOffsets[rank + 1] - belowOffsets[rank];
+	}
+
+	// Returns the number of triangles the rank is the lowest corner of: the higher neighbors it shares with each of its higher neighbors.
+	// Summed over every rank, this counts every triangle once
+	inline std::size_t RankedAdjacency::trianglesAsLowest(std::uint32_t rank) const
+	{
+		const std::uint32_t* list{ above + aboveOffsets[rank] };
+		std::size_t size{ aboveOffsets[rank + 1] - aboveOffsets[rank] };
+		std::size_t count{ 0 };
+		for (std::size_t i{ 0 }; i < size; ++i)
+		{
+			std::uint32_t higher{ list[i] };
+			count += intersectionSize(list, size, above + aboveOffsets[higher], aboveOffsets[higher + 1] - aboveOffsets[higher]);
+		}
+		return count;
+	}
+
+	// Calls found(middle, highest) with the other two corners of every triangle the rank is the lowest corner of and returns how many there are
+	template <typename F>
+	std::size_t RankedAdjacency::trianglesAsLowest(std::uint32_t rank, F&& found) const
+	{
+		const std::uint32_t* list{ above + aboveOffsets[rank] };
+		std::size_t size{ aboveOffsets[rank + 1] - aboveOffsets[rank] };
+		std::size_t count{ 0 };
+		for (std::size_t i{ 0 }; i < size; ++i)
+		{
+			std::uint32_t higher{ list[i] };
+			count += intersect(list, size, above + aboveOffsets[higher], aboveOffsets[higher + 1] - aboveOffsets[higher], [&](std::uint32_t highest)
+				{
+					found(higher, highest);
+				});
+		}
+		return count;
+	}
+
+	// Calls store(rank, triangles) with the number of triangles through every rank and returns the number of triangles in the graph. Every
+	// triangle is found once, from its lowest corner, and counted for all three corners in an array of counts for each thread, so threads
+	// never write the same count. The arrays are added up in parallel over the ranks afterwards
+	template <typename F>
+	std::size_t countTrianglesByRank(const RankedAdjacency& adjacency, ThreadPool& pool, F&& store)
+	{
+		std::size_t numVerts{ adjacency.numVerts };
+		std::size_t numThreads{ pool.threadCount() };
+		std::size_t* counts{ new std::size_t[numThreads * numVerts + 1]{} };
+		std::size_t* totals{ new std::size_t[numThreads]{} };
+		pool.parallelFor(0, numVerts, [&](std::size_t begin, std::size_t end, std::size_t thread)
+			{
+				std::size_t* threadCounts{ counts + thread * numVerts };
+				std::size_t total{ 0 };
+				for (std::size_t rank{ begin }; rank < end; ++rank)
+				{
+					std::size_t found{ adjacency.trianglesAsLowest(static_cast<std::uint32_t>(rank), [&](std::uint32_t middle, std::uint32_t highest)
+						{
+							++threadCounts[middle];
+							++threadCounts[highest];
+						}) };
+					threadCounts[rank] += found;
+					total += found;
+				}
+				totals[thread] += total;
+			});
+		pool.parallelFor(0, numVerts, [&](std::size_t begin, std::size_t end, std::size_t)
+			{
+				for (std::size_t rank{ begin }; rank < end; ++rank)
+				{
+					std::size_t count{ 0 };
+					for (std::size_t thread{ 0 }; thread < numThreads; ++thread)
+					{
+						count += counts[thread * numVerts + rank];
+					}
+					store(static_cast<std::uint32_t>(rank), count);
+				}
+			});
+		std::size_t total{ 0 };
+		for (std::size_t thread{ 0 }; thread < numThreads; ++thread)
+		{
+			total += totals[thread];
+		}
+		delete[] counts;
+		delete[] totals;
+		return total;
+	}
+
+	// Returns the number of triangles in the graph. Every edge is kept at its end of fewer edges, and the triangles of every vertex are the
+	// higher neighbors it shares with each of its higher neighbors, intersected in parallel over the vertices. Throws std::invalid_argument if
+	// transposed doesn't match the graph
+	template <typename T, typename U, typename W>
+	std::size_t countTriangles(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, ThreadPool& pool)
+	{
+		RankedAdjacency adjacency{ graph, transposed };
+		std::size_t numThreads{ pool.threadCount() };
+		std::size_t* totals{ new std::size_t[numThreads]{} };
+		pool.parallelFor(0, adjacency.numVerts, [&](std::size_t begin, std::size_t end, std::size_t thread)
+			{
+				std::size_t total{ 0 };
+				for (std::size_t rank{ begin }; rank < end; ++rank)
+				{
+					total += adjacency.trianglesAsLowest(static_cast<std::uint32_t>(rank));
+				}
+				totals[thread] += total;
+			});
+		std::size_t total{ 0 };
+		for (std::size_t thread{ 0 }; thread < numThreads; ++thread)
+		{
+			total += totals[thread];
+		}
+		delete[] totals;
+		return total;
+	}
+
+	// Writes the number of triangles through every vertex into triangles (graph.size() entries) and returns the number of triangles in the
+	// graph. Keeps a count for every vertex in every thread of the pool while it runs. Throws std::invalid_argument if transposed doesn't
+	// match the graph
+	template <typename T, typename U, typename W>
+	std::size_t countTriangles(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, std::size_t* triangles, ThreadPool& pool)
+	{
+		RankedAdjacency adjacency{ graph, transposed };
+		return countTrianglesByRank(adjacency, pool, [&](std::uint32_t rank, std::size_t count)
+			{
+				triangles[adjacency.ids[rank]] = count;
+			});
+	}
+
+	// Writes the local clustering coefficient of every vertex into coefficients (graph.size() entries): the fraction of pairs of its
+	// neighbors that are neighbors themselves, or 0 for vertices with fewer than two neighbors. Returns the number of triangles in the graph.
+	// Throws std::invalid_argument if transposed doesn't match the graph
+	template <typename T, typename U, typename W>
+	std::size_t clusteringCoefficients(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, double* coefficients,
+		ThreadPool& pool)
+	{
+		RankedAdjacency adjacency{ graph, transposed };
+		return countTrianglesByRank(adjacency, pool, [&](std::uint32_t rank, std::size_t count)
+			{
+				double degree{ static_cast<double>(adjacency.degree(rank)) };
+				coefficients[adjacency.ids[rank]] = degree < 2 ? 0.0 : 2.0 * static_cast<double>(count) / (degree * (degree - 1));
+			});
+	}
+
+	// Writes the core number of every vertex into cores (graph.size() entries) and returns the largest, the graph's degeneracy. The k-core is
+	// the largest subgraph whose vertices all have at least k neighbors in it, and a vertex's core number is the largest k whose core holds
+	// it. Peels the vertex of fewest remaining neighbors until none are left, in linear time (Batagelj and Zaversnik): the vertices sit in
+	// an array sorted by remaining degree with the start of every degree's bucket alongside, so a neighbor that loses an edge swaps to the
+	// front of its bucket and the bucket boundary moves past it. Throws std::invalid_argument if transposed doesn't match the graph
+	template <typename T, typename U, typename W>
+	std::uint32_t coreNumbers(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, std::uint32_t* cores)
+	{
+		RankedAdjacency adjacency{ graph, transposed };
+		std::size_t numVerts{ adjacency.numVerts };
+		if (numVerts == 0)
+			return 0;
+
+		std::uint32_t* degrees{ new std::uint32_t[numVerts] };
+		std::uint32_t maxDegree{ 0 };
+		for (std::uint32_t rank{ 0 }; rank < numVerts; ++rank)
+		{
+			degrees[rank] = static_cast<std::uint32_t>(adjacency.degree(rank));
+			if (degrees[rank] > maxDegree)
+				maxDegree = degrees[rank];
+		}
+		std::size_t* starts{ new std::size_t[maxDegree + 2]{} };
+		for (std::uint32_t rank{ 0 }; rank < numVerts; ++rank)
+		{
+			++starts[degrees[rank] + 1];
+		}
+		for (std::uint32_t degree{ 0 }; degree <= maxDegree; ++degree)
+		{
+			starts[degree + 1] += starts[degree];
+		}
+		std::uint32_t* sorted{ new std::uint32_t[numVerts] };
+		std::size_t* positions{ new std::size_t[numVerts] };
+		for (std::uint32_t rank{ 0 }; rank < numVerts; ++rank)
+		{
+			positions[rank] = starts[degrees[rank]]++;
+			sorted[positions[rank]] = rank;
+		}
+		// Filling moved every start to the start of the next bucket, so shifting them back by one restores them
+		for (std::uint32_t degree{ maxDegree + 1 }; degree > 0; --degree)
+		{
+			starts[degree] = starts[degree - 1];
+		}
+		starts[0] = 0;
+
+		for (std::size_t i{ 0 }; i < numVerts; ++i)
+		{
+			std::uint32_t rank{ sorted[i] };
+			for (const std::uint32_t* list : { adjacency.below, adjacency.above })
+			{
+				const std::size_t* offsets{ list == adjacency.below ? adjacency.belowOffsets : adjacency.aboveOffsets };
+				for (std::size_t edge{ offsets[rank] }; edge < offsets[rank + 1]; ++edge)
+				{
+					std::uint32_t neighbor{ list[edge] };
+					if (degrees[neighbor] <= degrees[rank])
+						continue;
+
+					std::uint32_t degree{ degrees[neighbor] };
+					std::size_t first{ starts[degree] };
+					std::uint32_t firstRank{ sorted[first] };
+					sorted[first] = neighbor;
+					sorted[positions[neighbor]] = firstRank;
+					positions[firstRank] = positions[neighbor];
+					positions[neighbor] = first;
+					++starts[degree];
+					--degrees[neighbor];
+				}
+			}
+		}
+
+		std::uint32_t degeneracy{ 0 };
+		for (std::uint32_t rank{ 0 }; rank < numVerts; ++rank)
+		{
+			cores[adjacency.ids[rank]] = degrees[rank];
+			if (degrees[rank] > degeneracy)
+				degeneracy = degrees[rank];
+		}
+		delete[] degrees;
+		delete[] starts;
+		delete[] sorted;
+		delete[] positions;
+		return degeneracy;
+	}
+
+	// Returns the number of triangles in the graph, counted on a frozen snapshot as the CsrGraph overload does
+	template <typename T, typename U, typename W>
+	std::size_t countTriangles(const Graph<T, U, W>& graph, ThreadPool& pool)
+	{
+		CsrGraph<T, U, W> frozen{ graph.freeze() };
+		return countTriangles(frozen, frozen.transpose(), pool);
+	}
+
+	// Returns the local clustering coefficient of every vertex key, computed on a frozen snapshot as the CsrGraph overload does
+	template <typename T, typename U, typename W>
+	HashTable<T, double> clusteringCoefficients(const Graph<T, U, W>& graph, ThreadPool& pool)
+	{
+		CsrGraph<T, U, W> frozen{ graph.freeze() };
+		double* coefficients{ new double[frozen.size() ? frozen.size() : 1] };
+		clusteringCoefficients(frozen, frozen.transpose(), coefficients, pool);
+		HashTable<T, double> result{ frozen.size() ? frozen.size() : 1 };
+		for (std::uint32_t id{ 0 }; id < frozen.size(); ++id)
+		{
+			result.insert(frozen.key(id), coefficients[id]);
+		}
+		delete[] coefficients;
+		return result;
+	}
+
+	// Returns the core number of every vertex key, computed on a frozen snapshot as the CsrGraph overload does
+	template <typename T, typename U, typename W>
+	HashTable<T, std::uint32_t> coreNumbers(const Graph<T, U, W>& graph)
+	{
+		CsrGraph<T, U, W> frozen{ graph.freeze() };
+		std::uint32_t* cores{ new std::uint32_t[frozen.size() ? frozen.size() : 1] };
+		coreNumbers(frozen, frozen.transpose(), cores);
+		HashTable<T, std::uint32_t> result{ frozen.size() ? frozen.size() : 1 };
+		for (std::uint32_t id{ 0 }; id < frozen.size(); ++id)
+		{
+			result.insert(frozen.key(id), cores[id]);
+		}
+		delete[] cores;
+		return result;
+	}
+}
+#endif
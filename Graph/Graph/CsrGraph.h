@@ -0,0 +1,76 @@
+#ifndef JML_CSR_GRAPH_H
+#define JML_CSR_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "Graph.h"
+#include "HashTable.h"
+
+namespace JML
+{
+	// Immutable compressed sparse row snapshot of a Graph. Vertices get dense ids from 0 to size() - 1 and the outgoing edges of vertex id are
+	// targets[offsets[id]] to targets[offsets[id + 1] - 1] (with matching weights), so traversals read memory sequentially. A snapshot of an
+	// unweighted graph (W is void) has no weight array. A snapshot of an undirected Graph lists every edge from both ends and remembers that
+	// it's undirected, so hasCycle looks for undirected cycles and the algorithms that need directed edges refuse it
+	template <typename T, typename U = T, typename W = int>
+	class CsrGraph
+	{
+		template <typename T1, typename U1, typename W1> friend class CsrGraph;
+
+	public:
+		using Weight = typename EdgeWeight<W>::Stored;
+		using Distance = typename EdgeWeight<W>::Distance;
+
+		static constexpr bool WEIGHTED{ !std::is_void_v<W> };
+		static constexpr Distance UNREACHABLE{ -1 };  // Distance reported for vertices that can't be reached from the source
+
+		CsrGraph(const Graph<T, U, W>& graph);
+		CsrGraph(const CsrGraph<T, U, W>& graph);  // Copy constructor
+		CsrGraph(CsrGraph<T, U, W>&& graph) noexcept;  // Move constructor
+		~CsrGraph();
+		CsrGraph<T, U, W>& operator=(const CsrGraph<T, U, W>& graph);  // Copy assignment
+		CsrGraph<T, U, W>& operator=(CsrGraph<T, U, W>&& graph) noexcept;  // Move assignment
+		bool empty() const;
+		bool directed() const;
+		std::size_t size() const;
+		std::size_t edgeCount() const;
+		bool contains(const T& key) const;
+		std::uint32_t id(const T& key) const;
+		const T& key(std::uint32_t id) const;
+		const U& value(std::uint32_t id) const;
+		std::size_t degree(std::uint32_t id) const;
+		const std::size_t* offsetArray() const;
+		const std::uint32_t* targetArray() const;
+		const Weight* weightArray() const;
+		std::size_t bfs(std::uint32_t source, std::uint32_t* order) const;
+		std::size_t dfs(std::uint32_t source, std::uint32_t* order) const;
+		void dijkstra(std::uint32_t source, Distance* distances) const;
+		std::size_t topologicalSort(std::uint32_t* order) const;
+		std::size_t connectedComponents(std::uint32_t* components) const;
+		std::size_t stronglyConnectedComponents(std::uint32_t* components) const;
+		bool hasCycle() const;
+		CsrGraph<std::uint32_t, std::uint32_t, W> condensation(const std::uint32_t* components, std::size_t numComponents) const;
+		CsrGraph<T, U, W> transpose() const;
+		CsrGraph<T, U, W> relabel(const std::uint32_t* order) const;
+
+	private:
+		std::size_t numVerts{ 0 };
+		std::size_t numEdges{ 0 };
+		T* keys{ nullptr };
+		U* values{ nullptr };
+		std::size_t* offsets{ nullptr };  // numVerts + 1 entries
+		std::uint32_t* targets{ nullptr };
+		Weight* weights{ nullptr };  // Stays nullptr for unweighted graphs
+		HashTable<T, std::uint32_t> idTable{};
+		bool undirected{ false };
+
+		CsrGraph();
+		void copyFrom(const CsrGraph<T, U, W>& graph);
+		void release();
+		void checkId(std::uint32_t id) const;
+	};
+}
+#include "CsrGraph.hpp"
+#endif
@@ -0,0 +1,835 @@
+#ifndef JML_CSR_GRAPH_HPP
+#define JML_CSR_GRAPH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "Graph.h"
+#include "HashTable.h"
+#include "Heap.h"
+#include "Stack.h"
+
+namespace JML
+{
+	// Queue entry for searches over dense vertex ids
+	template <typename D>
+	struct IdDistance
+	{
+		std::uint32_t id{};
+		D distance{};
+	};
+
+	template <typename D>
+	bool closerDistance(const IdDistance<D>& pair1, const IdDistance<D>& pair2)
+	{
+		return pair1.distance < pair2.distance;
+	}
+
+	// Depth-first search frame: a vertex and the next of its edges to follow
+	struct IdEdge
+	{
+		std::uint32_t id{};
+		std::size_t edge{};
+	};
+
+	// Builds the snapshot from the current state of the given graph
+	template <typename T, typename U, typename W>
+	CsrGraph<T, U, W>::CsrGraph(const Graph<T, U, W>& graph) :
+		numVerts{ graph.size() }, keys{ new T[graph.size()] }, values{ new U[graph.size()] }, offsets{ new std::size_t[graph.size() + 1] },
+		idTable{ graph.size() ? graph.size() : 1 }, undirected{ !graph.directed() }
+	{
+		// First pass: assigning ids in graph id order, which closes the gaps left by removed vertices, and counting edges
+		std::uint32_t* remap{ new std::uint32_t[graph.idBound() ? graph.idBound() : 1] };
+		std::uint32_t nextId{ 0 };
+		offsets[0] = 0;
+		for (std::size_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			const typename Graph<T, U, W>::Vertex* vertex{ graph.vertexAt(index) };
+			if (!vertex)
+				continue;
+
+			keys[nextId] = vertex->key;
+			values[nextId] = vertex->value;
+			idTable[vertex->key] = nextId;
+			remap[index] = nextId;
+			offsets[nextId + 1] = offsets[nextId] + vertex->edges.size();
+			++nextId;
+		}
+		numEdges = offsets[numVerts];
+		targets = new std::uint32_t[numEdges];
+		if constexpr (WEIGHTED)
+			weights = new Weight[numEdges];
+
+		// Second pass: translating edge targets to snapshot ids
+		std::size_t edge{ 0 };
+		for (std::size_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			const typename Graph<T, U, W>::Vertex* vertex{ graph.vertexAt(index) };
+			if (!vertex)
+				continue;
+
+			for (const auto& [target, weight] : vertex->edges.pairs())
+			{
+				targets[edge] = remap[target.index];
+				if constexpr (WEIGHTED)
+					weights[edge] = weight;
+				++edge;
+			}
+		}
+		delete[] remap;
+	}
+
+	// Creates an empty graph for transpose to fill
+	template <typename T, typename U, typename W>
+	CsrGraph<T, U, W>::CsrGraph()
+	{}
+
+	// Copy constructor
+	template <typename T, typename U, typename W>
+	CsrGraph<T, U, W>::CsrGraph(const CsrGraph<T, U, W>& graph) :
+		idTable{ graph.idTable }
+	{
+		copyFrom(graph);
+	}
+
+	// Move constructor
+	template <typename T, typename U, typename W>
+	CsrGraph<T, U, W>::CsrGraph(CsrGraph<T, U, W>&& graph) noexcept :
+		numVerts{ graph.numVerts }, numEdges{ graph.numEdges }, keys{ graph.keys }, values{ graph.values }, offsets{ graph.offsets },
+		targets{ graph.targets }, weights{ graph.weights }, idTable{ static_cast<HashTable<T, std::uint32_t>&&>(graph.idTable) },
+		undirected{ graph.undirected }
+	{
+		// Leaving the old graph as a valid empty graph
+		graph.numVerts = 0;
+		graph.numEdges = 0;
+		graph.keys = nullptr;
+		graph.values = nullptr;
+		graph.offsets = nullptr;
+		graph.targets = nullptr;
+		graph.weights = nullptr;
+	}
+
+	template <typename T, typename U, typename W>
+	CsrGraph<T, U, W>::~CsrGraph()
+	{
+		release();
+	}
+
+	// Copy assignment
+	template <typename T, typename U, typename W>
+	CsrGraph<T, U, W>& CsrGraph<T, U, W>::operator=(const CsrGraph<T, U, W>& graph)
+	{
+		if (&graph == this)
+			return *this;
+
+		release();
+		idTable = graph.idTable;
+		copyFrom(graph);
+		return *this;
+	}
+
+	// Move assignment
+	template <typename T, typename U, typename W>
+	CsrGraph<T, U, W>& CsrGraph<T, U, W>::operator=(CsrGraph<T, U, W>&& graph) noexcept
+	{
+		if (&graph == this)
+			return *this;
+
+		release();
+		numVerts = graph.numVerts;
+		numEdges = graph.numEdges;
+		keys = graph.keys;
+		values = graph.values;
+		offsets = graph.offsets;
+		targets = graph.targets;
+		weights = graph.weights;
+		idTable = static_cast<HashTable<T, std::uint32_t>&&>(graph.idTable);
+		undirected = graph.undirected;
+
+		graph.numVerts = 0;
+		graph.numEdges = 0;
+		graph.keys = nullptr;
+		graph.values = nullptr;
+		graph.offsets = nullptr;
+		graph.targets = nullptr;
+		graph.weights = nullptr;
+
+		return *this;
+	}
+
+	// Returns true if there aren't any vertices in the graph
+	template <typename T, typename U, typename W>
+	bool CsrGraph<T, U, W>::empty() const
+	{
+		return numVerts == 0;
+	}
+
+	// Returns false if the snapshot was taken of an undirected graph
+	template <typename T, typename U, typename W>
+	bool CsrGraph<T, U, W>::directed() const
+	{
+		return !undirected;
+	}
+
+	// Returns the number of vertices in the graph
+	template <typename T, typename U, typename W>
+	std::size_t CsrGraph<T, U, W>::size() const
+	{
+		return numVerts;
+	}
+
+	// Returns the number of edges in the graph
+	template <typename T, typename U, typename W>
+	std::size_t CsrGraph<T, U, W>::edgeCount() const
+	{
+		return numEdges;
+	}
+
+	// Returns true if the graph contains a vertex with the given key
+	template <typename T, typename U, typename W>
+	bool CsrGraph<T, U, W>::contains(const T& key) const
+	{
+		return idTable.contains(key);
+	}
+
+	// Returns the dense id of the vertex with the given key. Throws std::invalid_argument if no vertex with the given key exists
+	template <typename T, typename U, typename W>
+	std::uint32_t CsrGraph<T, U, W>::id(const T& key) const
+	{
+		if (idTable.contains(key))
+			return idTable[key];
+
+		throw std::invalid_argument("Not a valid vertex key");
+	}
+
+	// Returns the key of the vertex with the given id. Throws std::out_of_range if the id is invalid
+	template <typename T, typename U, typename W>
+	const T& CsrGraph<T, U, W>::key(std::uint32_t id) const
+	{
+		checkId(id);
+		return keys[id];
+	}
+
+	// Returns the value of the vertex with the given id. Throws std::out_of_range if the id is invalid
+	template <typename T, typename U, typename W>
+	const U& CsrGraph<T, U, W>::value(std::uint32_t id) const
+	{
+		checkId(id);
+		return values[id];
+	}
+
+	// Returns the number of outgoing edges of the vertex with the given id. Throws std::out_of_range if the id is invalid
+	template <typename T, typename U, typename W>
+	std::size_t CsrGraph<T, U, W>::degree(std::uint32_t id) const
+	{
+		checkId(id);
+		return offsets[id + 1] - offsets[id];
+	}
+
+	// Returns the offset array (size() + 1 entries). The edges of vertex id occupy the range [offsets[id], offsets[id + 1])
+	template <typename T, typename U, typename W>
+	const std::size_t* CsrGraph<T, U, W>::offsetArray() const
+	{
+		return offsets;
+	}
+
+	// Returns the edge target id array (edgeCount() entries)
+	template <typename T, typename U, typename W>
+	const std::uint32_t* CsrGraph<T, U, W>::targetArray() const
+	{
+		return targets;
+	}
+
+	// Returns the edge weight array (edgeCount() entries), or nullptr for an unweighted graph
+	template <typename T, typename U, typename W>
+	const typename CsrGraph<T, U, W>::Weight* CsrGraph<T, U, W>::weightArray() const
+	{
+		return weights;
+	}
+
+	// Writes the ids of the vertices reachable from source into order in breadth-first order. Order must have room for size() ids. Returns the
+	// number of ids written. Throws std::out_of_range if the id is invalid
+	template <typename T, typename U, typename W>
+	std::size_t CsrGraph<T, U, W>::bfs(std::uint32_t source, std::uint32_t* order) const
+	{
+		checkId(source);
+		std::uint64_t* visited{ new std::uint64_t[(numVerts + 63) / 64]{} };
+		// The output doubles as the queue: everything between head and tail is waiting to be expanded
+		std::size_t head{ 0 };
+		std::size_t tail{ 0 };
+		order[tail++] = source;
+		visited[source / 64] |= std::uint64_t{ 1 } << (source % 64);
+		while (head < tail)
+		{
+			std::uint32_t current{ order[head++] };
+			for (std::size_t edge{ offsets[current] }; edge < offsets[current + 1]; ++edge)
+			{
+				std::uint32_t target{ targets[edge] };
+				std::uint64_t bit{ std::uint64_t{ 1 } << (target % 64) };
+				if (!(visited[target / 64] & bit))
+				{
+					visited[target / 64] |= bit;
+					order[tail++] = target;
+				}
+			}
+		}
+		delete[] visited;
+		return tail;
+	}
+
+	// Writes the ids of the vertices reachable from source into order in depth-first preorder. Order must have room for size() ids. Returns the
+	// number of ids written. Throws std::out_of_range if the id is invalid
+	template <typename T, typename U, typename W>
+	std::size_t CsrGraph<T, U, W>::dfs(std::uint32_t source, std::uint32_t* order) const
+	{
+		checkId(source);
+		std::uint64_t* visited{ new std::uint64_t[(numVerts + 63) / 64]{} };
+		// Each stack frame remembers the next edge to follow, so every vertex is on the stack at most once
+		std::uint32_t* vertexStack{ new std::uint32_t[numVerts] };
+		std::size_t* edgeStack{ new std::size_t[numVerts] };
+		std::size_t stackSize{ 0 };
+		std::size_t count{ 0 };
+		order[count++] = source;
+		visited[source / 64] |= std::uint64_t{ 1 } << (source % 64);
+		vertexStack[stackSize] = source;
+		edgeStack[stackSize++] = offsets[source];
+		while (stackSize > 0)
+		{
+			std::uint32_t current{ vertexStack[stackSize - 1] };
+			std::size_t& edge{ edgeStack[stackSize - 1] };
+			if (edge == offsets[current + 1])
+			{
+				--stackSize;
+				continue;
+			}
+			std::uint32_t target{ targets[edge++] };
+			std::uint64_t bit{ std::uint64_t{ 1 } << (target % 64) };
+			if (!(visited[target / 64] & bit))
+			{
+				visited[target / 64] |= bit;
+				order[count++] = target;
+				vertexStack[stackSize] = target;
+				edgeStack[stackSize++] = offsets[target];
+			}
+		}
+		delete[] edgeStack;
+		delete[] vertexStack;
+		delete[] visited;
+		return count;
+	}
+
+	// Writes the shortest path distance from source to every vertex into distances (size() entries), or UNREACHABLE. Edge weights must not be
+	// negative, and every edge of an unweighted graph has length one. Throws std::out_of_range if the id is invalid
+	template <typename T, typename U, typename W>
+	void CsrGraph<T, U, W>::dijkstra(std::uint32_t source, Distance* distances) const
+	{
+		checkId(source);
+		for (std::size_t i{ 0 }; i < numVerts; ++i)
+		{
+			distances[i] = UNREACHABLE;
+		}
+		distances[source] = 0;
+		Heap<IdDistance<Distance>, closerDistance<Distance>> queue;
+		queue.insert(IdDistance<Distance>{ source, 0 });
+		while (!queue.empty())
+		{
+			IdDistance<Distance> current{ queue.top() };
+			queue.pop();
+			// Skipping entries made stale by a shorter path found after they were queued
+			if (current.distance != distances[current.id])
+				continue;
+
+			for (std::size_t edge{ offsets[current.id] }; edge < offsets[current.id + 1]; ++edge)
+			{
+				Distance distance{ current.distance };
+				if constexpr (WEIGHTED)
+					distance += EdgeWeight<W>::length(weights[edge]);
+				else
+					++distance;
+				std::uint32_t target{ targets[edge] };
+				if (distances[target] == UNREACHABLE || distance < distances[target])
+				{
+					distances[target] = distance;
+					queue.insert(IdDistance<Distance>{ target, distance });
+				}
+			}
+		}
+	}
+
+	// Writes the vertex ids into order so that every edge goes from an earlier vertex to a later one (Kahn's algorithm). Order must have room
+	// for size() ids. Returns the number of ids written, which is less than size() if the graph has a cycle. Throws std::logic_error if the
+	// snapshot is of an undirected graph
+	template <typename T, typename U, typename W>
+	std::size_t CsrGraph<T, U, W>::topologicalSort(std::uint32_t* order) const
+	{
+		if (undirected)
+			throw std::logic_error("The graph is undirected");
+
+		std::size_t* inDegrees{ new std::size_t[numVerts]{} };
+		for (std::size_t edge{ 0 }; edge < numEdges; ++edge)
+		{
+			++inDegrees[targets[edge]];
+		}
+
+		// The output doubles as the queue of vertices whose incoming edges have all been placed
+		std::size_t head{ 0 };
+		std::size_t tail{ 0 };
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			if (inDegrees[id] == 0)
+				order[tail++] = static_cast<std::uint32_t>(id);
+		}
+		while (head < tail)
+		{
+			std::uint32_t current{ order[head++] };
+			for (std::size_t edge{ offsets[current] }; edge < offsets[current + 1]; ++edge)
+			{
+				if (--inDegrees[targets[edge]] == 0)
+					order[tail++] = targets[edge];
+			}
+		}
+		delete[] inDegrees;
+		return tail;
+	}
+
+	// Writes the weakly connected component of every vertex into components (size() entries), numbering components from 0 in order of their
+	// lowest vertex id. Returns the number of components
+	template <typename T, typename U, typename W>
+	std::size_t CsrGraph<T, U, W>::connectedComponents(std::uint32_t* components) const
+	{
+		// Union-find over the edges with path halving. Components first holds parent links and is relabeled at the end
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			components[id] = static_cast<std::uint32_t>(id);
+		}
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			for (std::size_t edge{ offsets[id] }; edge < offsets[id + 1]; ++edge)
+			{
+				std::uint32_t root1{ static_cast<std::uint32_t>(id) };
+				while (components[root1] != root1)
+				{
+					components[root1] = components[components[root1]];
+					root1 = components[root1];
+				}
+				std::uint32_t root2{ targets[edge] };
+				while (components[root2] != root2)
+				{
+					components[root2] = components[components[root2]];
+					root2 = components[root2];
+				}
+				// Linking the larger root under the smaller one keeps every root the lowest id of its component
+				if (root1 < root2)
+					components[root2] = root1;
+				else
+					components[root1] = root2;
+			}
+		}
+
+		// Roots come before the other members of their component, so a single ascending pass can relabel everything
+		std::size_t numComponents{ 0 };
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			if (components[id] == id)
+				components[id] = static_cast<std::uint32_t>(numComponents++);
+			else
+				components[id] = components[components[id]];
+		}
+		return numComponents;
+	}
+
+	// Writes the strongly connected component of every vertex into components (size() entries) and returns the number of components. Components
+	// are numbered in topological order, so every edge between two components goes from the lower number to the higher one. Uses Tarjan's
+	// algorithm with an explicit stack, so deep graphs can't overflow the call stack. Throws std::logic_error if the snapshot is of an undirected
+	// graph, whose strongly connected components would just be its connected components
+	template <typename T, typename U, typename W>
+	std::size_t CsrGraph<T, U, W>::stronglyConnectedComponents(std::uint32_t* components) const
+	{
+		if (undirected)
+			throw std::logic_error("The graph is undirected");
+
+		constexpr std::uint32_t UNSET{ ~std::uint32_t{ 0 } };
+		std::uint32_t* indices{ new std::uint32_t[numVerts] };  // Discovery order of every vertex
+		std::uint32_t* lowLinks{ new std::uint32_t[numVerts] };  // Lowest index reachable through the vertex's DFS subtree and one back edge
+		std::uint32_t* tarjanStack{ new std::uint32_t[numVerts] };  // Visited vertices not yet assigned to a component
+		std::size_t tarjanSize{ 0 };
+		Stack<IdEdge> frames;
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			indices[id] = UNSET;
+			// A visited vertex is on the Tarjan stack exactly while its component is unset
+			components[id] = UNSET;
+		}
+
+		std::uint32_t nextIndex{ 0 };
+		std::size_t numComponents{ 0 };
+		for (std::uint32_t root{ 0 }; root < numVerts; ++root)
+		{
+			if (indices[root] != UNSET)
+				continue;
+
+			indices[root] = lowLinks[root] = nextIndex++;
+			tarjanStack[tarjanSize++] = root;
+			frames.push(IdEdge{ root, offsets[root] });
+			while (!frames.empty())
+			{
+				IdEdge& frame{ frames.top() };
+				std::uint32_t current{ frame.id };
+				if (frame.edge < offsets[current + 1])
+				{
+					std::uint32_t target{ targets[frame.edge++] };
+					if (indices[target] == UNSET)
+					{
+						indices[target] = lowLinks[target] = nextIndex++;
+						tarjanStack[tarjanSize++] = target;
+						frames.push(IdEdge{ target, offsets[target] });
+					}
+					else if (components[target] == UNSET && indices[target] < lowLinks[current])
+						lowLinks[current] = indices[target];
+
+					continue;
+				}
+
+				// Every edge is done, so the vertex either roots a component or passes its low link up to its parent
+				frames.pop();
+				if (lowLinks[current] == indices[current])
+				{
+					std::uint32_t member{ 0 };
+					do
+					{
+						member = tarjanStack[--tarjanSize];
+						components[member] = static_cast<std::uint32_t>(numComponents);
+					} while (member != current);
+					++numComponents;
+				}
+				if (!frames.empty() && lowLinks[current] < lowLinks[frames.top().id])
+					lowLinks[frames.top().id] = lowLinks[current];
+			}
+		}
+
+		// Tarjan's algorithm finishes components in reverse topological order
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			components[id] = static_cast<std::uint32_t>(numComponents - 1 - components[id]);
+		}
+		delete[] tarjanStack;
+		delete[] lowLinks;
+		delete[] indices;
+		return numComponents;
+	}
+
+	// Returns true if the graph has a cycle, including a self-loop. In a snapshot of an undirected graph the two entries of an edge don't make a
+	// cycle, so a forest has none
+	template <typename T, typename U, typename W>
+	bool CsrGraph<T, U, W>::hasCycle() const
+	{
+		if (undirected)
+		{
+			// Union-find over each edge once, from its lower end. An edge whose ends are already joined closes a cycle
+			std::uint32_t* parents{ new std::uint32_t[numVerts] };
+			for (std::size_t id{ 0 }; id < numVerts; ++id)
+			{
+				parents[id] = static_cast<std::uint32_t>(id);
+			}
+			bool cycle{ false };
+			for (std::size_t id{ 0 }; id < numVerts && !cycle; ++id)
+			{
+				for (std::size_t edge{ offsets[id] }; edge < offsets[id + 1] && !cycle; ++edge)
+				{
+					if (targets[edge] < id)
+						continue;
+
+					std::uint32_t root1{ static_cast<std::uint32_t>(id) };
+					while (parents[root1] != root1)
+					{
+						parents[root1] = parents[parents[root1]];
+						root1 = parents[root1];
+					}
+					std::uint32_t root2{ targets[edge] };
+					while (parents[root2] != root2)
+					{
+						parents[root2] = parents[parents[root2]];
+						root2 = parents[root2];
+					}
+					cycle = root1 == root2;
+					parents[root2] = root1;
+				}
+			}
+			delete[] parents;
+			return cycle;
+		}
+
+		std::uint32_t* order{ new std::uint32_t[numVerts] };
+		std::size_t count{ topologicalSort(order) };
+		delete[] order;
+		return count != numVerts;
+	}
+
+	// Returns the graph of the given strongly connected components (as written by stronglyConnectedComponents), which has no cycles. Component
+	// c becomes the vertex with id and key c whose value is the number of vertices in it, and there's an edge from one component to another if
+	// any vertex in the first has an edge into the second, weighted with the smallest such edge weight. Throws std::logic_error if the snapshot
+	// is of an undirected graph
+	template <typename T, typename U, typename W>
+	CsrGraph<std::uint32_t, std::uint32_t, W> CsrGraph<T, U, W>::condensation(const std::uint32_t* components, std::size_t numComponents) const
+	{
+		if (undirected)
+			throw std::logic_error("The graph is undirected");
+
+		// Grouping the vertices by component with a counting sort
+		std::size_t* starts{ new std::size_t[numComponents + 1]{} };
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			++starts[components[id] + 1];
+		}
+		for (std::size_t component{ 0 }; component < numComponents; ++component)
+		{
+			starts[component + 1] += starts[component];
+		}
+		std::uint32_t* members{ new std::uint32_t[numVerts] };
+		std::size_t* cursors{ new std::size_t[numComponents] };
+		for (std::size_t component{ 0 }; component < numComponents; ++component)
+		{
+			cursors[component] = starts[component];
+		}
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			members[cursors[components[id]]++] = static_cast<std::uint32_t>(id);
+		}
+
+		CsrGraph<std::uint32_t, std::uint32_t, W> condensed;
+		condensed.numVerts = numComponents;
+		condensed.keys = new std::uint32_t[numComponents];
+		condensed.values = new std::uint32_t[numComponents];
+		condensed.offsets = new std::size_t[numComponents + 1];
+		condensed.idTable = HashTable<std::uint32_t, std::uint32_t>{ numComponents ? numComponents : 1 };
+		for (std::uint32_t component{ 0 }; component < numComponents; ++component)
+		{
+			condensed.keys[component] = component;
+			condensed.values[component] = static_cast<std::uint32_t>(starts[component + 1] - starts[component]);
+			condensed.idTable.insert(component, component);
+		}
+
+		// Two passes over each component's edges, one to count the distinct target components and one to fill them in. lastSource marks the
+		// targets already seen from the current component and slots remembers where their edge went
+		std::uint32_t* lastSource{ new std::uint32_t[numComponents] };
+		std::size_t* slots{ new std::size_t[numComponents] };
+		for (int pass{ 0 }; pass < 2; ++pass)
+		{
+			for (std::size_t component{ 0 }; component < numComponents; ++component)
+			{
+				lastSource[component] = ~std::uint32_t{ 0 };
+			}
+			std::size_t numCondensed{ 0 };
+			condensed.offsets[0] = 0;
+			for (std::uint32_t component{ 0 }; component < numComponents; ++component)
+			{
+				for (std::size_t member{ starts[component] }; member < starts[component + 1]; ++member)
+				{
+					std::uint32_t id{ members[member] };
+					for (std::size_t edge{ offsets[id] }; edge < offsets[id + 1]; ++edge)
+					{
+						std::uint32_t target{ components[targets[edge]] };
+						if (target == component)
+							continue;
+
+						if (lastSource[target] != component)
+						{
+							lastSource[target] = component;
+							slots[target] = numCondensed++;
+							if (pass == 1)
+							{
+								condensed.targets[slots[target]] = target;
+								if constexpr (WEIGHTED)
+									condensed.weights[slots[target]] = weights[edge];
+							}
+						}
+						else if constexpr (WEIGHTED)
+						{
+							if (pass == 1 && weights[edge] < condensed.weights[slots[target]])
+								condensed.weights[slots[target]] = weights[edge];
+						}
+					}
+				}
+				condensed.offsets[component + 1] = numCondensed;
+			}
+			if (pass == 0)
+			{
+				condensed.numEdges = numCondensed;
+				condensed.targets = new std::uint32_t[numCondensed];
+				if constexpr (WEIGHTED)
+					condensed.weights = new Weight[numCondensed];
+			}
+		}
+		delete[] slots;
+		delete[] lastSource;
+		delete[] cursors;
+		delete[] members;
+		delete[] starts;
+		return condensed;
+	}
+
+	// Returns a snapshot with every edge reversed and the same vertex ids, so that its adjacency lists hold the incoming edges of this graph
+	template <typename T, typename U, typename W>
+	CsrGraph<T, U, W> CsrGraph<T, U, W>::transpose() const
+	{
+		CsrGraph<T, U, W> transposed;
+		transposed.idTable = idTable;
+		transposed.undirected = undirected;
+		transposed.numVerts = numVerts;
+		transposed.numEdges = numEdges;
+		transposed.keys = new T[numVerts];
+		transposed.values = new U[numVerts];
+		transposed.offsets = new std::size_t[numVerts + 1]{};
+		transposed.targets = new std::uint32_t[numEdges];
+		if constexpr (WEIGHTED)
+			transposed.weights = new Weight[numEdges];
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			transposed.keys[id] = keys[id];
+			transposed.values[id] = values[id];
+		}
+
+		// Counting incoming edges into offsets[target + 1], then turning the counts into starting offsets
+		for (std::size_t edge{ 0 }; edge < numEdges; ++edge)
+		{
+			++transposed.offsets[targets[edge] + 1];
+		}
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			transposed.offsets[id + 1] += transposed.offsets[id];
+		}
+
+		// Filling each list through a cursor that starts at its offset
+		std::size_t* cursors{ new std::size_t[numVerts] };
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			cursors[id] = transposed.offsets[id];
+		}
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			for (std::size_t edge{ offsets[id] }; edge < offsets[id + 1]; ++edge)
+			{
+				std::size_t slot{ cursors[targets[edge]]++ };
+				transposed.targets[slot] = static_cast<std::uint32_t>(id);
+				if constexpr (WEIGHTED)
+					transposed.weights[slot] = weights[edge];
+			}
+		}
+		delete[] cursors;
+		return transposed;
+	}
+
+	// Returns a copy of the snapshot with the vertices renumbered, where order[i] (size() entries) is the id that becomes id i. Edges keep their
+	// order within each vertex. Throws std::invalid_argument if order isn't a permutation of the ids
+	template <typename T, typename U, typename W>
+	CsrGraph<T, U, W> CsrGraph<T, U, W>::relabel(const std::uint32_t* order) const
+	{
+		// Inverting the order, which also checks that every id appears exactly once
+		std::uint32_t* newIds{ new std::uint32_t[numVerts] };
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			newIds[id] = ~std::uint32_t{ 0 };
+		}
+		for (std::size_t i{ 0 }; i < numVerts; ++i)
+		{
+			if (order[i] >= numVerts || newIds[order[i]] != ~std::uint32_t{ 0 })
+			{
+				delete[] newIds;
+				throw std::invalid_argument("Order isn't a permutation of the vertex ids");
+			}
+			newIds[order[i]] = static_cast<std::uint32_t>(i);
+		}
+
+		CsrGraph<T, U, W> relabeled;
+		relabeled.undirected = undirected;
+		relabeled.numVerts = numVerts;
+		relabeled.numEdges = numEdges;
+		relabeled.keys = new T[numVerts];
+		relabeled.values = new U[numVerts];
+		relabeled.offsets = new std::size_t[numVerts + 1];
+		relabeled.targets = new std::uint32_t[numEdges];
+		if constexpr (WEIGHTED)
+			relabeled.weights = new Weight[numEdges];
+		relabeled.idTable = HashTable<T, std::uint32_t>{ numVerts ? numVerts : 1 };
+		relabeled.offsets[0] = 0;
+		for (std::size_t i{ 0 }; i < numVerts; ++i)
+		{
+			std::uint32_t id{ order[i] };
+			relabeled.keys[i] = keys[id];
+			relabeled.values[i] = values[id];
+			relabeled.idTable.insert(keys[id], static_cast<std::uint32_t>(i));
+			std::size_t slot{ relabeled.offsets[i] };
+			for (std::size_t edge{ offsets[id] }; edge < offsets[id + 1]; ++edge)
+			{
+				relabeled.targets[slot] = newIds[targets[edge]];
+				if constexpr (WEIGHTED)
+					relabeled.weights[slot] = weights[edge];
+				++slot;
+			}
+			relabeled.offsets[i + 1] = slot;
+		}
+		delete[] newIds;
+		return relabeled;
+	}
+
+	// Copies the arrays of the given graph. Any previous arrays must already be released
+	template <typename T, typename U, typename W>
+	void CsrGraph<T, U, W>::copyFrom(const CsrGraph<T, U, W>& graph)
+	{
+		undirected = graph.undirected;
+		numVerts = graph.numVerts;
+		numEdges = graph.numEdges;
+		keys = new T[numVerts];
+		values = new U[numVerts];
+		offsets = new std::size_t[numVerts + 1];
+		targets = new std::uint32_t[numEdges];
+		if constexpr (WEIGHTED)
+			weights = new Weight[numEdges];
+		for (std::size_t i{ 0 }; i < numVerts; ++i)
+		{
+			keys[i] = graph.keys[i];
+			values[i] = graph.values[i];
+		}
+		// A moved-from graph has no offset array
+		offsets[0] = 0;
+		for (std::size_t i{ 1 }; i <= numVerts; ++i)
+		{
+			offsets[i] = graph.offsets[i];
+		}
+		for (std::size_t i{ 0 }; i < numEdges; ++i)
+		{
+			targets[i] = graph.targets[i];
+			if constexpr (WEIGHTED)
+				weights[i] = graph.weights[i];
+		}
+	}
+
+	// Frees the arrays and leaves the graph empty
+	template <typename T, typename U, typename W>
+	void CsrGraph<T, U, W>::release()
+	{
+		delete[] keys;
+		delete[] values;
+		delete[] offsets;
+		delete[] targets;
+		delete[] weights;
+		keys = nullptr;
+		values = nullptr;
+		offsets = nullptr;
+		targets = nullptr;
+		weights = nullptr;
+		numVerts = 0;
+		numEdges = 0;
+		idTable.clear();
+	}
+
+	// Throws std::out_of_range if the given id doesn't belong to a vertex
+	template <typename T, typename U, typename W>
+	void CsrGraph<T, U, W>::checkId(std::uint32_t id) const
+	{
+		if (id >= numVerts)
+			throw std::out_of_range("Not a valid vertex id");
+	}
+}
+#endif
@@ -0,0 +1,65 @@
+#ifndef JML_DYNAMIC_PATHS_H
+#define JML_DYNAMIC_PATHS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Graph.h"
+#include "IndexedHeap.h"
+
+namespace JML
+{
+	// Shortest path distances from one source vertex of a Graph, kept up to date as edges change. Edges must be added and removed through this
+	// object while it's attached, which repairs only the distances the change affects (in the style of Ramalingam and Reps): a new or lighter
+	// edge only spreads shorter distances forward from its target, and a removed or heavier edge of the shortest path tree only recomputes the
+	// subtree hanging under it from the rest of the graph. Vertices may be added to the graph directly. The graph must be undirected or track
+	// incoming edges, and edge weights must not be negative
+	template <typename T, typename U = T, typename W = int>
+	class DynamicShortestPaths
+	{
+	public:
+		using Weight = typename EdgeWeight<W>::Stored;
+		using Distance = typename EdgeWeight<W>::Distance;
+
+		static constexpr Distance UNREACHABLE{ -1 };  // Distance reported for vertices that can't be reached from the source
+
+		DynamicShortestPaths(Graph<T, U, W>& graph, const T& source);
+		DynamicShortestPaths(Graph<T, U, W>& graph, VertexId source);
+		DynamicShortestPaths(const DynamicShortestPaths<T, U, W>& paths) = delete;
+		DynamicShortestPaths(DynamicShortestPaths<T, U, W>&& paths) = delete;
+		~DynamicShortestPaths();
+		DynamicShortestPaths<T, U, W>& operator=(const DynamicShortestPaths<T, U, W>& paths) = delete;
+		DynamicShortestPaths<T, U, W>& operator=(DynamicShortestPaths<T, U, W>&& paths) = delete;
+		VertexId source() const;
+		Distance distance(const T& key) const;
+		Distance distance(VertexId id) const;
+		VertexId predecessor(VertexId id) const;
+		std::size_t lastRepairSize() const;
+		void addEdge(const T& key1, const T& key2, Weight weight=Weight{});
+		void addEdge(VertexId id1, VertexId id2, Weight weight=Weight{});
+		void removeEdge(const T& key1, const T& key2);
+		void removeEdge(VertexId id1, VertexId id2);
+		void removeVertex(const T& key);
+		void removeVertex(VertexId id);
+
+	private:
+		static constexpr std::uint32_t NO_PARENT{ ~std::uint32_t{ 0 } };
+
+		Graph<T, U, W>& graph;
+		VertexId sourceId{};
+		std::size_t capacity{ 0 };
+		Distance* distances{ nullptr };  // Indexed by VertexId::index
+		std::uint32_t* parents{ nullptr };  // Shortest path tree, with NO_PARENT for the source and unreachable vertices
+		bool* cut{ nullptr };  // Marks the subtree being recomputed by repairIncrease. All false between updates
+		std::uint32_t* subtree{ nullptr };  // The vertices marked in cut
+		IndexedHeap<Distance, shorterDistance<Distance>> queue{};
+		std::size_t repaired{ 0 };
+
+		void initialize();
+		void grow();
+		void propagate();
+		void repairIncrease(std::uint32_t* roots, std::size_t numRoots);
+	};
+}
+#include "DynamicPaths.hpp"
+#endif
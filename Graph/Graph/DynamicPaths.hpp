@@ -0,0 +1,338 @@
+#ifndef JML_DYNAMIC_PATHS_HPP
+#define JML_DYNAMIC_PATHS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "Graph.h"
+#include "IndexedHeap.h"
+
+namespace JML
+{
+	// Computes the distances from the vertex with the given key. Throws std::invalid_argument if no vertex with the key exists or an edge weight
+	// is negative, and std::logic_error if the graph doesn't track incoming edges
+	template <typename T, typename U, typename W>
+	DynamicShortestPaths<T, U, W>::DynamicShortestPaths(Graph<T, U, W>& graph, const T& source) :
+		graph{ graph }, sourceId{ graph.id(source) }
+	{
+		initialize();
+	}
+
+	// Computes the distances from the vertex with the given id. Throws std::out_of_range if the id doesn't belong to a vertex in the graph,
+	// std::invalid_argument if an edge weight is negative and std::logic_error if the graph doesn't track incoming edges
+	template <typename T, typename U, typename W>
+	DynamicShortestPaths<T, U, W>::DynamicShortestPaths(Graph<T, U, W>& graph, VertexId source) :
+		graph{ graph }, sourceId{ source }
+	{
+		if (!graph.contains(source))
+			throw std::out_of_range("Not a valid vertex id");
+
+		initialize();
+	}
+
+	template <typename T, typename U, typename W>
+	DynamicShortestPaths<T, U, W>::~DynamicShortestPaths()
+	{
+		delete[] distances;
+		delete[] parents;
+		delete[] cut;
+		delete[] subtree;
+	}
+
+	// Returns the id of the source vertex
+	template <typename T, typename U, typename W>
+	VertexId DynamicShortestPaths<T, U, W>::source() const
+	{
+		return sourceId;
+	}
+
+	// Returns the shortest path distance from the source to the vertex with the given key, or UNREACHABLE. Throws std::invalid_argument if no
+	// vertex with the given key exists
+	template <typename T, typename U, typename W>
+	typename DynamicShortestPaths<T, U, W>::Distance DynamicShortestPaths<T, U, W>::distance(const T& key) const
+	{
+		return distance(graph.id(key));
+	}
+
+	// Returns the shortest path distance from the source to the vertex with the given id, or UNREACHABLE. Throws std::out_of_range if the id
+	// doesn't belong to a vertex in the graph
+	template <typename T, typename U, typename W>
+	typename DynamicShortestPaths<T, U, W>::Distance DynamicShortestPaths<T, U, W>::distance(VertexId id) const
+	{
+		if (!graph.contains(id))
+			throw std::out_of_range("Not a valid vertex id");
+
+		// Vertices added to the graph since the last update have no edges from here yet
+		return id.index < capacity ? distances[id.index] : UNREACHABLE;
+	}
+
+	// Returns the vertex before the one with the given id on a shortest path from the source. Throws std::out_of_range if the id doesn't belong
+	// to a vertex in the graph and std::invalid_argument if the vertex is the source or can't be reached
+	template <typename T, typename U, typename W>
+	VertexId DynamicShortestPaths<T, U, W>::predecessor(VertexId id) const
+	{
+		if (distance(id) == UNREACHABLE || id == sourceId)
+			throw std::invalid_argument("The vertex has no predecessor");
+
+		return VertexId{ parents[id.index] };
+	}
+
+	// Returns the number of vertices whose distance the last update recomputed, which is what its cost grows with
+	template <typename T, typename U, typename W>
+	std::size_t DynamicShortestPaths<T, U, W>::lastRepairSize() const
+	{
+		return repaired;
+	}
+
+	// Adds an edge to the graph as Graph::addEdge does, or changes the weight of an existing one, and repairs the distances. Throws
+	// std::invalid_argument if no vertex exists for one or both of the keys or the weight is negative
+	template <typename T, typename U, typename W>
+	void DynamicShortestPaths<T, U, W>::addEdge(const T& key1, const T& key2, Weight weight)
+	{
+		VertexId id1{ graph.id(key1) };
+		VertexId id2{ graph.id(key2) };
+		addEdge(id1, id2, weight);
+	}
+
+	// Adds an edge between the vertices with the given ids, or changes the weight of an existing one, and repairs the distances. Throws
+	// std::out_of_range if either id doesn't belong to a vertex in the graph and std::invalid_argument if the weight is negative
+	template <typename T, typename U, typename W>
+	void DynamicShortestPaths<T, U, W>::addEdge(VertexId id1, VertexId id2, Weight weight)
+	{
+		bool existed{ graph.adjacent(id1, id2) };
+		Distance length{ EdgeWeight<W>::length(weight) };
+		if (length < 0)
+			throw std::invalid_argument("Edge weights must not be negative");
+
+		Distance oldLength{ existed ? EdgeWeight<W>::length(graph.getWeight(id1, id2)) : 0 };
+		graph.addEdge(id1, id2, weight);
+		grow();
+		repaired = 0;
+		if (existed && length > oldLength)
+		{
+			// A heavier edge only matters if a shortest path ran along it, which in an undirected graph may be from either end
+			if (parents[id2.index] == id1.index)
+				repairIncrease(&id2.index, 1);
+			else if (!graph.directed() && parents[id1.index] == id2.index)
+				repairIncrease(&id1.index, 1);
+			return;
+		}
+
+		VertexId ends[]{ id1, id2 };
+		for (std::size_t from{ 0 }; from < (graph.directed() ? 1 : 2); ++from)
+		{
+			VertexId source{ ends[from] };
+			VertexId target{ ends[1 - from] };
+			if (distances[source.index] == UNREACHABLE)
+				continue;
+
+			Distance candidate{ distances[source.index] + length };
+			if (distances[target.index] == UNREACHABLE || candidate < distances[target.index])
+			{
+				distances[target.index] = candidate;
+				parents[target.index] = source.index;
+				queue.insert(target.index, candidate);
+			}
+		}
+		propagate();
+	}
+
+	// Removes the edge from the vertex with key1 to the vertex with key2 (if it exists) and repairs the distances. Throws std::invalid_argument
+	// if no vertex exists for one or both of the keys
+	template <typename T, typename U, typename W>
+	void DynamicShortestPaths<T, U, W>::removeEdge(const T& key1, const T& key2)
+	{
+		VertexId id1{ graph.id(key1) };
+		VertexId id2{ graph.id(key2) };
+		removeEdge(id1, id2);
+	}
+
+	// Removes the edge from the vertex with id1 to the vertex with id2 (if it exists) and repairs the distances. Throws std::out_of_range if
+	// either id doesn't belong to a vertex in the graph
+	template <typename T, typename U, typename W>
+	void DynamicShortestPaths<T, U, W>::removeEdge(VertexId id1, VertexId id2)
+	{
+		bool existed{ graph.adjacent(id1, id2) };
+		graph.removeEdge(id1, id2);
+		grow();
+		repaired = 0;
+		if (existed && parents[id2.index] == id1.index)
+			repairIncrease(&id2.index, 1);
+		else if (existed && !graph.directed() && parents[id1.index] == id2.index)
+			repairIncrease(&id1.index, 1);
+	}
+
+	// Removes the vertex with the given key from the graph and repairs the distances. Throws std::invalid_argument if no vertex with the key
+	// exists or it's the source
+	template <typename T, typename U, typename W>
+	void DynamicShortestPaths<T, U, W>::removeVertex(const T& key)
+	{
+		removeVertex(graph.id(key));
+	}
+
+	// Removes the vertex with the given id from the graph and repairs the distances. Throws std::out_of_range if the id doesn't belong to a
+	// vertex in the graph and std::invalid_argument if it's the source
+	template <typename T, typename U, typename W>
+	void DynamicShortestPaths<T, U, W>::removeVertex(VertexId id)
+	{
+		if (!graph.contains(id))
+			throw std::out_of_range("Not a valid vertex id");
+		if (id == sourceId)
+			throw std::invalid_argument("The source vertex can't be removed");
+
+		grow();
+		// The vertex's children in the shortest path tree lose their paths along with it
+		std::uint32_t* roots{ new std::uint32_t[graph.getAdjacent(id).size()] };
+		std::size_t numRoots{ 0 };
+		for (const auto& [target, weight] : graph.edgesOf(id))
+		{
+			if (target != id && parents[target.index] == id.index)
+				roots[numRoots++] = target.index;
+		}
+		graph.removeVertex(id);
+		distances[id.index] = UNREACHABLE;
+		parents[id.index] = NO_PARENT;
+		repaired = 0;
+		repairIncrease(roots, numRoots);
+		delete[] roots;
+	}
+
+	// Runs Dijkstra's algorithm over the whole graph. Throws if the graph doesn't track incoming edges or has a negative edge weight
+	template <typename T, typename U, typename W>
+	void DynamicShortestPaths<T, U, W>::initialize()
+	{
+		if (!graph.tracksIncoming())
+			throw std::logic_error("The graph doesn't track incoming edges");
+
+		for (std::uint32_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			if (!graph.contains(VertexId{ index }))
+				continue;
+
+			for (const auto& [target, weight] : graph.edgesOf(VertexId{ index }))
+			{
+				if (EdgeWeight<W>::length(weight) < 0)
+					throw std::invalid_argument("Edge weights must not be negative");
+			}
+		}
+
+		grow();
+		distances[sourceId.index] = 0;
+		queue.insert(sourceId.index, Distance{ 0 });
+		propagate();
+	}
+
+	// Makes room for every id the graph has handed out, so that vertices added to it directly get entries
+	template <typename T, typename U, typename W>
+	void DynamicShortestPaths<T, U, W>::grow()
+	{
+		std::size_t newCapacity{ graph.idBound() };
+		if (newCapacity <= capacity)
+			return;
+
+		Distance* newDistances{ new Distance[newCapacity] };
+		std::uint32_t* newParents{ new std::uint32_t[newCapacity] };
+		bool* newCut{ new bool[newCapacity]{} };
+		for (std::size_t i{ 0 }; i < newCapacity; ++i)
+		{
+			newDistances[i] = i < capacity ? distances[i] : UNREACHABLE;
+			newParents[i] = i < capacity ? parents[i] : NO_PARENT;
+		}
+		delete[] distances;
+		delete[] parents;
+		delete[] cut;
+		delete[] subtree;
+		distances = newDistances;
+		parents = newParents;
+		cut = newCut;
+		subtree = new std::uint32_t[newCapacity];
+		// The queue is empty between updates, so it can simply be replaced
+		queue = IndexedHeap<Distance, shorterDistance<Distance>>{ newCapacity };
+		capacity = newCapacity;
+	}
+
+	// Settles the queued vertices in order of distance, relaxing their outgoing edges. Only vertices whose distance gets shorter are queued,
+	// so the work stays within the region the update changed
+	template <typename T, typename U, typename W>
+	void DynamicShortestPaths<T, U, W>::propagate()
+	{
+		while (!queue.empty())
+		{
+			std::uint32_t id{ static_cast<std::uint32_t>(queue.topIndex()) };
+			queue.pop();
+			// Vertices of a cut subtree were already counted
+			if (!cut[id])
+				++repaired;
+
+			for (const auto& [target, weight] : graph.edgesOf(VertexId{ id }))
+			{
+				Distance candidate{ distances[id] + EdgeWeight<W>::length(weight) };
+				if (distances[target.index] == UNREACHABLE || candidate < distances[target.index])
+				{
+					distances[target.index] = candidate;
+					parents[target.index] = id;
+					queue.insert(target.index, candidate);
+				}
+			}
+		}
+	}
+
+	// Recomputes the distances of the shortest path subtrees under the given roots, whose paths from their parents got longer or disappeared.
+	// Every vertex in the subtrees first takes its best distance through an incoming edge from outside them, and then Dijkstra's algorithm
+	// settles the subtrees from there. Nothing outside the subtrees can get shorter
+	template <typename T, typename U, typename W>
+	void DynamicShortestPaths<T, U, W>::repairIncrease(std::uint32_t* roots, std::size_t numRoots)
+	{
+		// Collecting the subtrees breadth-first, with the list doubling as the queue
+		std::size_t size{ 0 };
+		for (std::size_t i{ 0 }; i < numRoots; ++i)
+		{
+			cut[roots[i]] = true;
+			subtree[size++] = roots[i];
+		}
+		for (std::size_t head{ 0 }; head < size; ++head)
+		{
+			std::uint32_t id{ subtree[head] };
+			for (const auto& [target, weight] : graph.edgesOf(VertexId{ id }))
+			{
+				if (!cut[target.index] && parents[target.index] == id)
+				{
+					cut[target.index] = true;
+					subtree[size++] = target.index;
+				}
+			}
+		}
+		for (std::size_t i{ 0 }; i < size; ++i)
+		{
+			distances[subtree[i]] = UNREACHABLE;
+			parents[subtree[i]] = NO_PARENT;
+		}
+
+		for (std::size_t i{ 0 }; i < size; ++i)
+		{
+			std::uint32_t id{ subtree[i] };
+			for (const auto& [source, weight] : graph.getIncoming(VertexId{ id }).pairs())
+			{
+				if (cut[source.index] || distances[source.index] == UNREACHABLE)
+					continue;
+
+				Distance candidate{ distances[source.index] + EdgeWeight<W>::length(weight) };
+				if (distances[id] == UNREACHABLE || candidate < distances[id])
+				{
+					distances[id] = candidate;
+					parents[id] = source.index;
+				}
+			}
+			if (distances[id] != UNREACHABLE)
+				queue.insert(id, distances[id]);
+		}
+		repaired += size;
+		propagate();
+		for (std::size_t i{ 0 }; i < size; ++i)
+		{
+			cut[subtree[i]] = false;
+		}
+	}
+}
+#endif
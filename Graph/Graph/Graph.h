@@ -1,56 +1,312 @@
 #ifndef JML_GRAPH_H
 #define JML_GRAPH_H
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
 
 #include "HashTable.h"
+#include "Stack.h"
 
 namespace JML
 {
-	template <typename T, typename U = T>
+	template <typename T, typename U, typename W>
+	class CsrGraph;
+
+	template <typename T, typename U, typename W>
+	class GraphSnapshot;
+
+	// Handle to a vertex of a Graph. Stays valid until the vertex is removed, after which the graph may hand the same id to a new vertex
+	struct VertexId
+	{
+		std::uint32_t index{};
+	};
+
+	inline bool operator==(const VertexId& id1, const VertexId& id2)
+	{
+		return id1.index == id2.index;
+	}
+
+	inline bool operator!=(const VertexId& id1, const VertexId& id2)
+	{
+		return id1.index != id2.index;
+	}
+}
+
+template <>
+struct std::hash<JML::VertexId>
+{
+	std::size_t operator()(const JML::VertexId& id) const noexcept
+	{
+		return std::hash<std::uint32_t>{}(id.index);
+	}
+};
+
+namespace JML
+{
+	// Stored weight of an unweighted edge. It's empty, so a graph with void weights keeps nothing but the target of every edge
+	struct NoWeight
+	{};
+
+	inline bool operator==(const NoWeight&, const NoWeight&)
+	{
+		return true;
+	}
+
+	inline bool operator!=(const NoWeight&, const NoWeight&)
+	{
+		return false;
+	}
+
+	inline bool operator<(const NoWeight&, const NoWeight&)
+	{
+		return false;
+	}
+
+	// Maps an edge weight type to the type stored for every edge and the type of path lengths. Integer weights add up in long long and
+	// floating-point weights in double. Unweighted edges count one each, so shortest paths are the fewest edges
+	template <typename W>
+	struct EdgeWeight
+	{
+		using Stored = W;
+		using Distance = std::conditional_t<std::is_floating_point_v<W>, double, long long>;
+
+		static Distance length(const W& weight)
+		{
+			return weight;
+		}
+	};
+
+	template <>
+	struct EdgeWeight<void>
+	{
+		using Stored = NoWeight;
+		using Distance = long long;
+
+		static Distance length(const NoWeight&)
+		{
+			return 1;
+		}
+	};
+
+	// Heap comparator for path lengths that keeps the shortest on top
+	template <typename D>
+	bool shorterDistance(const D& distance1, const D& distance2)
+	{
+		return distance1 < distance2;
+	}
+
+	// Edge entry for batch insertion with Graph::addEdges, by key or by VertexId. The weight of an unweighted edge takes no space
+	template <typename T, typename W = int>
+	struct GraphEdge
+	{
+		T from{};
+		T to{};
+		JML_NO_UNIQUE_ADDRESS typename EdgeWeight<W>::Stored weight{};
+	};
+
+	// Construction options of a Graph, combined with |. TrackIncoming makes every vertex also index its incoming edges, and Undirected makes
+	// every edge join its ends both ways
+	enum class GraphOptions : unsigned
+	{
+		None = 0,
+		TrackIncoming = 1,
+		Undirected = 2
+	};
+
+	inline GraphOptions operator|(GraphOptions options1, GraphOptions options2)
+	{
+		return static_cast<GraphOptions>(static_cast<unsigned>(options1) | static_cast<unsigned>(options2));
+	}
+
+	inline GraphOptions operator&(GraphOptions options1, GraphOptions options2)
+	{
+		return static_cast<GraphOptions>(static_cast<unsigned>(options1) & static_cast<unsigned>(options2));
+	}
+
+	// Weighted graph, directed by default or undirected if constructed so. Every vertex is interned under a dense VertexId when it's added and
+	// edges are stored by id, so the id overloads reach vertices and edges without hashing keys. The key overloads look the key up once and
+	// then take the same path. W is the edge weight type, or void for an unweighted graph whose edges store no weight and whose addEdge calls
+	// take none. An undirected graph stores every edge at both ends, so the edges of a vertex are all its neighbors. The graph is persistent:
+	// share() and snapshot() keep the current version in constant time, and later changes copy only what they touch
+	template <typename T, typename U = T, typename W = int>
 	class Graph
 	{
 	private:
 		class Vertex;
+		class Chunk;
+		class KeyShard;
+		class State;
+		friend class CsrGraph<T, U, W>;
 
 	public:
-		Graph();
-		Graph(const Graph<T, U>& graph);  // Copy constructor
-		Graph(Graph<T, U>&& graph) noexcept;  // Move constructor
+		using Weight = typename EdgeWeight<W>::Stored;
+		using EdgeTable = HashTable<VertexId, Weight>;
+		using EdgeRange = typename EdgeTable::template PairRange<const KeyValue<VertexId, Weight>>;
+
+		explicit Graph(GraphOptions options = GraphOptions::None);
+		Graph(const Graph<T, U, W>& graph);  // Copy constructor
+		Graph(Graph<T, U, W>&& graph) noexcept;  // Move constructor
 		~Graph();
-		Graph<T, U>& operator=(const Graph<T, U>& graph);  // Copy assignment
-		Graph<T, U>& operator=(Graph<T, U>&& graph) noexcept;  // Move assignment
-		template <typename T1, typename U1> friend bool operator==(const Graph<T1, U1>& graph1, const Graph<T1, U1>& graph2);
-		template <typename T1, typename U1> friend bool operator!=(const Graph<T1, U1>& graph1, const Graph<T1, U1>& graph2);
+		Graph<T, U, W>& operator=(const Graph<T, U, W>& graph);  // Copy assignment
+		Graph<T, U, W>& operator=(Graph<T, U, W>&& graph) noexcept;  // Move assignment
+		template <typename T1, typename U1, typename W1> friend bool operator==(const Graph<T1, U1, W1>& graph1, const Graph<T1, U1, W1>& graph2);
+		template <typename T1, typename U1, typename W1> friend bool operator!=(const Graph<T1, U1, W1>& graph1, const Graph<T1, U1, W1>& graph2);
 		U& operator[](const T& key);
 		const U& operator[](const T& key) const;
 		bool empty() const;
 		std::size_t size() const;
+		std::size_t idBound() const;
 		bool contains(const T& key) const;
-		template <typename V, typename W> void addVertex(V&& key, W&& value);
+		bool contains(VertexId id) const;
+		VertexId id(const T& key) const;
+		const T& key(VertexId id) const;
+		template <typename V, typename X> VertexId addVertex(V&& key, X&& value);
+		void addVertices(const T* keys, const U* values, std::size_t count);
+		void reserve(std::size_t numVertices);
 		U& getVertex(const T& key);
 		const U& getVertex(const T& key) const;
+		U& getVertex(VertexId id);
+		const U& getVertex(VertexId id) const;
 		void removeVertex(const T& key);
+		void removeVertex(VertexId id);
 		bool adjacent(const T& key1, const T& key2) const;
-		const HashTable<T, int>& getAdjacent(const T& key) const;
-		int getWeight(const T& key1, const T& key2) const;
-		void addEdge(const T& key1, const T& key2, int weight=0);
+		bool adjacent(VertexId id1, VertexId id2) const;
+		const EdgeTable& getAdjacent(const T& key) const;
+		const EdgeTable& getAdjacent(VertexId id) const;
+		EdgeRange edgesOf(const T& key) const;
+		EdgeRange edgesOf(VertexId id) const;
+		const EdgeTable& getIncoming(const T& key) const;
+		const EdgeTable& getIncoming(VertexId id) const;
+		bool tracksIncoming() const;
+		bool directed() const;
+		Weight getWeight(const T& key1, const T& key2) const;
+		Weight getWeight(VertexId id1, VertexId id2) const;
+		void addEdge(const T& key1, const T& key2, Weight weight=Weight{});
+		void addEdge(VertexId id1, VertexId id2, Weight weight=Weight{});
+		void addEdges(const GraphEdge<T, W>* edges, std::size_t count);
+		void addEdges(const GraphEdge<VertexId, W>* edges, std::size_t count);
 		void removeEdge(const T& key1, const T& key2);
+		void removeEdge(VertexId id1, VertexId id2);
 		void clear();
+		Graph<T, U, W> share() const;
+		GraphSnapshot<T, U, W> snapshot() const;
+		CsrGraph<T, U, W> freeze() const;
 
 	private:
-		std::size_t numVerts{ 0 };
-		HashTable<T, Vertex*> vertTable{};
+		static constexpr std::size_t CHUNK_BITS{ 7 };
+		static constexpr std::size_t CHUNK_SIZE{ std::size_t{ 1 } << CHUNK_BITS };  // Ids per chunk
+		static constexpr std::size_t KEY_SHARD_BITS{ 8 };
+		static constexpr std::size_t KEY_SHARDS{ std::size_t{ 1 } << KEY_SHARD_BITS };
+
+		bool trackIncoming{ false };  // Whether each vertex also indexes its incoming edges. Never set for undirected graphs
+		bool undirected{ false };  // Whether every edge is indexed at both ends, as an edge out of each
+		State* state{ emptyState() };
+
+		static State* emptyState();
+		static State* copyState(const State& state);
+		static std::size_t shardOf(const T& key);
+		template <typename R> static void hold(R* record);
+		template <typename R> static void drop(R* record);
+		VertexId findId(const T& key, const char* message) const;
+		Vertex* findVertex(VertexId id) const;
+		Vertex* vertexAt(std::size_t index) const;
+		const HashTable<T, VertexId>* keysOf(const T& key) const;
+		void detach();
+		void release();
+		void addChunk();
+		Vertex*& writableSlot(std::size_t index);
+		Vertex* writableVertex(std::size_t index);
+		HashTable<T, VertexId>& writableKeys(std::size_t shard);
 
+		// Every record below counts the records one level up that hold it: graphs hold states, states hold chunks and key shards and chunks
+		// hold vertices. A record held once on the graph's own path may change in place and any other is copied first, so a change copies
+		// only the records on its way down and everything else stays shared with the graphs made by share()
 		class Vertex
 		{
 		public:
+			std::atomic<std::size_t> owners{ 1 };
+			T key{};
 			U value{};
-			HashTable<T, int> edges{ 1 };
+			EdgeTable edges{ 1 };
+			EdgeTable* incoming{ nullptr };  // Only created if the graph tracks incoming edges
 
-			Vertex(const U& value);
-			Vertex(U&& value);
+			template <typename V, typename X> Vertex(V&& key, X&& value, bool trackIncoming);
+			Vertex(const Vertex& vertex);  // Copies the key, value and edges. The copy starts with one owner
+			~Vertex();
+			Vertex& operator=(const Vertex& vertex) = delete;
 		};
+
+		// CHUNK_SIZE consecutive ids, with nullptr for ids not in use
+		class Chunk
+		{
+		public:
+			std::atomic<std::size_t> owners{ 1 };
+			Vertex* vertices[CHUNK_SIZE]{};
+
+			Chunk() = default;
+			Chunk(const Chunk& chunk);  // Shares every vertex of the chunk. The copy starts with one owner
+			~Chunk();
+			Chunk& operator=(const Chunk& chunk) = delete;
+		};
+
+		// Ids of the keys whose hashes pick this shard
+		class KeyShard
+		{
+		public:
+			std::atomic<std::size_t> owners{ 1 };
+			HashTable<T, VertexId> ids{};
+
+			KeyShard() = default;
+			KeyShard(const KeyShard& shard);  // The copy starts with one owner
+			KeyShard& operator=(const KeyShard& shard) = delete;
+		};
+
+		class State
+		{
+		public:
+			std::atomic<std::size_t> owners{ 1 };
+			// Set once the state has been copied or copied from. Until then every record under it is held once, on this state's path, so
+			// changes don't check owners
+			mutable std::atomic<bool> copied{ false };
+			std::size_t numVerts{ 0 };
+			std::size_t numIds{ 0 };  // One past the largest id handed out so far
+			Chunk** chunks{ nullptr };  // Chunk i holds ids i * CHUNK_SIZE to (i + 1) * CHUNK_SIZE - 1
+			std::size_t numChunks{ 0 };
+			std::size_t chunkCapacity{ 0 };
+			KeyShard* keyShards[KEY_SHARDS]{};  // Created when a key first picks them
+			Stack<VertexId> freeIds{};  // Ids of removed vertices, reused before new ones
+
+			State() = default;
+			State(const State& state);  // Shares every chunk and key shard of the state. The copy starts with one owner
+			~State();
+			State& operator=(const State& state) = delete;
+		};
+	};
+
+	// Read-only handle to one version of a Graph, made in constant time by Graph::snapshot(). Later changes to the graph don't show through
+	// it, and copies of the handle share the same version. Any number of threads may read through the same handle at once while the graph
+	// it came from keeps changing
+	template <typename T, typename U = T, typename W = int>
+	class GraphSnapshot
+	{
+	public:
+		GraphSnapshot() = default;
+		GraphSnapshot(const GraphSnapshot<T, U, W>& snapshot);  // Copy constructor
+		GraphSnapshot(GraphSnapshot<T, U, W>&& snapshot) noexcept = default;  // Move constructor
+		GraphSnapshot<T, U, W>& operator=(const GraphSnapshot<T, U, W>& snapshot);  // Copy assignment
+		GraphSnapshot<T, U, W>& operator=(GraphSnapshot<T, U, W>&& snapshot) noexcept = default;  // Move assignment
+		const Graph<T, U, W>& operator*() const;
+		const Graph<T, U, W>* operator->() const;
+
+	private:
+		friend class Graph<T, U, W>;
+
+		Graph<T, U, W> graph{};
+
+		explicit GraphSnapshot(Graph<T, U, W>&& graph);
 	};
 }
 #include "Graph.hpp"
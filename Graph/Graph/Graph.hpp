@@ -1,281 +1,908 @@
 #ifndef JML_GRAPH_HPP
 #define JML_GRAPH_HPP
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
 #include <stdexcept>
 
+#include "CsrGraph.h"
 #include "HashTable.h"
+#include "Stack.h"
 
 namespace JML
 {
-	template <typename T, typename U>
-	Graph<T, U>::Graph()
+	// Creates an empty graph. With GraphOptions::TrackIncoming, every vertex also keeps an index of its incoming edges, which makes removeVertex
+	// proportional to the vertex's degree and enables getIncoming at the cost of storing every edge twice. With GraphOptions::Undirected, every edge
+	// joins its ends both ways and is indexed once at each, taking the place of the pair of edges and the incoming index a directed graph
+	// needs for the same: removeVertex is proportional to the vertex's degree, and getIncoming returns the same table as getAdjacent
+	template <typename T, typename U, typename W>
+	Graph<T, U, W>::Graph(GraphOptions options) :
+		trackIncoming{ (options & GraphOptions::Undirected) == GraphOptions::None && (options & GraphOptions::TrackIncoming) != GraphOptions::None },
+		undirected{ (options & GraphOptions::Undirected) != GraphOptions::None }
 	{}
 
 	// Copy constructor
-	template <typename T, typename U>
-	Graph<T, U>::Graph(const Graph<T, U>& graph) :
-		numVerts{graph.numVerts}
-	{
-		for (const T& key : graph.vertTable)
-		{
-			Vertex* oldVert{ graph.vertTable[key] };
-			Vertex* newVert{ new Vertex(oldVert->value) };
-			newVert->edges = oldVert->edges;
-			vertTable[key] = newVert;
-		}
-	}
+	template <typename T, typename U, typename W>
+	Graph<T, U, W>::Graph(const Graph<T, U, W>& graph) :
+		trackIncoming{graph.trackIncoming}, undirected{graph.undirected}, state{copyState(*graph.state)}
+	{}
 
 	// Move constructor
-	template <typename T, typename U>
-	Graph<T, U>::Graph(Graph<T, U>&& graph) noexcept :
-		numVerts{graph.numVerts}
+	template <typename T, typename U, typename W>
+	Graph<T, U, W>::Graph(Graph<T, U, W>&& graph) noexcept :
+		trackIncoming{graph.trackIncoming}, undirected{graph.undirected}, state{graph.state}
 	{
-		vertTable = graph.vertTable;
-		graph.vertTable.clear();
-		graph.numVerts = 0;
+		graph.state = emptyState();
 	}
 
-	template <typename T, typename U>
-	Graph<T, U>::~Graph()
+	template <typename T, typename U, typename W>
+	Graph<T, U, W>::~Graph()
 	{
-		clear();
+		release();
 	}
 
 	// Copy assignment
-	template <typename T, typename U>
-	Graph<T, U>& Graph<T, U>::operator=(const Graph<T, U>& graph)
+	template <typename T, typename U, typename W>
+	Graph<T, U, W>& Graph<T, U, W>::operator=(const Graph<T, U, W>& graph)
 	{
 		if (&graph == this)
 			return *this;
 
-		clear();
-		numVerts = graph.numVerts;
-		for (const T& key : graph.vertTable)
-		{
-			Vertex* oldVert{ graph.vertTable[key] };
-			Vertex* newVert{ new Vertex(oldVert->value) };
-			newVert->edges = oldVert->edges;
-			vertTable[key] = newVert;
-		}
+		State* copy{ copyState(*graph.state) };
+		release();
+		trackIncoming = graph.trackIncoming;
+		undirected = graph.undirected;
+		state = copy;
 		return *this;
 	}
 
 	// Move assignment
-	template <typename T, typename U>
-	Graph<T, U>& Graph<T, U>::operator=(Graph<T, U>&& graph) noexcept
+	template <typename T, typename U, typename W>
+	Graph<T, U, W>& Graph<T, U, W>::operator=(Graph<T, U, W>&& graph) noexcept
 	{
-		clear();
-		vertTable = graph.vertTable;
-		graph.vertTable.clear();
-		graph.numVerts = 0;
-		return *this;
+		if (&graph == this)
+			return *this;
 
+		release();
+		trackIncoming = graph.trackIncoming;
+		undirected = graph.undirected;
+		state = graph.state;
+		graph.state = emptyState();
+		return *this;
 	}
 
-	template <typename T1, typename U1>
-	bool operator==(const Graph<T1, U1>& graph1, const Graph<T1, U1>& graph2)
+	// Graphs are equal if they're both directed or both undirected and have the same keys, values and weighted edges. Ids don't take part, so
+	// graphs built in different orders compare equal
+	template <typename T1, typename U1, typename W1>
+	bool operator==(const Graph<T1, U1, W1>& graph1, const Graph<T1, U1, W1>& graph2)
 	{
-		if (graph1.numVerts == graph2.numVerts)
+		if (graph1.undirected != graph2.undirected || graph1.state->numVerts != graph2.state->numVerts)
+			return false;
+
+		for (std::size_t index{ 0 }; index < graph1.state->numIds; ++index)
 		{
-			typename Graph<T1, U1>::Vertex* vertex1{ nullptr };
-			typename Graph<T1, U1>::Vertex* vertex2{ nullptr };
-			for (const T1& key : graph1.vertTable)
+			const typename Graph<T1, U1, W1>::Vertex* vertex1{ graph1.vertexAt(index) };
+			if (!vertex1)
+				continue;
+
+			if (!graph2.contains(vertex1->key))
+				return false;
+
+			const typename Graph<T1, U1, W1>::Vertex* vertex2{ graph2.vertexAt(graph2.id(vertex1->key).index) };
+			// A vertex shared by two versions of a graph hasn't changed in either, and neither has the key of any of its targets, since
+			// removing one would have changed the vertex
+			if (vertex1 == vertex2)
+				continue;
+
+			if ((vertex1->value != vertex2->value) || (vertex1->edges.size() != vertex2->edges.size()))
+				return false;
+
+			for (const auto& [target, weight] : vertex1->edges.pairs())
 			{
-				try
-				{
-					vertex1 = graph1.vertTable[key];
-					vertex2 = graph2.vertTable[key];
-					if ((vertex1->value != vertex2->value) || (vertex1->edges != vertex2->edges))
-						return false;
-				}
-				catch (std::invalid_argument&)
-				{
+				VertexId target2{ graph2.id(graph1.vertexAt(target.index)->key) };
+				if (!vertex2->edges.contains(target2) || vertex2->edges[target2] != weight)
 					return false;
-				}
 			}
-			return true;
 		}
-		return false;
+		return true;
 	}
 
-	template <typename T1, typename U1>
-	bool operator!=(const Graph<T1, U1>& graph1, const Graph<T1, U1>& graph2)
+	template <typename T1, typename U1, typename W1>
+	bool operator!=(const Graph<T1, U1, W1>& graph1, const Graph<T1, U1, W1>& graph2)
 	{
 		return !operator==(graph1, graph2);
 	}
 
-	template <typename T, typename U>
-	U& Graph<T, U>::operator[](const T& key)
+	template <typename T, typename U, typename W>
+	U& Graph<T, U, W>::operator[](const T& key)
 	{
 		return getVertex(key);
 	}
 
-	template <typename T, typename U>
-	const U& Graph<T, U>::operator[](const T& key) const
+	template <typename T, typename U, typename W>
+	const U& Graph<T, U, W>::operator[](const T& key) const
 	{
 		return getVertex(key);
 	}
 
 	// Returns true if there aren't any vertices in the graph
-	template <typename T, typename U>
-	bool Graph<T, U>::empty() const
+	template <typename T, typename U, typename W>
+	bool Graph<T, U, W>::empty() const
 	{
-		return numVerts == 0;
+		return state->numVerts == 0;
 	}
 
 	// Returns the number of vertices in the graph
-	template <typename T, typename U>
-	std::size_t Graph<T, U>::size() const
+	template <typename T, typename U, typename W>
+	std::size_t Graph<T, U, W>::size() const
 	{
-		return numVerts;
+		return state->numVerts;
+	}
+
+	// Returns one past the largest id in use, for sizing arrays indexed by VertexId::index. Equals size() until a vertex is removed
+	template <typename T, typename U, typename W>
+	std::size_t Graph<T, U, W>::idBound() const
+	{
+		return state->numIds;
 	}
 
 	// Returns true if the graph contains a vertex with the given key
-	template <typename T, typename U>
-	bool Graph<T, U>::contains(const T& key) const
+	template <typename T, typename U, typename W>
+	bool Graph<T, U, W>::contains(const T& key) const
+	{
+		const HashTable<T, VertexId>* ids{ keysOf(key) };
+		return ids && ids->contains(key);
+	}
+
+	// Returns true if the given id belongs to a vertex in the graph
+	template <typename T, typename U, typename W>
+	bool Graph<T, U, W>::contains(VertexId id) const
+	{
+		return id.index < state->numIds && vertexAt(id.index);
+	}
+
+	// Returns the id of the vertex with the given key. Throws std::invalid_argument if no vertex with the given key exists
+	template <typename T, typename U, typename W>
+	VertexId Graph<T, U, W>::id(const T& key) const
+	{
+		return findId(key, "Not a valid vertex key");
+	}
+
+	// Returns the key of the vertex with the given id. Throws std::out_of_range if the id doesn't belong to a vertex in the graph
+	template <typename T, typename U, typename W>
+	const T& Graph<T, U, W>::key(VertexId id) const
 	{
-		return vertTable.contains(key);
+		return findVertex(id)->key;
 	}
 
-	// Adds a vertex with the given key and value to the graph. Supports perfect forwarding
-	template <typename T, typename U>
-	template <typename V, typename W> void Graph<T, U>::addVertex(V&& key, W&& value)
+	// Adds a vertex with the given key and value to the graph and returns its id. If a vertex with the key already exists, only its value is
+	// replaced. Supports perfect forwarding
+	template <typename T, typename U, typename W>
+	template <typename V, typename X> VertexId Graph<T, U, W>::addVertex(V&& key, X&& value)
 	{
-		Vertex* newVertex{ new Vertex(static_cast<W&&>(value)) };
-		vertTable[static_cast<V&&>(key)] = newVertex;
-		++numVerts;
+		detach();
+		const HashTable<T, VertexId>* ids{ keysOf(key) };
+		if (ids && ids->contains(key))
+		{
+			VertexId existing{ (*ids)[key] };
+			writableVertex(existing.index)->value = static_cast<X&&>(value);
+			return existing;
+		}
+
+		VertexId newId{};
+		if (!state->freeIds.empty())
+		{
+			newId = state->freeIds.top();
+			state->freeIds.pop();
+		}
+		else
+		{
+			if (state->numIds == state->numChunks * CHUNK_SIZE)
+				addChunk();
+			newId = VertexId{ static_cast<std::uint32_t>(state->numIds++) };
+		}
+		Vertex* newVertex{ new Vertex(key, static_cast<X&&>(value), trackIncoming) };
+		writableSlot(newId.index) = newVertex;
+		writableKeys(shardOf(key))[static_cast<V&&>(key)] = newId;
+		++state->numVerts;
+		return newId;
+	}
+
+	// Adds count vertices, the ith with keys[i] and values[i], sizing the vertex table once up front
+	template <typename T, typename U, typename W>
+	void Graph<T, U, W>::addVertices(const T* keys, const U* values, std::size_t count)
+	{
+		reserve(state->numVerts + count);
+		for (std::size_t i{ 0 }; i < count; ++i)
+		{
+			addVertex(keys[i], values[i]);
+		}
+	}
+
+	// Makes room for at least numVertices vertices in total without growing the key table or adding id chunks
+	template <typename T, typename U, typename W>
+	void Graph<T, U, W>::reserve(std::size_t numVertices)
+	{
+		detach();
+		for (std::size_t shard{ 0 }; shard < KEY_SHARDS; ++shard)
+		{
+			writableKeys(shard).reserve(numVertices / KEY_SHARDS + 1);
+		}
+		while (state->numChunks * CHUNK_SIZE < numVertices)
+		{
+			addChunk();
+		}
 	}
 
 	// Returns the value of the vertex with the given key. Throws std::invalid_argument if no vertex with the given key exists
-	template <typename T, typename U>
-	U& Graph<T, U>::getVertex(const T& key)
+	template <typename T, typename U, typename W>
+	U& Graph<T, U, W>::getVertex(const T& key)
+	{
+		detach();
+		return writableVertex(findId(key, "Not a valid vertex key").index)->value;
+	}
+
+	template <typename T, typename U, typename W>
+	const U& Graph<T, U, W>::getVertex(const T& key) const
+	{
+		return vertexAt(findId(key, "Not a valid vertex key").index)->value;
+	}
+
+	// Returns the value of the vertex with the given id. Throws std::out_of_range if the id doesn't belong to a vertex in the graph
+	template <typename T, typename U, typename W>
+	U& Graph<T, U, W>::getVertex(VertexId id)
+	{
+		findVertex(id);
+		detach();
+		return writableVertex(id.index)->value;
+	}
+
+	template <typename T, typename U, typename W>
+	const U& Graph<T, U, W>::getVertex(VertexId id) const
+	{
+		return findVertex(id)->value;
+	}
+
+	// Removes the vertex with the given key from the graph (if it exists)
+	template <typename T, typename U, typename W>
+	void Graph<T, U, W>::removeVertex(const T& key)
 	{
-		if (vertTable.contains(key))
-			return vertTable[key]->value;
+		const HashTable<T, VertexId>* ids{ keysOf(key) };
+		if (ids && ids->contains(key))
+			removeVertex((*ids)[key]);
+	}
+
+	// Removes the vertex with the given id from the graph. Takes time proportional to the vertex's degree if the graph is undirected or tracks
+	// incoming edges and to the size of the whole graph otherwise. Throws std::out_of_range if the id doesn't belong to a vertex in the graph
+	template <typename T, typename U, typename W>
+	void Graph<T, U, W>::removeVertex(VertexId id)
+	{
+		Vertex* vertex{ findVertex(id) };
+		detach();
+		if (undirected)
+		{
+			for (const VertexId& neighbor : vertex->edges)
+			{
+				if (neighbor != id)
+					writableVertex(neighbor.index)->edges.remove(id);
+			}
+		}
+		else if (trackIncoming)
+		{
+			for (const VertexId& source : *vertex->incoming)
+			{
+				if (source != id)
+					writableVertex(source.index)->edges.remove(id);
+			}
+			for (const VertexId& target : vertex->edges)
+			{
+				if (target != id)
+					writableVertex(target.index)->incoming->remove(id);
+			}
+		}
+		else
+		{
+			// Finding and removing all edges to the vertex. Vertices without one stay shared
+			for (std::size_t index{ 0 }; index < state->numIds; ++index)
+			{
+				const Vertex* source{ vertexAt(index) };
+				if (source && index != id.index && source->edges.contains(id))
+					writableVertex(index)->edges.remove(id);
+			}
+		}
+		writableKeys(shardOf(vertex->key)).remove(vertex->key);
+		writableSlot(id.index) = nullptr;
+		drop(vertex);
+		state->freeIds.push(id);
+		--state->numVerts;
+	}
+
+	// Returns true if there's an edge from the vertex with key1 to the vertex with key2. Throws std::invalid_argument if no vertex exists for one or both of the keys
+	template <typename T, typename U, typename W>
+	bool Graph<T, U, W>::adjacent(const T& key1, const T& key2) const
+	{
+		VertexId id1{ findId(key1, "One or both of the given keys are not valid") };
+		VertexId id2{ findId(key2, "One or both of the given keys are not valid") };
+		return vertexAt(id1.index)->edges.contains(id2);
+	}
+
+	// Returns true if there's an edge from the vertex with id1 to the vertex with id2. Throws std::out_of_range if either id doesn't belong to a
+	// vertex in the graph
+	template <typename T, typename U, typename W>
+	bool Graph<T, U, W>::adjacent(VertexId id1, VertexId id2) const
+	{
+		findVertex(id2);
+		return findVertex(id1)->edges.contains(id2);
+	}
+
+	// Returns a constant reference to the outgoing edge table of the vertex with the given key. The table is full of target id-weight pairs
+	template <typename T, typename U, typename W>
+	const typename Graph<T, U, W>::EdgeTable& Graph<T, U, W>::getAdjacent(const T& key) const
+	{
+		return vertexAt(findId(key, "Not a valid vertex key").index)->edges;
+	}
+
+	// Returns a constant reference to the outgoing edge table of the vertex with the given id. Throws std::out_of_range if the id doesn't belong
+	// to a vertex in the graph
+	template <typename T, typename U, typename W>
+	const typename Graph<T, U, W>::EdgeTable& Graph<T, U, W>::getAdjacent(VertexId id) const
+	{
+		return findVertex(id)->edges;
+	}
 
-		throw std::invalid_argument("Not a valid vertex key");
+	// Returns the outgoing edges of the vertex with the given key as target id-weight pairs, so for (auto& [target, weight] : graph.edgesOf(key))
+	// reads every weight without looking it up in the edge table
+	template <typename T, typename U, typename W>
+	typename Graph<T, U, W>::EdgeRange Graph<T, U, W>::edgesOf(const T& key) const
+	{
+		return getAdjacent(key).pairs();
+	}
+
+	// Returns the outgoing edges of the vertex with the given id as target id-weight pairs. Throws std::out_of_range if the id doesn't belong
+	// to a vertex in the graph
+	template <typename T, typename U, typename W>
+	typename Graph<T, U, W>::EdgeRange Graph<T, U, W>::edgesOf(VertexId id) const
+	{
+		return getAdjacent(id).pairs();
+	}
+
+	// Returns a constant reference to the incoming edge table of the vertex with the given key. The table is full of source id-weight pairs,
+	// and is the outgoing edge table in an undirected graph. Throws std::logic_error if the graph is directed and doesn't track incoming edges
+	template <typename T, typename U, typename W>
+	const typename Graph<T, U, W>::EdgeTable& Graph<T, U, W>::getIncoming(const T& key) const
+	{
+		if (!trackIncoming && !undirected)
+			throw std::logic_error("The graph doesn't track incoming edges");
+
+		const Vertex* vertex{ vertexAt(findId(key, "Not a valid vertex key").index) };
+		return undirected ? vertex->edges : *vertex->incoming;
+	}
+
+	template <typename T, typename U, typename W>
+	const typename Graph<T, U, W>::EdgeTable& Graph<T, U, W>::getIncoming(VertexId id) const
+	{
+		if (!trackIncoming && !undirected)
+			throw std::logic_error("The graph doesn't track incoming edges");
+
+		const Vertex* vertex{ findVertex(id) };
+		return undirected ? vertex->edges : *vertex->incoming;
+	}
+
+	// Returns true if getIncoming can be called: the graph keeps an index of incoming edges or is undirected
+	template <typename T, typename U, typename W>
+	bool Graph<T, U, W>::tracksIncoming() const
+	{
+		return trackIncoming || undirected;
+	}
+
+	// Returns false if the graph is undirected
+	template <typename T, typename U, typename W>
+	bool Graph<T, U, W>::directed() const
+	{
+		return !undirected;
+	}
+
+	// Returns the weight of the outgoing edge from the vertex with key1 to the vertex with key2. Throws std::invalid_argument if no vertex exists for one or both of the keys
+	// or if no outgoing edge from vertex1 to vertex2 exists
+	template <typename T, typename U, typename W>
+	typename Graph<T, U, W>::Weight Graph<T, U, W>::getWeight(const T& key1, const T& key2) const
+	{
+		VertexId id1{ findId(key1, "One or both of the given keys are not valid") };
+		VertexId id2{ findId(key2, "One or both of the given keys are not valid") };
+		return getWeight(id1, id2);
+	}
+
+	// Returns the weight of the outgoing edge from the vertex with id1 to the vertex with id2. Throws std::out_of_range if either id doesn't
+	// belong to a vertex in the graph and std::invalid_argument if no outgoing edge from vertex1 to vertex2 exists
+	template <typename T, typename U, typename W>
+	typename Graph<T, U, W>::Weight Graph<T, U, W>::getWeight(VertexId id1, VertexId id2) const
+	{
+		findVertex(id2);
+		const EdgeTable& edges{ findVertex(id1)->edges };
+		if (edges.contains(id2))
+			return edges[id2];
+
+		throw std::invalid_argument("No edge from key1 vertex to key2 vertex");
 	}
 
-	template <typename T, typename U>
-	const U& Graph<T, U>::getVertex(const T& key) const
+	// Adds an outgoing edge from the vertex with key1 to the vertex with key2, or updates the weight of the existing edge. In an undirected graph
+	// the edge also goes from key2 to key1. Throws std::invalid_argument if no vertex exists for one or both of the keys
+	template <typename T, typename U, typename W>
+	void Graph<T, U, W>::addEdge(const T& key1, const T& key2, Weight weight)
 	{
-		if (vertTable.contains(key))
-			return vertTable[key]->value;
+		VertexId id1{ findId(key1, "One or both of the given keys are not valid") };
+		VertexId id2{ findId(key2, "One or both of the given keys are not valid") };
+		detach();
+		writableVertex(id1.index)->edges[id2] = weight;
+		if (undirected)
+			writableVertex(id2.index)->edges[id1] = weight;
+		else if (trackIncoming)
+			(*writableVertex(id2.index)->incoming)[id1] = weight;
+	}
 
-		throw std::invalid_argument("Not a valid vertex key");
+	// Adds an outgoing edge from the vertex with id1 to the vertex with id2, or updates the weight of the existing edge. Throws std::out_of_range
+	// if either id doesn't belong to a vertex in the graph
+	template <typename T, typename U, typename W>
+	void Graph<T, U, W>::addEdge(VertexId id1, VertexId id2, Weight weight)
+	{
+		findVertex(id1);
+		findVertex(id2);
+		detach();
+		writableVertex(id1.index)->edges[id2] = weight;
+		if (undirected)
+			writableVertex(id2.index)->edges[id1] = weight;
+		else if (trackIncoming)
+			(*writableVertex(id2.index)->incoming)[id1] = weight;
 	}
 
-	// Removes the vertex with the given key from the graph
-	template <typename T, typename U>
-	void Graph<T, U>::removeVertex(const T& key)
+	// Adds or updates count edges as if by addEdge, but looks every endpoint up only once and sizes each vertex's edge table for its new edges
+	// before inserting any. Throws std::invalid_argument, without changing the graph, if an endpoint of any edge isn't a valid key
+	template <typename T, typename U, typename W>
+	void Graph<T, U, W>::addEdges(const GraphEdge<T, W>* edges, std::size_t count)
 	{
-		if (vertTable.contains(key))
+		GraphEdge<VertexId, W>* resolved{ new GraphEdge<VertexId, W>[count] };
+		try
 		{
-			// Removing the vertex itself
-			delete vertTable[key];
-			vertTable.remove(key);
-			--numVerts;
-			// Finding and removing all edges to the vertex
-			for (T& vertKey : vertTable)
+			for (std::size_t i{ 0 }; i < count; ++i)
 			{
-				for (T& adjacentKey : vertTable[vertKey]->edges)
+				resolved[i].from = findId(edges[i].from, "One or both of the given keys are not valid");
+				resolved[i].to = findId(edges[i].to, "One or both of the given keys are not valid");
+				resolved[i].weight = edges[i].weight;
+			}
+		}
+		catch (const std::invalid_argument&)
+		{
+			delete[] resolved;
+			throw;
+		}
+		addEdges(resolved, count);
+		delete[] resolved;
+	}
+
+	// Adds or updates count edges between the vertices with the given ids, sizing each vertex's edge table for its new edges before inserting
+	// any. Throws std::out_of_range, without changing the graph, if an endpoint of any edge doesn't belong to a vertex in the graph
+	template <typename T, typename U, typename W>
+	void Graph<T, U, W>::addEdges(const GraphEdge<VertexId, W>* edges, std::size_t count)
+	{
+		for (std::size_t i{ 0 }; i < count; ++i)
+		{
+			findVertex(edges[i].from);
+			findVertex(edges[i].to);
+		}
+
+		// New edges and incoming edges of every vertex, counted by id so that counting doesn't copy shared vertices
+		std::size_t* edgeCounts{ new std::size_t[idBound()]{} };
+		std::size_t* incomingCounts{ trackIncoming ? new std::size_t[idBound()]{} : nullptr };
+		for (std::size_t i{ 0 }; i < count; ++i)
+		{
+			++edgeCounts[edges[i].from.index];
+			if (undirected)
+				++edgeCounts[edges[i].to.index];
+			else if (trackIncoming)
+				++incomingCounts[edges[i].to.index];
+		}
+
+		// Reserving once per vertex, then clearing its counts so that it's reserved only once. Every vertex that gains an edge is made the
+		// graph's own here, so the rest of the batch writes through vertexAt
+		detach();
+		for (std::size_t i{ 0 }; i < count; ++i)
+		{
+			for (std::uint32_t index : { edges[i].from.index, edges[i].to.index })
+			{
+				if (edgeCounts[index])
 				{
-					if (adjacentKey == key)
-					{
-						vertTable[vertKey]->edges.remove(key);
-						break;
-					}
+					Vertex* vertex{ writableVertex(index) };
+					vertex->edges.reserve(vertex->edges.size() + edgeCounts[index]);
+					edgeCounts[index] = 0;
+				}
+				if (incomingCounts && incomingCounts[index])
+				{
+					Vertex* vertex{ writableVertex(index) };
+					vertex->incoming->reserve(vertex->incoming->size() + incomingCounts[index]);
+					incomingCounts[index] = 0;
 				}
 			}
 		}
+		delete[] edgeCounts;
+		delete[] incomingCounts;
+		for (std::size_t i{ 0 }; i < count; ++i)
+		{
+			vertexAt(edges[i].from.index)->edges[edges[i].to] = edges[i].weight;
+			if (undirected)
+				vertexAt(edges[i].to.index)->edges[edges[i].from] = edges[i].weight;
+			else if (trackIncoming)
+				(*vertexAt(edges[i].to.index)->incoming)[edges[i].from] = edges[i].weight;
+		}
 	}
 
-	// Returns true if there's an edge from the vertex with key1 to the vertex with key2. Throws std::invalid_argument if no vertex exists for one or both of the keys
-	template <typename T, typename U>
-	bool Graph<T, U>::adjacent(const T& key1, const T& key2) const
+	// Removes the outgoing edge between the vertex with key1 and the vertex with key2, and in an undirected graph the edge back
+	template <typename T, typename U, typename W>
+	void Graph<T, U, W>::removeEdge(const T& key1, const T& key2)
+	{
+		VertexId id1{ findId(key1, "One or both of the given keys are not valid") };
+		VertexId id2{ findId(key2, "One or both of the given keys are not valid") };
+		removeEdge(id1, id2);
+	}
+
+	// Removes the outgoing edge between the vertex with id1 and the vertex with id2. Throws std::out_of_range if either id doesn't belong to a
+	// vertex in the graph
+	template <typename T, typename U, typename W>
+	void Graph<T, U, W>::removeEdge(VertexId id1, VertexId id2)
+	{
+		findVertex(id2);
+		if (!findVertex(id1)->edges.contains(id2))
+			return;
+
+		detach();
+		writableVertex(id1.index)->edges.remove(id2);
+		if (undirected)
+			writableVertex(id2.index)->edges.remove(id1);
+		else if (trackIncoming)
+			writableVertex(id2.index)->incoming->remove(id1);
+	}
+
+	// Clears all vertices and edges from the graph
+	template <typename T, typename U, typename W>
+	void Graph<T, U, W>::clear()
 	{
-		if (vertTable.contains(key1) && vertTable.contains(key2))
+		release();
+		state = emptyState();
+	}
+
+	// Returns a copy of the graph in constant time. The copy shares this graph's vertices, edges and key index, and a change on either side
+	// copies only what it touches: the vertices whose edges or value change, the chunks of CHUNK_SIZE ids holding them, the key shards of
+	// added and removed keys and the array of chunk pointers. Graphs sharing parts may be used from different threads, each by one thread at
+	// a time. References into either graph, and values reached through the non-constant getVertex and operator[] before the call, must not
+	// be used to change it afterwards
+	template <typename T, typename U, typename W>
+	Graph<T, U, W> Graph<T, U, W>::share() const
+	{
+		Graph<T, U, W> shared{ undirected ? GraphOptions::Undirected : trackIncoming ? GraphOptions::TrackIncoming : GraphOptions::None };
+		if (state != emptyState())
 		{
-			return vertTable[key1]->edges.contains(key2);
+			hold(state);
+			shared.state = state;
 		}
-		throw std::invalid_argument("One or both of the given keys are not valid");
+		return shared;
 	}
 
-	// Returns a constant reference to the outgoing edge table of the vertex with the given key. The table is full of key-weight pairs
-	template <typename T, typename U>
-	const HashTable<T, int>& Graph<T, U>::getAdjacent(const T& key) const
+	// Returns a read-only handle to the current version of the graph in constant time, as share() does
+	template <typename T, typename U, typename W>
+	GraphSnapshot<T, U, W> Graph<T, U, W>::snapshot() const
 	{
-		if (vertTable.contains(key))
-			return vertTable[key]->edges;
+		return GraphSnapshot<T, U, W>{ share() };
+	}
 
-		throw std::invalid_argument("Not a valid vertex key");
+	// Returns an immutable compressed sparse row snapshot of the graph with dense vertex ids. Later changes to the graph don't affect the snapshot.
+	// The snapshot of an undirected graph lists every edge from both ends
+	template <typename T, typename U, typename W>
+	CsrGraph<T, U, W> Graph<T, U, W>::freeze() const
+	{
+		return CsrGraph<T, U, W>(*this);
 	}
 
-	// Returns the weight of the outgoing edge from the vertex with key1 to the vertex with key2. Throws std::invalid_argument if no vertex exists for one or both of the keys
-	// or if no outgoing edge from vertex1 to vertex2 exists
-	template <typename T, typename U>
-	int Graph<T, U>::getWeight(const T& key1, const T& key2) const
+	// Returns the id of the vertex with the given key. Throws std::invalid_argument with the given message if no vertex with the key exists
+	template <typename T, typename U, typename W>
+	VertexId Graph<T, U, W>::findId(const T& key, const char* message) const
 	{
-		if (vertTable.contains(key1) && vertTable.contains(key2))
+		// The constant find looks the key up once and throws if it's missing, saving a separate contains
+		const HashTable<T, VertexId>* ids{ keysOf(key) };
+		try
 		{
-			if (vertTable[key1]->edges.contains(key2))
-				return vertTable[key1]->edges[key2];
+			if (ids)
+				return ids->find(key);
+		}
+		catch (const std::invalid_argument&)
+		{}
+		throw std::invalid_argument(message);
+	}
+
+	// Returns the vertex with the given id. Throws std::out_of_range if the id doesn't belong to a vertex in the graph
+	template <typename T, typename U, typename W>
+	typename Graph<T, U, W>::Vertex* Graph<T, U, W>::findVertex(VertexId id) const
+	{
+		Vertex* vertex{ id.index < state->numIds ? vertexAt(id.index) : nullptr };
+		if (!vertex)
+			throw std::out_of_range("Not a valid vertex id");
+
+		return vertex;
+	}
+
+	// Returns the vertex with the given id, or nullptr if the id isn't in use. Expects the id to be below numIds
+	template <typename T, typename U, typename W>
+	typename Graph<T, U, W>::Vertex* Graph<T, U, W>::vertexAt(std::size_t index) const
+	{
+		return state->chunks[index >> CHUNK_BITS]->vertices[index & (CHUNK_SIZE - 1)];
+	}
+
+	// Returns the ids of the key shard the key belongs in, or nullptr if no key has picked the shard yet
+	template <typename T, typename U, typename W>
+	const HashTable<T, VertexId>* Graph<T, U, W>::keysOf(const T& key) const
+	{
+		const KeyShard* shard{ state->keyShards[shardOf(key)] };
+		return shard ? &shard->ids : nullptr;
+	}
+
+	// Returns the state of every graph without vertices, which is never changed or deleted, so creating and moving graphs doesn't allocate
+	template <typename T, typename U, typename W>
+	typename Graph<T, U, W>::State* Graph<T, U, W>::emptyState()
+	{
+		static State empty{};
+		return &empty;
+	}
+
+	// Returns a copy of the state for the copy constructor and copy assignment. It shares the key shards, but not the vertices, so values
+	// changed through references taken before the copy don't show in it
+	template <typename T, typename U, typename W>
+	typename Graph<T, U, W>::State* Graph<T, U, W>::copyState(const State& state)
+	{
+		if (&state == emptyState())
+			return emptyState();
 
-			else
-				throw std::invalid_argument("No edge from key1 vertex to key2 vertex");
+		State* copy{ new State(state) };
+		for (std::size_t chunk{ 0 }; chunk < copy->numChunks; ++chunk)
+		{
+			Chunk* ownChunk{ new Chunk{} };
+			for (std::size_t slot{ 0 }; slot < CHUNK_SIZE; ++slot)
+			{
+				const Vertex* vertex{ state.chunks[chunk]->vertices[slot] };
+				if (vertex)
+					ownChunk->vertices[slot] = new Vertex(*vertex);
+			}
+			drop(copy->chunks[chunk]);
+			copy->chunks[chunk] = ownChunk;
 		}
-		else
-			throw std::invalid_argument("One or both of the given keys are not valid");
+		return copy;
+	}
+
+	// Returns the key shard of the key, from the top bits of its hash times a Fibonacci constant. The bits the shard's own table uses to
+	// pick a bucket stay spread out within every shard
+	template <typename T, typename U, typename W>
+	std::size_t Graph<T, U, W>::shardOf(const T& key)
+	{
+		std::uint64_t hash{ static_cast<std::uint64_t>(std::hash<T>{}(key)) * 0x9E3779B97F4A7C15ull };
+		return static_cast<std::size_t>(hash >> (64 - KEY_SHARD_BITS));
+	}
+
+	// Adds an owner to the record
+	template <typename T, typename U, typename W>
+	template <typename R> void Graph<T, U, W>::hold(R* record)
+	{
+		record->owners.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// Removes an owner from the record and deletes it if that was the last. Does nothing given nullptr
+	template <typename T, typename U, typename W>
+	template <typename R> void Graph<T, U, W>::drop(R* record)
+	{
+		if (record && record->owners.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete record;
 	}
 
-	// Adds an outgoing edge from the vertex with key1 to the vertex with key2, or updates the weight of the existing edge. Throws std::invalid_argument if no vertex
-	// exists for one or both of the keys
-	template <typename T, typename U>
-	void Graph<T, U>::addEdge(const T& key1, const T& key2, int weight)
+	// Gives the graph a state of its own before a change. Copying a shared state only copies its chunk array and key shard pointers
+	template <typename T, typename U, typename W>
+	void Graph<T, U, W>::detach()
 	{
-		if (vertTable.contains(key1) && vertTable.contains(key2))
+		if (state == emptyState())
+			state = new State{};
+		else if (state->owners.load(std::memory_order_acquire) != 1)
 		{
-			vertTable[key1]->edges[key2] = weight;
+			State* copy{ new State(*state) };
+			release();
+			state = copy;
 		}
-		else
-			throw std::invalid_argument("One or both of the given keys are not valid");
 	}
 
-	// Removes the outgoing edge between the vertex with key1 and the vertex with key2
-	template <typename T, typename U>
-	void Graph<T, U>::removeEdge(const T& key1, const T& key2)
+	// Drops this graph's hold on its state, deleting the state if no other graph holds it
+	template <typename T, typename U, typename W>
+	void Graph<T, U, W>::release()
 	{
-		if (vertTable.contains(key1) && vertTable.contains(key2))
+		if (state != emptyState())
+			drop(state);
+	}
+
+	// Adds a chunk of unused ids after the last one, growing the chunk array if it's full. Expects the state to be the graph's own
+	template <typename T, typename U, typename W>
+	void Graph<T, U, W>::addChunk()
+	{
+		if (state->numChunks == state->chunkCapacity)
 		{
-			vertTable[key1]->edges.remove(key2);
+			state->chunkCapacity = state->chunkCapacity ? 2 * state->chunkCapacity : 1;
+			Chunk** newChunks{ new Chunk*[state->chunkCapacity] };
+			for (std::size_t i{ 0 }; i < state->numChunks; ++i)
+			{
+				newChunks[i] = state->chunks[i];
+			}
+			delete[] state->chunks;
+			state->chunks = newChunks;
 		}
-		else
-			throw std::invalid_argument("One or both of the given keys are not valid");
+		state->chunks[state->numChunks++] = new Chunk{};
 	}
 
-	// Clears all vertices and edges from the graph
-	template <typename T, typename U>
-	void Graph<T, U>::clear()
+	// Returns the place of the id in a chunk of the graph's own, copying the chunk if it's shared. Expects the state to be the graph's own
+	template <typename T, typename U, typename W>
+	typename Graph<T, U, W>::Vertex*& Graph<T, U, W>::writableSlot(std::size_t index)
+	{
+		Chunk*& chunk{ state->chunks[index >> CHUNK_BITS] };
+		if (state->copied.load(std::memory_order_relaxed) && chunk->owners.load(std::memory_order_acquire) != 1)
+		{
+			Chunk* copy{ new Chunk(*chunk) };
+			drop(chunk);
+			chunk = copy;
+		}
+		return chunk->vertices[index & (CHUNK_SIZE - 1)];
+	}
+
+	// Returns the vertex with the given id as the graph's own, copying it and its chunk if they're shared. Expects the state to be the graph's
+	// own and the id to be in use
+	template <typename T, typename U, typename W>
+	typename Graph<T, U, W>::Vertex* Graph<T, U, W>::writableVertex(std::size_t index)
+	{
+		Vertex*& vertex{ writableSlot(index) };
+		if (state->copied.load(std::memory_order_relaxed) && vertex->owners.load(std::memory_order_acquire) != 1)
+		{
+			Vertex* copy{ new Vertex(*vertex) };
+			drop(vertex);
+			vertex = copy;
+		}
+		return vertex;
+	}
+
+	// Returns the ids of the given key shard as the graph's own, creating the shard if it's missing and copying it if it's shared. Expects
+	// the state to be the graph's own
+	template <typename T, typename U, typename W>
+	HashTable<T, VertexId>& Graph<T, U, W>::writableKeys(std::size_t shard)
 	{
-		for (auto& key : vertTable)
+		KeyShard*& keys{ state->keyShards[shard] };
+		if (!keys)
+			keys = new KeyShard{};
+		else if (state->copied.load(std::memory_order_relaxed) && keys->owners.load(std::memory_order_acquire) != 1)
 		{
-			delete vertTable[key];
+			KeyShard* copy{ new KeyShard(*keys) };
+			drop(keys);
+			keys = copy;
 		}
-		vertTable.clear();
-		numVerts = 0;
+		return keys->ids;
 	}
 
 	// Vertex class implementation
 
-	template <typename T, typename U>
-	Graph<T, U>::Vertex::Vertex(const U& value) :
-		value{ value }
+	template <typename T, typename U, typename W>
+	template <typename V, typename X> Graph<T, U, W>::Vertex::Vertex(V&& key, X&& value, bool trackIncoming) :
+		key{ static_cast<V&&>(key) }, value{ static_cast<X&&>(value) }, incoming{ trackIncoming ? new EdgeTable{ 1 } : nullptr }
+	{}
+
+	template <typename T, typename U, typename W>
+	Graph<T, U, W>::Vertex::Vertex(const Vertex& vertex) :
+		key{ vertex.key }, value{ vertex.value }, edges{ vertex.edges }, incoming{ vertex.incoming ? new EdgeTable{ *vertex.incoming } : nullptr }
 	{}
 
-	template <typename T, typename U>
-	Graph<T, U>::Vertex::Vertex(U&& value) :
-		value{ value }
+	template <typename T, typename U, typename W>
+	Graph<T, U, W>::Vertex::~Vertex()
+	{
+		delete incoming;
+	}
+
+	// Chunk class implementation
+
+	template <typename T, typename U, typename W>
+	Graph<T, U, W>::Chunk::Chunk(const Chunk& chunk)
+	{
+		for (std::size_t slot{ 0 }; slot < CHUNK_SIZE; ++slot)
+		{
+			vertices[slot] = chunk.vertices[slot];
+			if (vertices[slot])
+				hold(vertices[slot]);
+		}
+	}
+
+	template <typename T, typename U, typename W>
+	Graph<T, U, W>::Chunk::~Chunk()
+	{
+		for (std::size_t slot{ 0 }; slot < CHUNK_SIZE; ++slot)
+		{
+			drop(vertices[slot]);
+		}
+	}
+
+	// KeyShard class implementation
+
+	template <typename T, typename U, typename W>
+	Graph<T, U, W>::KeyShard::KeyShard(const KeyShard& shard) :
+		ids{ shard.ids }
 	{}
+
+	// State class implementation
+
+	template <typename T, typename U, typename W>
+	Graph<T, U, W>::State::State(const State& state) :
+		numVerts{ state.numVerts }, numIds{ state.numIds }, chunks{ state.numChunks ? new Chunk*[state.numChunks] : nullptr },
+		numChunks{ state.numChunks }, chunkCapacity{ state.numChunks }, freeIds{ state.freeIds }
+	{
+		copied.store(true, std::memory_order_relaxed);
+		state.copied.store(true, std::memory_order_relaxed);
+		for (std::size_t chunk{ 0 }; chunk < numChunks; ++chunk)
+		{
+			chunks[chunk] = state.chunks[chunk];
+			hold(chunks[chunk]);
+		}
+		for (std::size_t shard{ 0 }; shard < KEY_SHARDS; ++shard)
+		{
+			keyShards[shard] = state.keyShards[shard];
+			if (keyShards[shard])
+				hold(keyShards[shard]);
+		}
+	}
+
+	template <typename T, typename U, typename W>
+	Graph<T, U, W>::State::~State()
+	{
+		for (std::size_t chunk{ 0 }; chunk < numChunks; ++chunk)
+		{
+			drop(chunks[chunk]);
+		}
+		delete[] chunks;
+		for (std::size_t shard{ 0 }; shard < KEY_SHARDS; ++shard)
+		{
+			drop(keyShards[shard]);
+		}
+	}
+
+	// GraphSnapshot class implementation
+
+	template <typename T, typename U, typename W>
+	GraphSnapshot<T, U, W>::GraphSnapshot(Graph<T, U, W>&& graph) :
+		graph{ static_cast<Graph<T, U, W>&&>(graph) }
+	{}
+
+	// Copy constructor. The copy reads the same version
+	template <typename T, typename U, typename W>
+	GraphSnapshot<T, U, W>::GraphSnapshot(const GraphSnapshot<T, U, W>& snapshot) :
+		graph{ snapshot.graph.share() }
+	{}
+
+	// Copy assignment
+	template <typename T, typename U, typename W>
+	GraphSnapshot<T, U, W>& GraphSnapshot<T, U, W>::operator=(const GraphSnapshot<T, U, W>& snapshot)
+	{
+		graph = snapshot.graph.share();
+		return *this;
+	}
+
+	// Returns the version of the graph the snapshot holds
+	template <typename T, typename U, typename W>
+	const Graph<T, U, W>& GraphSnapshot<T, U, W>::operator*() const
+	{
+		return graph;
+	}
+
+	template <typename T, typename U, typename W>
+	const Graph<T, U, W>* GraphSnapshot<T, U, W>::operator->() const
+	{
+		return &graph;
+	}
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,26 @@
+#ifndef JML_GRAPH_ALGORITHMS_H
+#define JML_GRAPH_ALGORITHMS_H
+
+#include <cstddef>
+
+#include "CsrGraph.h"
+#include "Graph.h"
+#include "HashTable.h"
+#include "Heap.h"
+
+namespace JML
+{
+	// Key-based traversals and searches over a Graph. Each one looks the keys up once and runs over VertexIds with arrays sized by idBound(),
+	// so nothing of the graph is copied. Callers running several algorithms over an unchanged graph may still prefer to freeze it once and use
+	// the CsrGraph methods, which read contiguous edge arrays
+	template <typename T, typename U, typename W, typename F> void bfs(const Graph<T, U, W>& graph, const T& source, F&& visit);
+	template <typename T, typename U, typename W, typename F> void dfs(const Graph<T, U, W>& graph, const T& source, F&& visit);
+	template <typename T, typename U, typename W> HashTable<T, typename EdgeWeight<W>::Distance> dijkstra(const Graph<T, U, W>& graph, const T& source);
+	template <typename T, typename U, typename W> bool topologicalSort(const Graph<T, U, W>& graph, T* order);
+	template <typename T, typename U, typename W> std::size_t connectedComponents(const Graph<T, U, W>& graph, HashTable<T, std::size_t>& components);
+	template <typename T, typename U, typename W> std::size_t stronglyConnectedComponents(const Graph<T, U, W>& graph, HashTable<T, std::size_t>& components);
+	template <typename T, typename U, typename W> bool hasCycle(const Graph<T, U, W>& graph);
+	template <typename T, typename U, typename W> Graph<std::size_t, std::size_t, W> condensation(const Graph<T, U, W>& graph, HashTable<T, std::size_t>& components);
+}
+#include "GraphAlgorithms.hpp"
+#endif
@@ -0,0 +1,512 @@
+#ifndef JML_GRAPH_ALGORITHMS_HPP
+#define JML_GRAPH_ALGORITHMS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "CsrGraph.h"
+#include "Graph.h"
+#include "HashTable.h"
+#include "Heap.h"
+
+namespace JML
+{
+	// Depth-first search frame over a Graph: a vertex id and the rest of its edges to follow
+	template <typename I>
+	struct IdEdgeRange
+	{
+		std::uint32_t id{};
+		I edge{};
+		I end{};
+	};
+
+	// Calls visit with the key of every vertex reachable from source, in breadth-first order. Throws std::invalid_argument if no vertex with the
+	// source key exists
+	template <typename T, typename U, typename W, typename F>
+	void bfs(const Graph<T, U, W>& graph, const T& source, F&& visit)
+	{
+		VertexId sourceId{ graph.id(source) };
+		std::uint64_t* visited{ new std::uint64_t[(graph.idBound() + 63) / 64]{} };
+		// The order doubles as the queue: everything between head and tail is waiting to be expanded
+		std::uint32_t* order{ new std::uint32_t[graph.size()] };
+		std::size_t head{ 0 };
+		std::size_t tail{ 0 };
+		order[tail++] = sourceId.index;
+		visited[sourceId.index / 64] |= std::uint64_t{ 1 } << (sourceId.index % 64);
+		while (head < tail)
+		{
+			for (const auto& [target, weight] : graph.edgesOf(VertexId{ order[head++] }))
+			{
+				std::uint64_t bit{ std::uint64_t{ 1 } << (target.index % 64) };
+				if (!(visited[target.index / 64] & bit))
+				{
+					visited[target.index / 64] |= bit;
+					order[tail++] = target.index;
+				}
+			}
+		}
+		delete[] visited;
+		for (std::size_t i{ 0 }; i < tail; ++i)
+		{
+			visit(graph.key(VertexId{ order[i] }));
+		}
+		delete[] order;
+	}
+
+	// Calls visit with the key of every vertex reachable from source, in depth-first preorder. Throws std::invalid_argument if no vertex with the
+	// source key exists
+	template <typename T, typename U, typename W, typename F>
+	void dfs(const Graph<T, U, W>& graph, const T& source, F&& visit)
+	{
+		using EdgeIterator = decltype(graph.edgesOf(VertexId{}).begin());
+		VertexId sourceId{ graph.id(source) };
+		std::uint64_t* visited{ new std::uint64_t[(graph.idBound() + 63) / 64]{} };
+		// Each frame remembers the next edge to follow, so every vertex is on the stack at most once
+		IdEdgeRange<EdgeIterator>* frames{ new IdEdgeRange<EdgeIterator>[graph.size()] };
+		std::uint32_t* order{ new std::uint32_t[graph.size()] };
+		std::size_t stackSize{ 0 };
+		std::size_t count{ 0 };
+		order[count++] = sourceId.index;
+		visited[sourceId.index / 64] |= std::uint64_t{ 1 } << (sourceId.index % 64);
+		typename Graph<T, U, W>::EdgeRange edges{ graph.edgesOf(sourceId) };
+		frames[stackSize++] = IdEdgeRange<EdgeIterator>{ sourceId.index, edges.begin(), edges.end() };
+		while (stackSize > 0)
+		{
+			IdEdgeRange<EdgeIterator>& frame{ frames[stackSize - 1] };
+			if (frame.edge == frame.end)
+			{
+				--stackSize;
+				continue;
+			}
+			VertexId target{ (*frame.edge).key };
+			++frame.edge;
+			std::uint64_t bit{ std::uint64_t{ 1 } << (target.index % 64) };
+			if (!(visited[target.index / 64] & bit))
+			{
+				visited[target.index / 64] |= bit;
+				order[count++] = target.index;
+				edges = graph.edgesOf(target);
+				frames[stackSize++] = IdEdgeRange<EdgeIterator>{ target.index, edges.begin(), edges.end() };
+			}
+		}
+		delete[] frames;
+		delete[] visited;
+		for (std::size_t i{ 0 }; i < count; ++i)
+		{
+			visit(graph.key(VertexId{ order[i] }));
+		}
+		delete[] order;
+	}
+
+	// Returns a table of shortest path distances from source to every reachable vertex, counting edges if the graph is unweighted. Edge weights
+	// must not be negative. Throws std::invalid_argument if no vertex with the source key exists
+	template <typename T, typename U, typename W>
+	HashTable<T, typename EdgeWeight<W>::Distance> dijkstra(const Graph<T, U, W>& graph, const T& source)
+	{
+		using Distance = typename EdgeWeight<W>::Distance;
+		constexpr Distance UNREACHABLE{ -1 };
+		VertexId sourceId{ graph.id(source) };
+		Distance* distances{ new Distance[graph.idBound()] };
+		for (std::size_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			distances[index] = UNREACHABLE;
+		}
+		distances[sourceId.index] = 0;
+		Heap<IdDistance<Distance>, closerDistance<Distance>> queue;
+		queue.insert(IdDistance<Distance>{ sourceId.index, 0 });
+		while (!queue.empty())
+		{
+			IdDistance<Distance> current{ queue.top() };
+			queue.pop();
+			// Skipping entries made stale by a shorter path found after they were queued
+			if (current.distance != distances[current.id])
+				continue;
+
+			for (const auto& [target, weight] : graph.edgesOf(VertexId{ current.id }))
+			{
+				Distance distance{ current.distance + EdgeWeight<W>::length(weight) };
+				if (distances[target.index] == UNREACHABLE || distance < distances[target.index])
+				{
+					distances[target.index] = distance;
+					queue.insert(IdDistance<Distance>{ target.index, distance });
+				}
+			}
+		}
+		HashTable<T, Distance> result{ graph.size() };
+		for (std::uint32_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			if (distances[index] != UNREACHABLE)
+				result.insert(graph.key(VertexId{ index }), distances[index]);
+		}
+		delete[] distances;
+		return result;
+	}
+
+	// Writes the ids of the graph's vertices into order (size() entries) so that every edge goes from an earlier vertex to a later one (Kahn's
+	// algorithm). Returns the number of ids written, which is less than size() if the graph has a cycle
+	template <typename T, typename U, typename W>
+	std::size_t topologicalIds(const Graph<T, U, W>& graph, std::uint32_t* order)
+	{
+		std::size_t* inDegrees{ new std::size_t[graph.idBound()]{} };
+		for (std::uint32_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			if (!graph.contains(VertexId{ index }))
+				continue;
+
+			for (const auto& [target, weight] : graph.edgesOf(VertexId{ index }))
+			{
+				++inDegrees[target.index];
+			}
+		}
+
+		// The output doubles as the queue of vertices whose incoming edges have all been placed
+		std::size_t head{ 0 };
+		std::size_t tail{ 0 };
+		for (std::uint32_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			if (inDegrees[index] == 0 && graph.contains(VertexId{ index }))
+				order[tail++] = index;
+		}
+		while (head < tail)
+		{
+			for (const auto& [target, weight] : graph.edgesOf(VertexId{ order[head++] }))
+			{
+				if (--inDegrees[target.index] == 0)
+					order[tail++] = target.index;
+			}
+		}
+		delete[] inDegrees;
+		return tail;
+	}
+
+	// Writes the vertex keys into order (size() entries) so that every edge goes from an earlier vertex to a later one. Returns false, leaving
+	// order partially written, if the graph has a cycle. Throws std::logic_error if the graph is undirected
+	template <typename T, typename U, typename W>
+	bool topologicalSort(const Graph<T, U, W>& graph, T* order)
+	{
+		if (!graph.directed())
+			throw std::logic_error("The graph is undirected");
+
+		std::uint32_t* idOrder{ new std::uint32_t[graph.size()] };
+		std::size_t count{ topologicalIds(graph, idOrder) };
+		for (std::size_t i{ 0 }; i < count; ++i)
+		{
+			order[i] = graph.key(VertexId{ idOrder[i] });
+		}
+		delete[] idOrder;
+		return count == graph.size();
+	}
+
+	// Fills components with the weakly connected component number of every vertex key, numbering components from 0 in order of their lowest
+	// VertexId. Returns the number of components
+	template <typename T, typename U, typename W>
+	std::size_t connectedComponents(const Graph<T, U, W>& graph, HashTable<T, std::size_t>& components)
+	{
+		// Union-find over the edges with path halving. idComponents first holds parent links and is relabeled at the end
+		std::uint32_t* idComponents{ new std::uint32_t[graph.idBound()] };
+		for (std::uint32_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			idComponents[index] = index;
+		}
+		for (std::uint32_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			if (!graph.contains(VertexId{ index }))
+				continue;
+
+			for (const auto& [target, weight] : graph.edgesOf(VertexId{ index }))
+			{
+				std::uint32_t root1{ index };
+				while (idComponents[root1] != root1)
+				{
+					idComponents[root1] = idComponents[idComponents[root1]];
+					root1 = idComponents[root1];
+				}
+				std::uint32_t root2{ target.index };
+				while (idComponents[root2] != root2)
+				{
+					idComponents[root2] = idComponents[idComponents[root2]];
+					root2 = idComponents[root2];
+				}
+				// Linking the larger root under the smaller one keeps every root the lowest id of its component
+				if (root1 < root2)
+					idComponents[root2] = root1;
+				else
+					idComponents[root1] = root2;
+			}
+		}
+
+		// Roots come before the other members of their component, so a single ascending pass can relabel everything
+		std::size_t numComponents{ 0 };
+		components.clear();
+		components.reserve(graph.size());
+		for (std::uint32_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			if (!graph.contains(VertexId{ index }))
+				continue;
+
+			if (idComponents[index] == index)
+				idComponents[index] = static_cast<std::uint32_t>(numComponents++);
+			else
+				idComponents[index] = idComponents[idComponents[index]];
+			components.insert(graph.key(VertexId{ index }), static_cast<std::size_t>(idComponents[index]));
+		}
+		delete[] idComponents;
+		return numComponents;
+	}
+
+	// Writes the strongly connected component of every vertex into components (idBound() entries, left unset for unused ids) and returns the
+	// number of components. Components are numbered in topological order, so every edge between two components goes from the lower number to
+	// the higher one. Uses Tarjan's algorithm with an explicit stack, so deep graphs can't overflow the call stack
+	template <typename T, typename U, typename W>
+	std::size_t stronglyConnectedIds(const Graph<T, U, W>& graph, std::uint32_t* components)
+	{
+		using EdgeIterator = decltype(graph.edgesOf(VertexId{}).begin());
+		constexpr std::uint32_t UNSET{ ~std::uint32_t{ 0 } };
+		std::uint32_t* indices{ new std::uint32_t[graph.idBound()] };  // Discovery order of every vertex
+		std::uint32_t* lowLinks{ new std::uint32_t[graph.idBound()] };  // Lowest index reachable through the vertex's DFS subtree and one back edge
+		std::uint32_t* tarjanStack{ new std::uint32_t[graph.size()] };  // Visited vertices not yet assigned to a component
+		std::size_t tarjanSize{ 0 };
+		// Each vertex is on the DFS stack at most once
+		IdEdgeRange<EdgeIterator>* frames{ new IdEdgeRange<EdgeIterator>[graph.size()] };
+		std::size_t stackSize{ 0 };
+		for (std::size_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			indices[index] = UNSET;
+			// A visited vertex is on the Tarjan stack exactly while its component is unset
+			components[index] = UNSET;
+		}
+
+		std::uint32_t nextIndex{ 0 };
+		std::size_t numComponents{ 0 };
+		for (std::uint32_t root{ 0 }; root < graph.idBound(); ++root)
+		{
+			if (indices[root] != UNSET || !graph.contains(VertexId{ root }))
+				continue;
+
+			indices[root] = lowLinks[root] = nextIndex++;
+			tarjanStack[tarjanSize++] = root;
+			typename Graph<T, U, W>::EdgeRange edges{ graph.edgesOf(VertexId{ root }) };
+			frames[stackSize++] = IdEdgeRange<EdgeIterator>{ root, edges.begin(), edges.end() };
+			while (stackSize > 0)
+			{
+				IdEdgeRange<EdgeIterator>& frame{ frames[stackSize - 1] };
+				std::uint32_t current{ frame.id };
+				if (frame.edge != frame.end)
+				{
+					std::uint32_t target{ (*frame.edge).key.index };
+					++frame.edge;
+					if (indices[target] == UNSET)
+					{
+						indices[target] = lowLinks[target] = nextIndex++;
+						tarjanStack[tarjanSize++] = target;
+						edges = graph.edgesOf(VertexId{ target });
+						frames[stackSize++] = IdEdgeRange<EdgeIterator>{ target, edges.begin(), edges.end() };
+					}
+					else if (components[target] == UNSET && indices[target] < lowLinks[current])
+						lowLinks[current] = indices[target];
+
+					continue;
+				}
+
+				// Every edge is done, so the vertex either roots a component or passes its low link up to its parent
+				--stackSize;
+				if (lowLinks[current] == indices[current])
+				{
+					std::uint32_t member{ 0 };
+					do
+					{
+						member = tarjanStack[--tarjanSize];
+						components[member] = static_cast<std::uint32_t>(numComponents);
+					} while (member != current);
+					++numComponents;
+				}
+				if (stackSize > 0 && lowLinks[current] < lowLinks[frames[stackSize - 1].id])
+					lowLinks[frames[stackSize - 1].id] = lowLinks[current];
+			}
+		}
+
+		// Tarjan's algorithm finishes components in reverse topological order
+		for (std::size_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			if (components[index] != UNSET)
+				components[index] = static_cast<std::uint32_t>(numComponents - 1 - components[index]);
+		}
+		delete[] frames;
+		delete[] tarjanStack;
+		delete[] lowLinks;
+		delete[] indices;
+		return numComponents;
+	}
+
+	// Fills components with the strongly connected component number of every vertex key, numbered so that every edge between two components
+	// goes from the lower number to the higher one. Returns the number of components. Throws std::logic_error if the graph is undirected, since
+	// its strongly connected components would just be its connected components
+	template <typename T, typename U, typename W>
+	std::size_t stronglyConnectedComponents(const Graph<T, U, W>& graph, HashTable<T, std::size_t>& components)
+	{
+		if (!graph.directed())
+			throw std::logic_error("The graph is undirected");
+
+		std::uint32_t* idComponents{ new std::uint32_t[graph.idBound()] };
+		std::size_t numComponents{ stronglyConnectedIds(graph, idComponents) };
+		components.clear();
+		components.reserve(graph.size());
+		for (std::uint32_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			if (graph.contains(VertexId{ index }))
+				components.insert(graph.key(VertexId{ index }), static_cast<std::size_t>(idComponents[index]));
+		}
+		delete[] idComponents;
+		return numComponents;
+	}
+
+	// Returns true if the graph has a cycle, including a self-loop. An undirected edge stored at both of its ends doesn't make a cycle, so an
+	// undirected forest has none
+	template <typename T, typename U, typename W>
+	bool hasCycle(const Graph<T, U, W>& graph)
+	{
+		if (!graph.directed())
+		{
+			// Union-find over each edge once, from its lower end. An edge whose ends are already joined closes a cycle
+			std::uint32_t* parents{ new std::uint32_t[graph.idBound()] };
+			for (std::uint32_t index{ 0 }; index < graph.idBound(); ++index)
+			{
+				parents[index] = index;
+			}
+			bool cycle{ false };
+			for (std::uint32_t index{ 0 }; index < graph.idBound() && !cycle; ++index)
+			{
+				if (!graph.contains(VertexId{ index }))
+					continue;
+
+				for (const auto& [target, weight] : graph.edgesOf(VertexId{ index }))
+				{
+					if (target.index < index)
+						continue;
+
+					std::uint32_t root1{ index };
+					while (parents[root1] != root1)
+					{
+						parents[root1] = parents[parents[root1]];
+						root1 = parents[root1];
+					}
+					std::uint32_t root2{ target.index };
+					while (parents[root2] != root2)
+					{
+						parents[root2] = parents[parents[root2]];
+						root2 = parents[root2];
+					}
+					if (root1 == root2)
+					{
+						cycle = true;
+						break;
+					}
+					parents[root2] = root1;
+				}
+			}
+			delete[] parents;
+			return cycle;
+		}
+
+		std::uint32_t* order{ new std::uint32_t[graph.size()] };
+		std::size_t count{ topologicalIds(graph, order) };
+		delete[] order;
+		return count != graph.size();
+	}
+
+	// Fills components as stronglyConnectedComponents does and returns the acyclic graph of the components. Each component is a vertex keyed by
+	// its number whose value is its number of vertices, and edges between components carry the smallest weight of the edges they replace.
+	// Throws std::logic_error if the graph is undirected
+	template <typename T, typename U, typename W>
+	Graph<std::size_t, std::size_t, W> condensation(const Graph<T, U, W>& graph, HashTable<T, std::size_t>& components)
+	{
+		if (!graph.directed())
+			throw std::logic_error("The graph is undirected");
+
+		std::uint32_t* idComponents{ new std::uint32_t[graph.idBound()] };
+		std::size_t numComponents{ stronglyConnectedIds(graph, idComponents) };
+
+		// Adding the components in order gives each one the VertexId of its number, so the edges can be added by id
+		std::size_t* sizes{ new std::size_t[numComponents]{} };
+		std::size_t numEdges{ 0 };
+		components.clear();
+		components.reserve(graph.size());
+		for (std::uint32_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			if (graph.contains(VertexId{ index }))
+			{
+				components.insert(graph.key(VertexId{ index }), static_cast<std::size_t>(idComponents[index]));
+				++sizes[idComponents[index]];
+				numEdges += graph.getAdjacent(VertexId{ index }).size();
+			}
+		}
+		Graph<std::size_t, std::size_t, W> result;
+		result.reserve(numComponents);
+		for (std::uint32_t component{ 0 }; component < numComponents; ++component)
+		{
+			result.addVertex(static_cast<std::size_t>(component), sizes[component]);
+		}
+		delete[] sizes;
+
+		// Collecting the edges between components in id order, then grouping them by source component with a counting sort
+		GraphEdge<VertexId, W>* crossEdges{ new GraphEdge<VertexId, W>[numEdges] };
+		std::size_t numCross{ 0 };
+		std::size_t* starts{ new std::size_t[numComponents + 1]{} };
+		for (std::uint32_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			if (!graph.contains(VertexId{ index }))
+				continue;
+
+			for (const auto& [target, weight] : graph.edgesOf(VertexId{ index }))
+			{
+				if (idComponents[target.index] != idComponents[index])
+				{
+					crossEdges[numCross++] = GraphEdge<VertexId, W>{ VertexId{ idComponents[index] }, VertexId{ idComponents[target.index] }, weight };
+					++starts[idComponents[index] + 1];
+				}
+			}
+		}
+		delete[] idComponents;
+		for (std::size_t component{ 0 }; component < numComponents; ++component)
+		{
+			starts[component + 1] += starts[component];
+		}
+		GraphEdge<VertexId, W>* edges{ new GraphEdge<VertexId, W>[numCross] };
+		for (std::size_t edge{ 0 }; edge < numCross; ++edge)
+		{
+			edges[starts[crossEdges[edge].from.index]++] = crossEdges[edge];
+		}
+		delete[] crossEdges;
+		delete[] starts;
+
+		// Keeping the lightest of the edges between each pair of components. lastSource marks the components already reached from the current
+		// one and slots remembers where their edge went
+		std::uint32_t* lastSource{ new std::uint32_t[numComponents] };
+		std::size_t* slots{ new std::size_t[numComponents] };
+		for (std::size_t component{ 0 }; component < numComponents; ++component)
+		{
+			lastSource[component] = ~std::uint32_t{ 0 };
+		}
+		std::size_t numCondensed{ 0 };
+		for (std::size_t edge{ 0 }; edge < numCross; ++edge)
+		{
+			std::uint32_t source{ edges[edge].from.index };
+			std::uint32_t target{ edges[edge].to.index };
+			if (lastSource[target] != source)
+			{
+				lastSource[target] = source;
+				slots[target] = numCondensed;
+				edges[numCondensed++] = edges[edge];
+			}
+			else if (edges[edge].weight < edges[slots[target]].weight)
+				edges[slots[target]].weight = edges[edge].weight;
+		}
+		result.addEdges(edges, numCondensed);
+		delete[] slots;
+		delete[] lastSource;
+		delete[] edges;
+		return result;
+	}
+}
+#endif
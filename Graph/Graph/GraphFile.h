@@ -0,0 +1,85 @@
+#ifndef JML_GRAPH_FILE_H
+#define JML_GRAPH_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "CsrGraph.h"
+#include "Graph.h"
+
+namespace JML
+{
+	// Converts keys and values to and from the bytes stored in graph files. Types whose equal values have equal bytes, like integers and
+	// structs of them without padding, are stored as they are, and so are float and double with zero stored as +0. std::string is stored as
+	// its characters. Specialize it for any other key or value type, since keys are found by comparing their bytes
+	template <typename T>
+	struct BinaryCodec
+	{
+		static_assert(std::has_unique_object_representations_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>,
+			"BinaryCodec needs a specialization for types whose equal values can have different bytes, such as structs with padding");
+
+		static std::size_t size(const T& item);
+		static void write(const T& item, char* output);
+		static T read(const char* input, std::size_t size);
+	};
+
+	template <>
+	struct BinaryCodec<std::string>
+	{
+		static std::size_t size(const std::string& item);
+		static void write(const std::string& item, char* output);
+		static std::string read(const char* input, std::size_t size);
+	};
+
+	template <typename T, typename U> void saveGraph(const CsrGraph<T, U>& graph, const char* path);
+	template <typename T, typename U> void saveGraph(const Graph<T, U>& graph, const char* path);
+	template <typename T, typename U> Graph<T, U> loadGraph(const char* path, GraphOptions options = GraphOptions::None);
+
+	// Read-only view of a graph file mapped into memory. Opening checks the header and the offsets and key index of every vertex but not the
+	// edges, so the view is ready without reading them. Ids and edge arrays have the same layout as a CsrGraph, and keys are found by binary
+	// search over a sorted index stored in the file
+	template <typename T, typename U = T>
+	class MappedGraph
+	{
+	public:
+		MappedGraph(const char* path);
+		MappedGraph(const MappedGraph<T, U>& graph) = delete;
+		MappedGraph(MappedGraph<T, U>&& graph) noexcept;  // Move constructor
+		~MappedGraph();
+		MappedGraph<T, U>& operator=(const MappedGraph<T, U>& graph) = delete;
+		MappedGraph<T, U>& operator=(MappedGraph<T, U>&& graph) noexcept;  // Move assignment
+		bool empty() const;
+		std::size_t size() const;
+		std::size_t edgeCount() const;
+		bool contains(const T& key) const;
+		std::uint32_t id(const T& key) const;
+		T key(std::uint32_t id) const;
+		U value(std::uint32_t id) const;
+		std::size_t degree(std::uint32_t id) const;
+		const std::uint64_t* offsetArray() const;
+		const std::uint32_t* targetArray() const;
+		const int* weightArray() const;
+
+	private:
+		const char* data{ nullptr };
+		std::size_t dataSize{ 0 };
+		std::size_t numVerts{ 0 };
+		std::size_t numEdges{ 0 };
+		const std::uint64_t* offsets{ nullptr };
+		const std::uint32_t* targets{ nullptr };
+		const int* weights{ nullptr };
+		const std::uint64_t* keyOffsets{ nullptr };  // Key id is keyBytes[keyOffsets[id]] to keyBytes[keyOffsets[id + 1] - 1]
+		const std::uint64_t* valueOffsets{ nullptr };
+		const std::uint32_t* sortedIds{ nullptr };  // Ids in order of their key bytes
+		const char* keyBytes{ nullptr };
+		const char* valueBytes{ nullptr };
+
+		bool findId(const T& key, std::uint32_t& id) const;
+		void checkId(std::uint32_t id) const;
+		void unmap();
+	};
+}
+#include "GraphFile.hpp"
+#endif
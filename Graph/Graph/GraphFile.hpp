@@ -0,0 +1,559 @@
+#ifndef JML_GRAPH_FILE_HPP
+#define JML_GRAPH_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "CsrGraph.h"
+#include "Graph.h"
+#include "Heap.h"
+
+namespace JML
+{
+	// Fixed-size start of every graph file. The sections laid out by graphFileLayout follow it
+	struct GraphFileHeader
+	{
+		char magic[8]{};
+		std::uint32_t version{};
+		std::uint32_t byteOrder{};  // GRAPHFILE_BYTEORDER as written, so that files from a machine with the other byte order are rejected
+		std::uint64_t numVerts{};
+		std::uint64_t numEdges{};
+		std::uint64_t keySize{};
+		std::uint64_t valueSize{};
+	};
+
+	// Byte positions of the sections of a graph file. Every array starts on an 8 byte boundary so that it can be used in place once mapped
+	struct GraphFileLayout
+	{
+		std::uint64_t offsets{};  // numVerts + 1 edge offsets, as in CsrGraph
+		std::uint64_t targets{};  // numEdges target ids
+		std::uint64_t weights{};  // numEdges weights
+		std::uint64_t keyOffsets{};  // numVerts + 1 offsets into the key bytes
+		std::uint64_t valueOffsets{};  // numVerts + 1 offsets into the value bytes
+		std::uint64_t sortedIds{};  // numVerts ids in order of their key bytes
+		std::uint64_t keyBytes{};
+		std::uint64_t valueBytes{};
+		std::uint64_t total{};
+	};
+
+	constexpr char GRAPHFILE_MAGIC[8]{ 'J', 'M', 'L', 'G', 'R', 'A', 'P', 'H' };
+	constexpr std::uint32_t GRAPHFILE_VERSION{ 1 };
+	constexpr std::uint32_t GRAPHFILE_BYTEORDER{ 0x01020304 };
+
+	inline GraphFileLayout graphFileLayout(const GraphFileHeader& header)
+	{
+		auto align{ [](std::uint64_t position) { return (position + 7) / 8 * 8; } };
+		GraphFileLayout layout;
+		layout.offsets = align(sizeof(GraphFileHeader));
+		layout.targets = align(layout.offsets + (header.numVerts + 1) * sizeof(std::uint64_t));
+		layout.weights = align(layout.targets + header.numEdges * sizeof(std::uint32_t));
+		layout.keyOffsets = align(layout.weights + header.numEdges * sizeof(int));
+		layout.valueOffsets = align(layout.keyOffsets + (header.numVerts + 1) * sizeof(std::uint64_t));
+		layout.sortedIds = align(layout.valueOffsets + (header.numVerts + 1) * sizeof(std::uint64_t));
+		layout.keyBytes = align(layout.sortedIds + header.numVerts * sizeof(std::uint32_t));
+		layout.valueBytes = layout.keyBytes + header.keySize;
+		layout.total = layout.valueBytes + header.valueSize;
+		return layout;
+	}
+
+	// Compares two byte strings like memcmp, with a shorter prefix ordered first
+	inline int compareBytes(const char* bytes1, std::size_t size1, const char* bytes2, std::size_t size2)
+	{
+		int result{ std::memcmp(bytes1, bytes2, size1 < size2 ? size1 : size2) };
+		if (result != 0)
+			return result;
+
+		return size1 < size2 ? -1 : (size1 > size2 ? 1 : 0);
+	}
+
+	// Heap entry for sorting keys by their bytes when writing a graph file
+	struct KeyBytes
+	{
+		const char* bytes{};
+		std::size_t size{};
+		std::uint32_t id{};
+	};
+
+	inline bool lowerKeyBytes(const KeyBytes& key1, const KeyBytes& key2)
+	{
+		return compareBytes(key1.bytes, key1.size, key2.bytes, key2.size) < 0;
+	}
+
+	// Binary codec implementation
+
+	template <typename T>
+	std::size_t BinaryCodec<T>::size(const T&)
+	{
+		return sizeof(T);
+	}
+
+	// Writes the bytes of the item. Negative zero is written as zero so that it's found as the same key
+	template <typename T>
+	void BinaryCodec<T>::write(const T& item, char* output)
+	{
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			T canonical{ item == 0 ? T{ 0 } : item };
+			std::memcpy(output, &canonical, sizeof(T));
+		}
+		else
+		{
+			std::memcpy(output, &item, sizeof(T));
+		}
+	}
+
+	template <typename T>
+	T BinaryCodec<T>::read(const char* input, std::size_t)
+	{
+		T item;
+		std::memcpy(&item, input, sizeof(T));
+		return item;
+	}
+
+	inline std::size_t BinaryCodec<std::string>::size(const std::string& item)
+	{
+		return item.size();
+	}
+
+	inline void BinaryCodec<std::string>::write(const std::string& item, char* output)
+	{
+		std::memcpy(output, item.data(), item.size());
+	}
+
+	inline std::string BinaryCodec<std::string>::read(const char* input, std::size_t size)
+	{
+		return std::string(input, size);
+	}
+
+	// Writes size bytes to the file after padding it with zeros up to start. Position tracks the number of bytes written so far
+	inline void writeSection(std::ofstream& file, std::uint64_t& position, std::uint64_t start, const void* bytes, std::size_t size)
+	{
+		const char zeros[8]{};
+		file.write(zeros, static_cast<std::streamsize>(start - position));
+		file.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+		position = start + size;
+	}
+
+	// Writes the graph to the file at path in the binary graph format: the CSR arrays, the encoded keys and values with their offsets, and a
+	// key index sorted by key bytes. Keys and values are encoded with BinaryCodec. Throws std::runtime_error if the file can't be written
+	template <typename T, typename U>
+	void saveGraph(const CsrGraph<T, U>& graph, const char* path)
+	{
+		std::size_t numVerts{ graph.size() };
+		std::uint64_t* keyOffsets{ new std::uint64_t[numVerts + 1] };
+		std::uint64_t* valueOffsets{ new std::uint64_t[numVerts + 1] };
+		keyOffsets[0] = 0;
+		valueOffsets[0] = 0;
+		for (std::uint32_t id{ 0 }; id < numVerts; ++id)
+		{
+			keyOffsets[id + 1] = keyOffsets[id] + BinaryCodec<T>::size(graph.key(id));
+			valueOffsets[id + 1] = valueOffsets[id] + BinaryCodec<U>::size(graph.value(id));
+		}
+
+		GraphFileHeader header;
+		std::memcpy(header.magic, GRAPHFILE_MAGIC, sizeof(header.magic));
+		header.version = GRAPHFILE_VERSION;
+		header.byteOrder = GRAPHFILE_BYTEORDER;
+		header.numVerts = numVerts;
+		header.numEdges = graph.edgeCount();
+		header.keySize = keyOffsets[numVerts];
+		header.valueSize = valueOffsets[numVerts];
+		char* keyBytes{ new char[header.keySize ? header.keySize : 1] };
+		char* valueBytes{ new char[header.valueSize ? header.valueSize : 1] };
+		Heap<KeyBytes, lowerKeyBytes> sorter{ numVerts ? numVerts : 1 };
+		for (std::uint32_t id{ 0 }; id < numVerts; ++id)
+		{
+			BinaryCodec<T>::write(graph.key(id), keyBytes + keyOffsets[id]);
+			BinaryCodec<U>::write(graph.value(id), valueBytes + valueOffsets[id]);
+			sorter.insert(KeyBytes{ keyBytes + keyOffsets[id], static_cast<std::size_t>(keyOffsets[id + 1] - keyOffsets[id]), id });
+		}
+		std::uint32_t* sortedIds{ new std::uint32_t[numVerts ? numVerts : 1] };
+		for (std::size_t i{ 0 }; i < numVerts; ++i)
+		{
+			sortedIds[i] = sorter.top().id;
+			sorter.pop();
+		}
+
+		// The file stores 64 bit edge offsets whatever the width of std::size_t
+		std::uint64_t* offsets{ new std::uint64_t[numVerts + 1] };
+		for (std::size_t i{ 0 }; i <= numVerts; ++i)
+		{
+			offsets[i] = graph.offsetArray()[i];
+		}
+
+		GraphFileLayout layout{ graphFileLayout(header) };
+		std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+		if (file)
+		{
+			std::uint64_t position{ 0 };
+			writeSection(file, position, 0, &header, sizeof(header));
+			writeSection(file, position, layout.offsets, offsets, (numVerts + 1) * sizeof(std::uint64_t));
+			writeSection(file, position, layout.targets, graph.targetArray(), header.numEdges * sizeof(std::uint32_t));
+			writeSection(file, position, layout.weights, graph.weightArray(), header.numEdges * sizeof(int));
+			writeSection(file, position, layout.keyOffsets, keyOffsets, (numVerts + 1) * sizeof(std::uint64_t));
+			writeSection(file, position, layout.valueOffsets, valueOffsets, (numVerts + 1) * sizeof(std::uint64_t));
+			writeSection(file, position, layout.sortedIds, sortedIds, numVerts * sizeof(std::uint32_t));
+			writeSection(file, position, layout.keyBytes, keyBytes, header.keySize);
+			writeSection(file, position, layout.valueBytes, valueBytes, header.valueSize);
+			file.flush();
+		}
+		bool written{ static_cast<bool>(file) };
+		delete[] offsets;
+		delete[] sortedIds;
+		delete[] valueBytes;
+		delete[] keyBytes;
+		delete[] valueOffsets;
+		delete[] keyOffsets;
+		if (!written)
+			throw std::runtime_error("Could not write the graph file");
+	}
+
+	// Freezes the graph and writes it to the file at path. Ids in the file are the ids of the frozen snapshot
+	template <typename T, typename U>
+	void saveGraph(const Graph<T, U>& graph, const char* path)
+	{
+		saveGraph(graph.freeze(), path);
+	}
+
+	// Reads a graph file back into a mutable graph. The vertex table and every edge table are sized once from the counts in the file, and the
+	// vertices get the ids they have in the file. The options are those of the Graph constructor. A file saved from an undirected graph lists
+	// every edge from both ends, which loads back with GraphOptions::Undirected into the graph as it was. Throws std::runtime_error if the file
+	// can't be read and std::invalid_argument if it isn't a graph file
+	template <typename T, typename U>
+	Graph<T, U> loadGraph(const char* path, GraphOptions options)
+	{
+		MappedGraph<T, U> file{ path };
+		Graph<T, U> graph{ options };
+		graph.reserve(file.size());
+		for (std::uint32_t id{ 0 }; id < file.size(); ++id)
+		{
+			graph.addVertex(file.key(id), file.value(id));
+		}
+
+		GraphEdge<VertexId>* edges{ new GraphEdge<VertexId>[file.edgeCount()] };
+		const std::uint64_t* offsets{ file.offsetArray() };
+		for (std::uint32_t id{ 0 }; id < file.size(); ++id)
+		{
+			for (std::uint64_t edge{ offsets[id] }; edge < offsets[id + 1]; ++edge)
+			{
+				edges[edge] = GraphEdge<VertexId>{ VertexId{ id }, VertexId{ file.targetArray()[edge] }, file.weightArray()[edge] };
+			}
+		}
+		try
+		{
+			graph.addEdges(edges, file.edgeCount());
+		}
+		catch (const std::out_of_range&)
+		{
+			delete[] edges;
+			throw std::invalid_argument("Not a valid graph file");
+		}
+		delete[] edges;
+		return graph;
+	}
+
+	// Mapped graph implementation
+
+	// Maps the graph file at path into memory. Throws std::runtime_error if the file can't be mapped and std::invalid_argument if its header
+	// or section sizes don't match the graph format, an offset array decreases or the key index holds an id past the last vertex
+	template <typename T, typename U>
+	MappedGraph<T, U>::MappedGraph(const char* path)
+	{
+#ifdef _WIN32
+		HANDLE file{ CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+		if (file == INVALID_HANDLE_VALUE)
+			throw std::runtime_error("Could not open the graph file");
+
+		LARGE_INTEGER fileSize{};
+		if (!GetFileSizeEx(file, &fileSize))
+		{
+			CloseHandle(file);
+			throw std::runtime_error("Could not read the size of the graph file");
+		}
+		dataSize = static_cast<std::size_t>(fileSize.QuadPart);
+		if (dataSize)
+		{
+			// The view keeps the mapping and the file open on its own, so both handles can be closed right away
+			HANDLE mapping{ CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+			CloseHandle(file);
+			if (!mapping)
+				throw std::runtime_error("Could not map the graph file");
+
+			data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+			CloseHandle(mapping);
+			if (!data)
+				throw std::runtime_error("Could not map the graph file");
+		}
+		else
+			CloseHandle(file);
+#else
+		int file{ open(path, O_RDONLY) };
+		if (file < 0)
+			throw std::runtime_error("Could not open the graph file");
+
+		struct stat status{};
+		if (fstat(file, &status) != 0)
+		{
+			close(file);
+			throw std::runtime_error("Could not read the size of the graph file");
+		}
+		dataSize = static_cast<std::size_t>(status.st_size);
+		if (dataSize)
+		{
+			// The mapping keeps its own reference to the file, so the descriptor can be closed right away
+			void* mapped{ mmap(nullptr, dataSize, PROT_READ, MAP_PRIVATE, file, 0) };
+			close(file);
+			if (mapped == MAP_FAILED)
+				throw std::runtime_error("Could not map the graph file");
+
+			data = static_cast<const char*>(mapped);
+		}
+		else
+			close(file);
+#endif
+
+		GraphFileHeader header;
+		bool valid{ dataSize >= sizeof(header) };
+		if (valid)
+		{
+			std::memcpy(&header, data, sizeof(header));
+			// Bounding the counts by the file size first so that the layout arithmetic can't overflow
+			valid = std::memcmp(header.magic, GRAPHFILE_MAGIC, sizeof(header.magic)) == 0 && header.version == GRAPHFILE_VERSION
+				&& header.byteOrder == GRAPHFILE_BYTEORDER && header.numVerts < (std::uint64_t{ 1 } << 32) && header.numEdges <= dataSize
+				&& header.keySize <= dataSize && header.valueSize <= dataSize && graphFileLayout(header).total == dataSize;
+		}
+		if (valid)
+		{
+			GraphFileLayout layout{ graphFileLayout(header) };
+			numVerts = static_cast<std::size_t>(header.numVerts);
+			numEdges = static_cast<std::size_t>(header.numEdges);
+			offsets = reinterpret_cast<const std::uint64_t*>(data + layout.offsets);
+			targets = reinterpret_cast<const std::uint32_t*>(data + layout.targets);
+			weights = reinterpret_cast<const int*>(data + layout.weights);
+			keyOffsets = reinterpret_cast<const std::uint64_t*>(data + layout.keyOffsets);
+			valueOffsets = reinterpret_cast<const std::uint64_t*>(data + layout.valueOffsets);
+			sortedIds = reinterpret_cast<const std::uint32_t*>(data + layout.sortedIds);
+			keyBytes = data + layout.keyBytes;
+			valueBytes = data + layout.valueBytes;
+			valid = offsets[0] == 0 && offsets[numVerts] == numEdges && keyOffsets[0] == 0 && keyOffsets[numVerts] == header.keySize
+				&& valueOffsets[0] == 0 && valueOffsets[numVerts] == header.valueSize;
+			// With the ends checked, offsets that never decrease keep every edge range, key and value inside its section
+			for (std::size_t id{ 0 }; valid && id < numVerts; ++id)
+			{
+				valid = offsets[id] <= offsets[id + 1] && keyOffsets[id] <= keyOffsets[id + 1] && valueOffsets[id] <= valueOffsets[id + 1]
+					&& sortedIds[id] < numVerts;
+			}
+		}
+		if (!valid)
+		{
+			unmap();
+			throw std::invalid_argument("Not a valid graph file");
+		}
+	}
+
+	// Move constructor
+	template <typename T, typename U>
+	MappedGraph<T, U>::MappedGraph(MappedGraph<T, U>&& graph) noexcept :
+		data{ graph.data }, dataSize{ graph.dataSize }, numVerts{ graph.numVerts }, numEdges{ graph.numEdges }, offsets{ graph.offsets },
+		targets{ graph.targets }, weights{ graph.weights }, keyOffsets{ graph.keyOffsets }, valueOffsets{ graph.valueOffsets },
+		sortedIds{ graph.sortedIds }, keyBytes{ graph.keyBytes }, valueBytes{ graph.valueBytes }
+	{
+		graph.data = nullptr;
+		graph.dataSize = 0;
+		graph.numVerts = 0;
+		graph.numEdges = 0;
+	}
+
+	template <typename T, typename U>
+	MappedGraph<T, U>::~MappedGraph()
+	{
+		unmap();
+	}
+
+	// Move assignment
+	template <typename T, typename U>
+	MappedGraph<T, U>& MappedGraph<T, U>::operator=(MappedGraph<T, U>&& graph) noexcept
+	{
+		if (&graph == this)
+			return *this;
+
+		unmap();
+		data = graph.data;
+		dataSize = graph.dataSize;
+		numVerts = graph.numVerts;
+		numEdges = graph.numEdges;
+		offsets = graph.offsets;
+		targets = graph.targets;
+		weights = graph.weights;
+		keyOffsets = graph.keyOffsets;
+		valueOffsets = graph.valueOffsets;
+		sortedIds = graph.sortedIds;
+		keyBytes = graph.keyBytes;
+		valueBytes = graph.valueBytes;
+		graph.data = nullptr;
+		graph.dataSize = 0;
+		graph.numVerts = 0;
+		graph.numEdges = 0;
+		return *this;
+	}
+
+	// Returns true if the graph has no vertices
+	template <typename T, typename U>
+	bool MappedGraph<T, U>::empty() const
+	{
+		return numVerts == 0;
+	}
+
+	// Returns the number of vertices in the graph
+	template <typename T, typename U>
+	std::size_t MappedGraph<T, U>::size() const
+	{
+		return numVerts;
+	}
+
+	// Returns the number of edges in the graph
+	template <typename T, typename U>
+	std::size_t MappedGraph<T, U>::edgeCount() const
+	{
+		return numEdges;
+	}
+
+	// Returns true if the graph contains a vertex with the given key
+	template <typename T, typename U>
+	bool MappedGraph<T, U>::contains(const T& key) const
+	{
+		std::uint32_t id{ 0 };
+		return findId(key, id);
+	}
+
+	// Returns the id of the vertex with the given key. Takes time logarithmic in the number of vertices. Throws std::invalid_argument if no
+	// vertex with the given key exists
+	template <typename T, typename U>
+	std::uint32_t MappedGraph<T, U>::id(const T& key) const
+	{
+		std::uint32_t id{ 0 };
+		if (findId(key, id))
+			return id;
+
+		throw std::invalid_argument("Not a valid vertex key");
+	}
+
+	// Returns a decoded copy of the key of the vertex with the given id. Throws std::out_of_range if the id is invalid
+	template <typename T, typename U>
+	T MappedGraph<T, U>::key(std::uint32_t id) const
+	{
+		checkId(id);
+		return BinaryCodec<T>::read(keyBytes + keyOffsets[id], static_cast<std::size_t>(keyOffsets[id + 1] - keyOffsets[id]));
+	}
+
+	// Returns a decoded copy of the value of the vertex with the given id. Throws std::out_of_range if the id is invalid
+	template <typename T, typename U>
+	U MappedGraph<T, U>::value(std::uint32_t id) const
+	{
+		checkId(id);
+		return BinaryCodec<U>::read(valueBytes + valueOffsets[id], static_cast<std::size_t>(valueOffsets[id + 1] - valueOffsets[id]));
+	}
+
+	// Returns the number of outgoing edges of the vertex with the given id. Throws std::out_of_range if the id is invalid
+	template <typename T, typename U>
+	std::size_t MappedGraph<T, U>::degree(std::uint32_t id) const
+	{
+		checkId(id);
+		return static_cast<std::size_t>(offsets[id + 1] - offsets[id]);
+	}
+
+	// Returns the size() + 1 edge offsets. The edges of vertex id are at offsets[id] to offsets[id + 1] - 1 in the target and weight arrays
+	template <typename T, typename U>
+	const std::uint64_t* MappedGraph<T, U>::offsetArray() const
+	{
+		return offsets;
+	}
+
+	// Returns the edgeCount() target ids
+	template <typename T, typename U>
+	const std::uint32_t* MappedGraph<T, U>::targetArray() const
+	{
+		return targets;
+	}
+
+	// Returns the edgeCount() edge weights
+	template <typename T, typename U>
+	const int* MappedGraph<T, U>::weightArray() const
+	{
+		return weights;
+	}
+
+	// Binary searches the sorted key index for the encoded key. Returns false if it isn't there
+	template <typename T, typename U>
+	bool MappedGraph<T, U>::findId(const T& key, std::uint32_t& id) const
+	{
+		std::size_t size{ BinaryCodec<T>::size(key) };
+		char* encoded{ new char[size ? size : 1] };
+		BinaryCodec<T>::write(key, encoded);
+		std::size_t low{ 0 };
+		std::size_t high{ numVerts };
+		bool found{ false };
+		while (low < high && !found)
+		{
+			std::size_t middle{ low + (high - low) / 2 };
+			std::uint32_t candidate{ sortedIds[middle] };
+			int order{ compareBytes(keyBytes + keyOffsets[candidate], static_cast<std::size_t>(keyOffsets[candidate + 1] - keyOffsets[candidate]),
+				encoded, size) };
+			if (order < 0)
+				low = middle + 1;
+			else if (order > 0)
+				high = middle;
+			else
+			{
+				id = candidate;
+				found = true;
+			}
+		}
+		delete[] encoded;
+		return found;
+	}
+
+	// Throws std::out_of_range if the given id doesn't belong to a vertex
+	template <typename T, typename U>
+	void MappedGraph<T, U>::checkId(std::uint32_t id) const
+	{
+		if (id >= numVerts)
+			throw std::out_of_range("Not a valid vertex id");
+	}
+
+	// Releases the mapping, if there is one
+	template <typename T, typename U>
+	void MappedGraph<T, U>::unmap()
+	{
+		if (data)
+		{
+#ifdef _WIN32
+			UnmapViewOfFile(data);
+#else
+			munmap(const_cast<char*>(data), dataSize);
+#endif
+			data = nullptr;
+		}
+	}
+}
+#endif
@@ -0,0 +1,24 @@
+#ifndef JML_PARALLEL_GRAPH_H
+#define JML_PARALLEL_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "CsrGraph.h"
+#include "Graph.h"
+#include "HashTable.h"
+#include "ThreadPool.h"
+
+namespace JML
+{
+	constexpr std::uint32_t UNVISITED{ ~std::uint32_t{ 0 } };  // Level reported for vertices that can't be reached from the source
+
+	template <typename T, typename U, typename W>
+	std::size_t parallelBfs(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, std::uint32_t source, std::uint32_t* levels, ThreadPool& pool);
+	template <typename T, typename U>
+	void deltaStepping(const CsrGraph<T, U>& graph, std::uint32_t source, long long* distances, ThreadPool& pool, long long delta = 0);
+	template <typename T, typename U>
+	HashTable<T, long long> deltaStepping(const Graph<T, U>& graph, const T& source, ThreadPool& pool, long long delta = 0);
+}
+#include "ParallelGraph.hpp"
+#endif
@@ -0,0 +1,387 @@
+#ifndef JML_PARALLEL_GRAPH_HPP
+#define JML_PARALLEL_GRAPH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "CsrGraph.h"
+#include "Graph.h"
+#include "HashTable.h"
+#include "Stack.h"
+#include "ThreadPool.h"
+
+namespace JML
+{
+	// Direction-optimizing breadth-first search (Beamer et al.). Writes the level of every vertex into levels (graph.size() entries), or
+	// UNVISITED. Transposed must be graph.transpose(), which the bottom-up steps use to look at incoming edges. Returns the number of vertices
+	// reached. Throws std::out_of_range if the source id is invalid
+	template <typename T, typename U, typename W>
+	std::size_t parallelBfs(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, std::uint32_t source, std::uint32_t* levels, ThreadPool& pool)
+	{
+		// Switching to bottom-up once the frontier's edges exceed 1/ALPHA of the unexplored edges, and back to top-down once the frontier
+		// holds fewer than 1/BETA of the vertices
+		constexpr std::size_t ALPHA{ 14 };
+		constexpr std::size_t BETA{ 24 };
+		constexpr std::size_t BUFFERSIZE{ 256 };
+
+		std::size_t numVerts{ graph.size() };
+		if (source >= numVerts)
+			throw std::out_of_range("Not a valid vertex id");
+
+		const std::size_t* offsets{ graph.offsetArray() };
+		const std::uint32_t* targets{ graph.targetArray() };
+		const std::size_t* inOffsets{ transposed.offsetArray() };
+		const std::uint32_t* inTargets{ transposed.targetArray() };
+		std::size_t numWords{ (numVerts + 63) / 64 };
+		std::atomic<std::uint64_t>* visited{ new std::atomic<std::uint64_t>[numWords] };
+		std::uint64_t* frontierBits{ new std::uint64_t[numWords] };
+		std::uint64_t* nextBits{ new std::uint64_t[numWords] };
+		std::uint32_t* frontier{ new std::uint32_t[numVerts] };
+		std::uint32_t* next{ new std::uint32_t[numVerts] };
+		pool.parallelFor(0, numWords, [&](std::size_t begin, std::size_t end, std::size_t)
+			{
+				for (std::size_t word{ begin }; word < end; ++word)
+				{
+					visited[word].store(0, std::memory_order_relaxed);
+				}
+			});
+		pool.parallelFor(0, numVerts, [&](std::size_t begin, std::size_t end, std::size_t)
+			{
+				for (std::size_t id{ begin }; id < end; ++id)
+				{
+					levels[id] = UNVISITED;
+				}
+			});
+
+		levels[source] = 0;
+		visited[source / 64].store(std::uint64_t{ 1 } << (source % 64), std::memory_order_relaxed);
+		frontier[0] = source;
+		std::size_t frontierSize{ 1 };
+		std::size_t frontierEdges{ offsets[source + 1] - offsets[source] };
+		std::size_t unexploredEdges{ graph.edgeCount() };
+		std::size_t reached{ 1 };
+		std::uint32_t depth{ 0 };
+		bool bottomUp{ false };
+		std::atomic<std::size_t> nextSize{ 0 };
+		std::atomic<std::size_t> nextEdges{ 0 };
+		while (frontierSize > 0)
+		{
+			// Changing direction means changing how the frontier is stored. Both forms are rebuilt from the levels of the current depth
+			if (!bottomUp && frontierEdges > unexploredEdges / ALPHA)
+			{
+				bottomUp = true;
+				pool.parallelFor(0, numWords, [&](std::size_t begin, std::size_t end, std::size_t)
+					{
+						for (std::size_t word{ begin }; word < end; ++word)
+						{
+							std::uint64_t bits{ 0 };
+							for (std::size_t id{ word * 64 }; id < numVerts && id < word * 64 + 64; ++id)
+							{
+								if (levels[id] == depth)
+									bits |= std::uint64_t{ 1 } << (id % 64);
+							}
+							frontierBits[word] = bits;
+						}
+					});
+			}
+			else if (bottomUp && frontierSize < numVerts / BETA)
+			{
+				bottomUp = false;
+				nextSize.store(0, std::memory_order_relaxed);
+				pool.parallelFor(0, numVerts, [&](std::size_t begin, std::size_t end, std::size_t)
+					{
+						for (std::size_t id{ begin }; id < end; ++id)
+						{
+							if (levels[id] == depth)
+								frontier[nextSize.fetch_add(1, std::memory_order_relaxed)] = static_cast<std::uint32_t>(id);
+						}
+					});
+			}
+
+			unexploredEdges -= frontierEdges < unexploredEdges ? frontierEdges : unexploredEdges;
+			nextSize.store(0, std::memory_order_relaxed);
+			nextEdges.store(0, std::memory_order_relaxed);
+			if (bottomUp)
+			{
+				// Every unvisited vertex looks for a parent in the frontier. Chunks are whole bitmap words, so each word has a single writer
+				pool.parallelFor(0, numWords, [&](std::size_t begin, std::size_t end, std::size_t)
+					{
+						std::size_t found{ 0 };
+						std::size_t foundEdges{ 0 };
+						for (std::size_t word{ begin }; word < end; ++word)
+						{
+							std::uint64_t seen{ visited[word].load(std::memory_order_relaxed) };
+							std::uint64_t bits{ 0 };
+							for (std::size_t id{ word * 64 }; id < numVerts && id < word * 64 + 64; ++id)
+							{
+								std::uint64_t bit{ std::uint64_t{ 1 } << (id % 64) };
+								if (seen & bit)
+									continue;
+
+								for (std::size_t edge{ inOffsets[id] }; edge < inOffsets[id + 1]; ++edge)
+								{
+									std::uint32_t parent{ inTargets[edge] };
+									if (frontierBits[parent / 64] & (std::uint64_t{ 1 } << (parent % 64)))
+									{
+										levels[id] = depth + 1;
+										bits |= bit;
+										++found;
+										foundEdges += offsets[id + 1] - offsets[id];
+										break;
+									}
+								}
+							}
+							visited[word].store(seen | bits, std::memory_order_relaxed);
+							nextBits[word] = bits;
+						}
+						nextSize.fetch_add(found, std::memory_order_relaxed);
+						nextEdges.fetch_add(foundEdges, std::memory_order_relaxed);
+					});
+				std::uint64_t* temp{ frontierBits };
+				frontierBits = nextBits;
+				nextBits = temp;
+			}
+			else
+			{
+				// Every frontier vertex claims its unvisited neighbors, buffering them locally to limit contention on the shared tail
+				pool.parallelFor(0, frontierSize, [&](std::size_t begin, std::size_t end, std::size_t)
+					{
+						std::uint32_t buffer[BUFFERSIZE];
+						std::size_t buffered{ 0 };
+						std::size_t foundEdges{ 0 };
+						for (std::size_t i{ begin }; i < end; ++i)
+						{
+							std::uint32_t current{ frontier[i] };
+							for (std::size_t edge{ offsets[current] }; edge < offsets[current + 1]; ++edge)
+							{
+								std::uint32_t target{ targets[edge] };
+								std::uint64_t bit{ std::uint64_t{ 1 } << (target % 64) };
+								if (visited[target / 64].load(std::memory_order_relaxed) & bit)
+									continue;
+
+								if (visited[target / 64].fetch_or(bit, std::memory_order_relaxed) & bit)
+									continue;
+
+								levels[target] = depth + 1;
+								foundEdges += offsets[target + 1] - offsets[target];
+								buffer[buffered++] = target;
+								if (buffered == BUFFERSIZE)
+								{
+									std::size_t position{ nextSize.fetch_add(buffered, std::memory_order_relaxed) };
+									for (std::size_t j{ 0 }; j < buffered; ++j)
+									{
+										next[position + j] = buffer[j];
+									}
+									buffered = 0;
+								}
+							}
+						}
+						std::size_t position{ nextSize.fetch_add(buffered, std::memory_order_relaxed) };
+						for (std::size_t j{ 0 }; j < buffered; ++j)
+						{
+							next[position + j] = buffer[j];
+						}
+						nextEdges.fetch_add(foundEdges, std::memory_order_relaxed);
+					});
+				std::uint32_t* temp{ frontier };
+				frontier = next;
+				next = temp;
+			}
+			frontierSize = nextSize.load(std::memory_order_relaxed);
+			frontierEdges = nextEdges.load(std::memory_order_relaxed);
+			reached += frontierSize;
+			++depth;
+		}
+
+		delete[] next;
+		delete[] frontier;
+		delete[] nextBits;
+		delete[] frontierBits;
+		delete[] visited;
+		return reached;
+	}
+
+	// Parallel delta-stepping shortest paths (Meyer and Sanders). Vertices are settled bucket by bucket, where bucket i holds tentative
+	// distances in [i * delta, (i + 1) * delta), and every vertex of the current bucket is relaxed in parallel. Writes the same distances as
+	// CsrGraph::dijkstra into distances (graph.size() entries), with UNREACHABLE for unreachable vertices. A delta of 0 or less picks the
+	// largest weight divided by the average degree. Throws std::out_of_range if the source id is invalid and std::invalid_argument if an
+	// edge weight is negative
+	template <typename T, typename U>
+	void deltaStepping(const CsrGraph<T, U>& graph, std::uint32_t source, long long* distances, ThreadPool& pool, long long delta)
+	{
+		constexpr long long INFINITE{ std::numeric_limits<long long>::max() };
+
+		std::size_t numVerts{ graph.size() };
+		if (source >= numVerts)
+			throw std::out_of_range("Not a valid vertex id");
+
+		const std::size_t* offsets{ graph.offsetArray() };
+		const std::uint32_t* targets{ graph.targetArray() };
+		const int* weights{ graph.weightArray() };
+		std::size_t numThreads{ pool.threadCount() };
+		int* maxWeights{ new int[numThreads]{} };
+		std::atomic<bool> negative{ false };
+		pool.parallelFor(0, graph.edgeCount(), [&](std::size_t begin, std::size_t end, std::size_t thread)
+			{
+				for (std::size_t edge{ begin }; edge < end; ++edge)
+				{
+					if (weights[edge] < 0)
+						negative.store(true, std::memory_order_relaxed);
+					else if (weights[edge] > maxWeights[thread])
+						maxWeights[thread] = weights[edge];
+				}
+			});
+		long long maxWeight{ 0 };
+		for (std::size_t thread{ 0 }; thread < numThreads; ++thread)
+		{
+			if (maxWeights[thread] > maxWeight)
+				maxWeight = maxWeights[thread];
+		}
+		delete[] maxWeights;
+		if (negative.load(std::memory_order_relaxed))
+			throw std::invalid_argument("Edge weights must not be negative");
+
+		if (delta <= 0)
+		{
+			std::size_t averageDegree{ graph.edgeCount() / numVerts };
+			delta = maxWeight / static_cast<long long>(averageDegree ? averageDegree : 1);
+			if (delta <= 0)
+				delta = 1;
+		}
+
+		// A relaxation out of bucket i lands at most maxWeight / delta + 1 buckets later, so each thread keeps its pending vertices in a ring
+		// of buckets that never wraps onto a live one
+		std::size_t ringSize{ static_cast<std::size_t>(maxWeight / delta) + 2 };
+		Stack<std::uint32_t>* buckets{ new Stack<std::uint32_t>[numThreads * ringSize] };
+		std::size_t* gatherOffsets{ new std::size_t[numThreads + 1] };
+		std::atomic<long long>* tentative{ new std::atomic<long long>[numVerts] };
+		pool.parallelFor(0, numVerts, [&](std::size_t begin, std::size_t end, std::size_t)
+			{
+				for (std::size_t id{ begin }; id < end; ++id)
+				{
+					tentative[id].store(INFINITE, std::memory_order_relaxed);
+				}
+			});
+
+		// The frontier can hold a vertex more than once if it improved several times, so it grows as needed
+		std::size_t frontierCapacity{ numVerts };
+		std::uint32_t* frontier{ new std::uint32_t[frontierCapacity] };
+		std::size_t frontierSize{ 1 };
+		frontier[0] = source;
+		tentative[source].store(0, std::memory_order_relaxed);
+		std::size_t bucket{ 0 };
+		while (true)
+		{
+			long long bucketStart{ static_cast<long long>(bucket) * delta };
+			pool.parallelFor(0, frontierSize, [&](std::size_t begin, std::size_t end, std::size_t thread)
+				{
+					Stack<std::uint32_t>* ring{ buckets + thread * ringSize };
+					for (std::size_t i{ begin }; i < end; ++i)
+					{
+						std::uint32_t current{ frontier[i] };
+						long long distance{ tentative[current].load(std::memory_order_relaxed) };
+						// Skipping vertices already settled in an earlier bucket
+						if (distance < bucketStart)
+							continue;
+
+						for (std::size_t edge{ offsets[current] }; edge < offsets[current + 1]; ++edge)
+						{
+							std::uint32_t target{ targets[edge] };
+							long long newDistance{ distance + weights[edge] };
+							long long oldDistance{ tentative[target].load(std::memory_order_relaxed) };
+							while (newDistance < oldDistance)
+							{
+								if (tentative[target].compare_exchange_weak(oldDistance, newDistance, std::memory_order_relaxed))
+								{
+									ring[static_cast<std::size_t>(newDistance / delta) % ringSize].push(target);
+									break;
+								}
+							}
+						}
+					}
+				});
+
+			// Moving on to the lowest bucket any thread still has vertices in. Relaxations never lower a distance below the current bucket,
+			// so it's the only one that can refill
+			std::size_t step{ 0 };
+			for (; step < ringSize; ++step)
+			{
+				std::size_t slot{ (bucket + step) % ringSize };
+				std::size_t thread{ 0 };
+				while (thread < numThreads && buckets[thread * ringSize + slot].empty())
+				{
+					++thread;
+				}
+				if (thread < numThreads)
+					break;
+			}
+			if (step == ringSize)
+				break;
+
+			bucket += step;
+			std::size_t slot{ bucket % ringSize };
+			gatherOffsets[0] = 0;
+			for (std::size_t thread{ 0 }; thread < numThreads; ++thread)
+			{
+				gatherOffsets[thread + 1] = gatherOffsets[thread] + buckets[thread * ringSize + slot].size();
+			}
+			frontierSize = gatherOffsets[numThreads];
+			if (frontierSize > frontierCapacity)
+			{
+				delete[] frontier;
+				while (frontierCapacity < frontierSize)
+				{
+					frontierCapacity *= 2;
+				}
+				frontier = new std::uint32_t[frontierCapacity];
+			}
+			pool.parallelFor(0, numThreads, [&](std::size_t begin, std::size_t end, std::size_t)
+				{
+					for (std::size_t thread{ begin }; thread < end; ++thread)
+					{
+						Stack<std::uint32_t>& pending{ buckets[thread * ringSize + slot] };
+						for (std::size_t i{ gatherOffsets[thread] }; !pending.empty(); ++i)
+						{
+							frontier[i] = pending.top();
+							pending.pop();
+						}
+					}
+				});
+		}
+
+		pool.parallelFor(0, numVerts, [&](std::size_t begin, std::size_t end, std::size_t)
+			{
+				for (std::size_t id{ begin }; id < end; ++id)
+				{
+					long long distance{ tentative[id].load(std::memory_order_relaxed) };
+					distances[id] = distance == INFINITE ? CsrGraph<T, U>::UNREACHABLE : distance;
+				}
+			});
+		delete[] frontier;
+		delete[] tentative;
+		delete[] gatherOffsets;
+		delete[] buckets;
+	}
+
+	// Returns a table of shortest path distances from source to every reachable vertex, computed with parallel delta-stepping over a frozen
+	// copy of the graph. Throws std::invalid_argument if no vertex with the source key exists or an edge weight is negative
+	template <typename T, typename U>
+	HashTable<T, long long> deltaStepping(const Graph<T, U>& graph, const T& source, ThreadPool& pool, long long delta)
+	{
+		CsrGraph<T, U> frozen{ graph.freeze() };
+		long long* distances{ new long long[frozen.size()] };
+		deltaStepping(frozen, frozen.id(source), distances, pool, delta);
+		HashTable<T, long long> result{ frozen.size() ? frozen.size() : 1 };
+		for (std::uint32_t id{ 0 }; id < frozen.size(); ++id)
+		{
+			if (distances[id] != CsrGraph<T, U>::UNREACHABLE)
+				result.insert(frozen.key(id), distances[id]);
+		}
+		delete[] distances;
+		return result;
+	}
+}
+#endif
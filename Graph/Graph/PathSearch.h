@@ -0,0 +1,62 @@
+#ifndef JML_PATH_SEARCH_H
+#define JML_PATH_SEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Graph.h"
+#include "IndexedHeap.h"
+
+namespace JML
+{
+	// Point-to-point shortest path queries over a Graph, by bidirectional Dijkstra or by A* with a caller-supplied heuristic. Both stop as soon
+	// as the shortest path is known instead of settling everything closer than the target. The search state grows with the graph's ids and
+	// every entry is stamped with the query that wrote it instead of being cleared, so repeated queries don't allocate and only touch the
+	// vertices they reach. Queries only read the graph, so threads can search the same unchanging graph at once with a PathSearch each.
+	// Edge weights must not be negative
+	template <typename T, typename U = T, typename W = int>
+	class PathSearch
+	{
+	public:
+		using Distance = typename EdgeWeight<W>::Distance;
+
+		static constexpr Distance UNREACHABLE{ -1 };  // Distance returned when the target can't be reached from the source
+
+		PathSearch() = default;
+		PathSearch(const PathSearch<T, U, W>& search) = delete;
+		PathSearch(PathSearch<T, U, W>&& search) = delete;
+		~PathSearch();
+		PathSearch<T, U, W>& operator=(const PathSearch<T, U, W>& search) = delete;
+		PathSearch<T, U, W>& operator=(PathSearch<T, U, W>&& search) = delete;
+		Distance shortestPath(const Graph<T, U, W>& graph, const T& source, const T& target);
+		Distance shortestPath(const Graph<T, U, W>& graph, VertexId source, VertexId target);
+		template <typename H> Distance shortestPath(const Graph<T, U, W>& graph, const T& source, const T& target, H&& heuristic);
+		template <typename H> Distance shortestPath(const Graph<T, U, W>& graph, VertexId source, VertexId target, H&& heuristic);
+		const VertexId* path() const;
+		std::size_t pathSize() const;
+		std::size_t lastSettledCount() const;
+
+	private:
+		static constexpr std::uint32_t NO_PARENT{ ~std::uint32_t{ 0 } };
+
+		std::size_t capacity{ 0 };
+		std::uint32_t query{ 0 };  // Stamp of the current query
+		// Indexed by direction first, with 0 searching forward from the source and 1 backward from the target, and then by VertexId::index.
+		// A* only searches forward
+		std::uint32_t* stamps[2]{};  // Query that last reached every vertex. Entries with other stamps are stale
+		Distance* distances[2]{};
+		std::uint32_t* parents[2]{};  // Previous vertex on the path from the start of the direction, or NO_PARENT
+		IndexedHeap<Distance, shorterDistance<Distance>> queues[2]{};
+		VertexId* pathIds{ nullptr };
+		std::size_t pathLength{ 0 };
+		std::size_t settled{ 0 };
+
+		void begin(const Graph<T, U, W>& graph, VertexId source, VertexId target);
+		void grow(std::size_t newCapacity);
+		bool reached(int direction, std::uint32_t id) const;
+		void reach(int direction, std::uint32_t id, Distance distance, std::uint32_t parent);
+		Distance finish(std::uint32_t meeting, Distance length);
+	};
+}
+#include "PathSearch.hpp"
+#endif
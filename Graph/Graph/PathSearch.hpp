@@ -0,0 +1,241 @@
+#ifndef JML_PATH_SEARCH_HPP
+#define JML_PATH_SEARCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "Graph.h"
+#include "IndexedHeap.h"
+
+namespace JML
+{
+	template <typename T, typename U, typename W>
+	PathSearch<T, U, W>::~PathSearch()
+	{
+		for (int direction{ 0 }; direction < 2; ++direction)
+		{
+			delete[] stamps[direction];
+			delete[] distances[direction];
+			delete[] parents[direction];
+		}
+		delete[] pathIds;
+	}
+
+	// Returns the shortest path distance between the vertices with the given keys, or UNREACHABLE, by bidirectional Dijkstra. Throws
+	// std::invalid_argument if no vertex exists for one or both of the keys or an edge weight on the way is negative, and std::logic_error if
+	// the graph doesn't track incoming edges
+	template <typename T, typename U, typename W>
+	typename PathSearch<T, U, W>::Distance PathSearch<T, U, W>::shortestPath(const Graph<T, U, W>& graph, const T& source, const T& target)
+	{
+		return shortestPath(graph, graph.id(source), graph.id(target));
+	}
+
+	// Returns the shortest path distance between the given vertices, or UNREACHABLE, by bidirectional Dijkstra: one search runs forward from
+	// the source and one backward over incoming edges from the target, each step advancing whichever has the smaller frontier. Every edge that
+	// reaches a vertex the other search has reached offers a path, and the search stops once the two frontiers together are no shorter than
+	// the best one. Throws std::out_of_range if either id doesn't belong to a vertex in the graph, std::invalid_argument if an edge weight on
+	// the way is negative and std::logic_error if the graph doesn't track incoming edges
+	template <typename T, typename U, typename W>
+	typename PathSearch<T, U, W>::Distance PathSearch<T, U, W>::shortestPath(const Graph<T, U, W>& graph, VertexId source, VertexId target)
+	{
+		if (!graph.tracksIncoming())
+			throw std::logic_error("The graph doesn't track incoming edges");
+
+		begin(graph, source, target);
+		if (source == target)
+			return finish(source.index, 0);
+
+		queues[0].insert(source.index, Distance{ 0 });
+		queues[1].insert(target.index, Distance{ 0 });
+		Distance best{ UNREACHABLE };
+		std::uint32_t meeting{ NO_PARENT };
+		while (!queues[0].empty() && !queues[1].empty())
+		{
+			if (best != UNREACHABLE && queues[0].top() + queues[1].top() >= best)
+				break;
+
+			int direction{ queues[0].size() <= queues[1].size() ? 0 : 1 };
+			std::uint32_t id{ static_cast<std::uint32_t>(queues[direction].topIndex()) };
+			queues[direction].pop();
+			++settled;
+			for (const auto& [next, weight] : direction == 0 ? graph.edgesOf(VertexId{ id }) : graph.getIncoming(VertexId{ id }).pairs())
+			{
+				Distance length{ EdgeWeight<W>::length(weight) };
+				if (length < 0)
+					throw std::invalid_argument("Edge weights must not be negative");
+
+				Distance candidate{ distances[direction][id] + length };
+				if (!reached(direction, next.index) || candidate < distances[direction][next.index])
+				{
+					reach(direction, next.index, candidate, id);
+					queues[direction].insert(next.index, candidate);
+				}
+				if (reached(1 - direction, next.index))
+				{
+					Distance total{ distances[0][next.index] + distances[1][next.index] };
+					if (best == UNREACHABLE || total < best)
+					{
+						best = total;
+						meeting = next.index;
+					}
+				}
+			}
+		}
+		return best == UNREACHABLE ? best : finish(meeting, best);
+	}
+
+	// Returns the shortest path distance between the vertices with the given keys, or UNREACHABLE, by A*. Throws std::invalid_argument if no
+	// vertex exists for one or both of the keys or an edge weight on the way is negative
+	template <typename T, typename U, typename W>
+	template <typename H> typename PathSearch<T, U, W>::Distance PathSearch<T, U, W>::shortestPath(const Graph<T, U, W>& graph, const T& source,
+		const T& target, H&& heuristic)
+	{
+		return shortestPath(graph, graph.id(source), graph.id(target), heuristic);
+	}
+
+	// Returns the shortest path distance between the given vertices, or UNREACHABLE, by A*: vertices are settled in order of their distance
+	// from the source plus heuristic(key), an estimate of the distance left to the target, and the search stops when the target is settled.
+	// The estimate must never exceed the real distance for the result to be the shortest. Vertices reached again by a shorter path after
+	// being settled are queued again, so estimates that are only admissible and not consistent work too, at the cost of the extra visits.
+	// Throws std::out_of_range if either id doesn't belong to a vertex in the graph and std::invalid_argument if an edge weight on the way is
+	// negative
+	template <typename T, typename U, typename W>
+	template <typename H> typename PathSearch<T, U, W>::Distance PathSearch<T, U, W>::shortestPath(const Graph<T, U, W>& graph, VertexId source,
+		VertexId target, H&& heuristic)
+	{
+		begin(graph, source, target);
+		queues[0].insert(source.index, static_cast<Distance>(heuristic(graph.key(source))));
+		while (!queues[0].empty())
+		{
+			std::uint32_t id{ static_cast<std::uint32_t>(queues[0].topIndex()) };
+			queues[0].pop();
+			++settled;
+			if (id == target.index)
+				return finish(id, distances[0][id]);
+
+			for (const auto& [next, weight] : graph.edgesOf(VertexId{ id }))
+			{
+				Distance length{ EdgeWeight<W>::length(weight) };
+				if (length < 0)
+					throw std::invalid_argument("Edge weights must not be negative");
+
+				Distance candidate{ distances[0][id] + length };
+				if (!reached(0, next.index) || candidate < distances[0][next.index])
+				{
+					reach(0, next.index, candidate, id);
+					queues[0].insert(next.index, candidate + static_cast<Distance>(heuristic(graph.key(next))));
+				}
+			}
+		}
+		return UNREACHABLE;
+	}
+
+	// Returns the vertices of the path found by the last query, from the source to the target. Only valid until the next query
+	template <typename T, typename U, typename W>
+	const VertexId* PathSearch<T, U, W>::path() const
+	{
+		return pathIds;
+	}
+
+	// Returns the number of vertices on the path found by the last query, or 0 if the target couldn't be reached
+	template <typename T, typename U, typename W>
+	std::size_t PathSearch<T, U, W>::pathSize() const
+	{
+		return pathLength;
+	}
+
+	// Returns the number of vertices the last query took off its queues, a measure of how much of the graph it explored
+	template <typename T, typename U, typename W>
+	std::size_t PathSearch<T, U, W>::lastSettledCount() const
+	{
+		return settled;
+	}
+
+	// Starts a new query: checks the ids, makes room for every id of the graph, empties the queues left by a query that threw and reaches the
+	// source and the target from their own directions. Bumping the stamp makes every entry of earlier queries stale
+	template <typename T, typename U, typename W>
+	void PathSearch<T, U, W>::begin(const Graph<T, U, W>& graph, VertexId source, VertexId target)
+	{
+		if (!graph.contains(source) || !graph.contains(target))
+			throw std::out_of_range("Not a valid vertex id");
+
+		grow(graph.idBound());
+		queues[0].clear();
+		queues[1].clear();
+		if (++query == 0)
+		{
+			for (std::size_t i{ 0 }; i < capacity; ++i)
+			{
+				stamps[0][i] = 0;
+				stamps[1][i] = 0;
+			}
+			query = 1;
+		}
+		settled = 0;
+		pathLength = 0;
+		reach(0, source.index, 0, NO_PARENT);
+		reach(1, target.index, 0, NO_PARENT);
+	}
+
+	// Makes room for newCapacity ids. Nothing carries over between queries, so the old arrays are simply replaced
+	template <typename T, typename U, typename W>
+	void PathSearch<T, U, W>::grow(std::size_t newCapacity)
+	{
+		if (newCapacity <= capacity)
+			return;
+
+		for (int direction{ 0 }; direction < 2; ++direction)
+		{
+			delete[] stamps[direction];
+			delete[] distances[direction];
+			delete[] parents[direction];
+			stamps[direction] = new std::uint32_t[newCapacity]{};
+			distances[direction] = new Distance[newCapacity];
+			parents[direction] = new std::uint32_t[newCapacity];
+			queues[direction] = IndexedHeap<Distance, shorterDistance<Distance>>{ newCapacity };
+		}
+		delete[] pathIds;
+		pathIds = new VertexId[newCapacity];
+		capacity = newCapacity;
+	}
+
+	// Returns true if the search in the given direction has reached the vertex during this query
+	template <typename T, typename U, typename W>
+	bool PathSearch<T, U, W>::reached(int direction, std::uint32_t id) const
+	{
+		return stamps[direction][id] == query;
+	}
+
+	// Records the distance of the vertex from the start of the given direction and the vertex it was reached from
+	template <typename T, typename U, typename W>
+	void PathSearch<T, U, W>::reach(int direction, std::uint32_t id, Distance distance, std::uint32_t parent)
+	{
+		stamps[direction][id] = query;
+		distances[direction][id] = distance;
+		parents[direction][id] = parent;
+	}
+
+	// Writes the path through the meeting vertex, following the forward parents back to the source and the backward parents on to the target.
+	// Returns the length of the path
+	template <typename T, typename U, typename W>
+	typename PathSearch<T, U, W>::Distance PathSearch<T, U, W>::finish(std::uint32_t meeting, Distance length)
+	{
+		for (std::uint32_t id{ meeting }; id != NO_PARENT; id = parents[0][id])
+		{
+			pathIds[pathLength++].index = id;
+		}
+		for (std::size_t i{ 0 }; i < pathLength / 2; ++i)
+		{
+			VertexId swap{ pathIds[i] };
+			pathIds[i] = pathIds[pathLength - 1 - i];
+			pathIds[pathLength - 1 - i] = swap;
+		}
+		for (std::uint32_t id{ parents[1][meeting] }; id != NO_PARENT; id = parents[1][id])
+		{
+			pathIds[pathLength++].index = id;
+		}
+		return length;
+	}
+}
+#endif
@@ -0,0 +1,27 @@
+#ifndef JML_RANKING_H
+#define JML_RANKING_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "CsrGraph.h"
+#include "Graph.h"
+#include "HashTable.h"
+#include "ThreadPool.h"
+
+namespace JML
+{
+	// Sparse matrix-vector products over CsrGraph snapshots and the rankings built on them. A snapshot is read as a sparse matrix whose row id
+	// holds the outgoing edges of vertex id, with the edge weights as entries (or one for unweighted graphs). Rows are computed in parallel and
+	// each one only pulls from the input vector, so no two threads ever write the same entry
+	template <typename T, typename U, typename W, typename R>
+	void multiply(const CsrGraph<T, U, W>& matrix, const R* vector, R* result, ThreadPool& pool);
+	template <typename T, typename U, typename W, typename R>
+	std::size_t pageRank(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, R* ranks, ThreadPool& pool, double damping = 0.85,
+		double tolerance = 1e-6, std::size_t maxIterations = 100);
+	template <typename T, typename U, typename W>
+	HashTable<T, double> pageRank(const Graph<T, U, W>& graph, ThreadPool& pool, double damping = 0.85, double tolerance = 1e-6,
+		std::size_t maxIterations = 100);
+}
+#include "Ranking.hpp"
+#endif
@@ -0,0 +1,177 @@
+#ifndef JML_RANKING_HPP
+#define JML_RANKING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "CsrGraph.h"
+#include "Graph.h"
+#include "HashTable.h"
+#include "ThreadPool.h"
+
+namespace JML
+{
+	// Returns the dot product of the row entries from begin to end with the vector entries they point at. The row is summed in four
+	// independent lanes, so every addition doesn't have to wait for the one before it and the compiler can keep the lanes in one vector
+	// register. Weights is ignored unless WEIGHTED is set
+	template <bool WEIGHTED, typename Weight, typename R>
+	R rowProduct(const std::uint32_t* targets, const Weight* weights, std::size_t begin, std::size_t end, const R* vector)
+	{
+		constexpr std::size_t LANES{ 4 };
+
+		R sums[LANES]{};
+		std::size_t edge{ begin };
+		for (; edge + LANES <= end; edge += LANES)
+		{
+			for (std::size_t lane{ 0 }; lane < LANES; ++lane)
+			{
+				if constexpr (WEIGHTED)
+					sums[lane] += static_cast<R>(weights[edge + lane]) * vector[targets[edge + lane]];
+				else
+					sums[lane] += vector[targets[edge + lane]];
+			}
+		}
+		for (; edge < end; ++edge)
+		{
+			if constexpr (WEIGHTED)
+				sums[0] += static_cast<R>(weights[edge]) * vector[targets[edge]];
+			else
+				sums[0] += vector[targets[edge]];
+		}
+		return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+	}
+
+	// Writes matrix * vector into result. Vector and result have matrix.size() entries each and must not overlap
+	template <typename T, typename U, typename W, typename R>
+	void multiply(const CsrGraph<T, U, W>& matrix, const R* vector, R* result, ThreadPool& pool)
+	{
+		const std::size_t* offsets{ matrix.offsetArray() };
+		const std::uint32_t* targets{ matrix.targetArray() };
+		const typename CsrGraph<T, U, W>::Weight* weights{ matrix.weightArray() };
+		pool.parallelFor(0, matrix.size(), [&](std::size_t begin, std::size_t end, std::size_t)
+			{
+				for (std::size_t id{ begin }; id < end; ++id)
+				{
+					result[id] = rowProduct<CsrGraph<T, U, W>::WEIGHTED>(targets, weights, offsets[id], offsets[id + 1], vector);
+				}
+			});
+	}
+
+	// PageRank by power iteration. Every vertex starts with rank 1 / size(), and every iteration gives it (1 - damping) / size() plus damping
+	// times the rank flowing in along its incoming edges. A vertex splits its rank evenly over its outgoing edges, or over every vertex if it
+	// has none, and edge weights are ignored. Transposed must be graph.transpose(), whose rows are the incoming edges each vertex pulls from.
+	// Writes ranks that add up to one into ranks (graph.size() entries) and returns the number of iterations run, stopping early once the ranks
+	// change by at most tolerance in total. Throws std::invalid_argument if damping isn't between 0 and 1 or transposed doesn't match the graph
+	template <typename T, typename U, typename W, typename R>
+	std::size_t pageRank(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, R* ranks, ThreadPool& pool, double damping,
+		double tolerance, std::size_t maxIterations)
+	{
+		if (damping < 0 || damping > 1)
+			throw std::invalid_argument("Damping must be between 0 and 1");
+		if (transposed.size() != graph.size() || transposed.edgeCount() != graph.edgeCount())
+			throw std::invalid_argument("Transposed doesn't match the graph");
+
+		std::size_t numVerts{ graph.size() };
+		if (numVerts == 0)
+			return 0;
+
+		const std::size_t* offsets{ graph.offsetArray() };
+		const std::size_t* inOffsets{ transposed.offsetArray() };
+		const std::uint32_t* inTargets{ transposed.targetArray() };
+		std::size_t numThreads{ pool.threadCount() };
+		R* shares{ new R[numVerts] };  // Rank each vertex sends along every one of its outgoing edges
+		double* danglingRanks{ new double[numThreads] };  // Per-thread totals, added up after every loop
+		double* changes{ new double[numThreads] };
+		pool.parallelFor(0, numVerts, [&](std::size_t begin, std::size_t end, std::size_t)
+			{
+				for (std::size_t id{ begin }; id < end; ++id)
+				{
+					ranks[id] = static_cast<R>(1.0 / static_cast<double>(numVerts));
+				}
+			});
+
+		std::size_t iteration{ 0 };
+		while (iteration < maxIterations)
+		{
+			++iteration;
+			for (std::size_t thread{ 0 }; thread < numThreads; ++thread)
+			{
+				danglingRanks[thread] = 0;
+				changes[thread] = 0;
+			}
+			pool.parallelFor(0, numVerts, [&](std::size_t begin, std::size_t end, std::size_t thread)
+				{
+					double dangling{ 0 };
+					for (std::size_t id{ begin }; id < end; ++id)
+					{
+						std::size_t degree{ offsets[id + 1] - offsets[id] };
+						if (degree == 0)
+						{
+							dangling += ranks[id];
+							shares[id] = 0;
+						}
+						else
+							shares[id] = ranks[id] / static_cast<R>(degree);
+					}
+					danglingRanks[thread] += dangling;
+				});
+			double dangling{ 0 };
+			for (std::size_t thread{ 0 }; thread < numThreads; ++thread)
+			{
+				dangling += danglingRanks[thread];
+			}
+
+			// Every vertex only reads shares and writes its own rank, so the ranks can be updated in place
+			R base{ static_cast<R>((1.0 - damping + damping * dangling) / static_cast<double>(numVerts)) };
+			R factor{ static_cast<R>(damping) };
+			pool.parallelFor(0, numVerts, [&](std::size_t begin, std::size_t end, std::size_t thread)
+				{
+					double change{ 0 };
+					for (std::size_t id{ begin }; id < end; ++id)
+					{
+						R rank{ base + factor * rowProduct<false, NoWeight>(inTargets, nullptr, inOffsets[id], inOffsets[id + 1], shares) };
+						change += rank > ranks[id] ? rank - ranks[id] : ranks[id] - rank;
+						ranks[id] = rank;
+					}
+					changes[thread] += change;
+				});
+			double change{ 0 };
+			for (std::size_t thread{ 0 }; thread < numThreads; ++thread)
+			{
+				change += changes[thread];
+			}
+			if (change <= tolerance)
+				break;
+		}
+		delete[] shares;
+		delete[] danglingRanks;
+		delete[] changes;
+		return iteration;
+	}
+
+	// Returns the PageRank of every vertex key, computed on a frozen snapshot as the CsrGraph overload does
+	template <typename T, typename U, typename W>
+	HashTable<T, double> pageRank(const Graph<T, U, W>& graph, ThreadPool& pool, double damping, double tolerance, std::size_t maxIterations)
+	{
+		CsrGraph<T, U, W> frozen{ graph.freeze() };
+		double* ranks{ new double[frozen.size()] };
+		try
+		{
+			pageRank(frozen, frozen.transpose(), ranks, pool, damping, tolerance, maxIterations);
+		}
+		catch (const std::invalid_argument&)
+		{
+			delete[] ranks;
+			throw;
+		}
+		HashTable<T, double> result{ frozen.size() ? frozen.size() : 1 };
+		for (std::uint32_t id{ 0 }; id < frozen.size(); ++id)
+		{
+			result.insert(frozen.key(id), ranks[id]);
+		}
+		delete[] ranks;
+		return result;
+	}
+}
+#endif
@@ -0,0 +1,29 @@
+#ifndef JML_REORDERING_H
+#define JML_REORDERING_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "CsrGraph.h"
+
+namespace JML
+{
+	// Vertex orderings for CsrGraph::relabel that give vertices close together in the graph nearby ids, so traversals touch memory that's
+	// close together. Each one writes a permutation of the ids into order (graph.size() entries), where order[i] is the id that becomes id i.
+	// Edges count in both directions, which is why they take transposed, the graph.transpose() snapshot
+	template <typename T, typename U, typename W>
+	void bfsOrder(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, std::uint32_t* order);
+	template <typename T, typename U, typename W>
+	void reverseCuthillMcKeeOrder(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, std::uint32_t* order);
+	template <typename T, typename U, typename W>
+	void degreeOrder(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, std::uint32_t* order);
+
+	// Partitioning into parts numbered from 0, for handing each part to its own thread
+	template <typename T, typename U, typename W>
+	std::size_t edgeCut(const CsrGraph<T, U, W>& graph, const std::uint32_t* parts);
+	template <typename T, typename U, typename W>
+	std::size_t partition(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, std::size_t numParts, std::uint32_t* parts,
+		double imbalance = 0.03, std::size_t maxRounds = 20);
+}
+#include "Reordering.hpp"
+#endif
@@ -0,0 +1,257 @@
+#ifndef JML_REORDERING_HPP
+#define JML_REORDERING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "CsrGraph.h"
+#include "Heap.h"
+
+namespace JML
+{
+	// Vertex queued by Cuthill-McKee, which visits the neighbors of every vertex from the fewest edges to the most
+	struct IdDegree
+	{
+		std::uint32_t id{};
+		std::size_t degree{};
+	};
+
+	inline bool fewerEdges(const IdDegree& vertex1, const IdDegree& vertex2)
+	{
+		return vertex1.degree < vertex2.degree || (vertex1.degree == vertex2.degree && vertex1.id < vertex2.id);
+	}
+
+	// Writes the ids into order sorted by the number of edges in and out of each vertex, from the most if descending is set and from the fewest
+	// otherwise. Ties keep id order. Counting sort, so it takes time proportional to the size of the graph
+	template <typename T, typename U, typename W>
+	void sortByDegree(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, std::uint32_t* order, bool descending)
+	{
+		std::size_t numVerts{ graph.size() };
+		const std::size_t* offsets{ graph.offsetArray() };
+		const std::size_t* inOffsets{ transposed.offsetArray() };
+		std::size_t maxDegree{ 0 };
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			std::size_t degree{ offsets[id + 1] - offsets[id] + inOffsets[id + 1] - inOffsets[id] };
+			if (degree > maxDegree)
+				maxDegree = degree;
+		}
+
+		// Counting the vertices of every degree into starts[degree + 1], then turning the counts into starting positions
+		std::size_t* starts{ new std::size_t[maxDegree + 2]{} };
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			std::size_t degree{ offsets[id + 1] - offsets[id] + inOffsets[id + 1] - inOffsets[id] };
+			++starts[(descending ? maxDegree - degree : degree) + 1];
+		}
+		for (std::size_t bucket{ 0 }; bucket <= maxDegree; ++bucket)
+		{
+			starts[bucket + 1] += starts[bucket];
+		}
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			std::size_t degree{ offsets[id + 1] - offsets[id] + inOffsets[id + 1] - inOffsets[id] };
+			order[starts[descending ? maxDegree - degree : degree]++] = static_cast<std::uint32_t>(id);
+		}
+		delete[] starts;
+	}
+
+	// Writes the ids into order breadth-first over edges in both directions. Every component starts from its first vertex in starts (a
+	// permutation of the ids). If byDegree is set, the new neighbors of every vertex are queued from the fewest edges to the most
+	template <typename T, typename U, typename W>
+	void undirectedBfsOrder(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, const std::uint32_t* starts, bool byDegree,
+		std::uint32_t* order)
+	{
+		std::size_t numVerts{ graph.size() };
+		const std::size_t* offsets{ graph.offsetArray() };
+		const std::uint32_t* targets{ graph.targetArray() };
+		const std::size_t* inOffsets{ transposed.offsetArray() };
+		const std::uint32_t* inTargets{ transposed.targetArray() };
+		bool* visited{ new bool[numVerts]{} };
+		Heap<IdDegree, fewerEdges> neighbors;
+		// The output doubles as the queue: everything between head and tail is waiting to be expanded
+		std::size_t head{ 0 };
+		std::size_t tail{ 0 };
+		for (std::size_t start{ 0 }; start < numVerts; ++start)
+		{
+			if (visited[starts[start]])
+				continue;
+
+			visited[starts[start]] = true;
+			order[tail++] = starts[start];
+			while (head < tail)
+			{
+				std::uint32_t current{ order[head++] };
+				std::size_t found{ tail };
+				for (const std::uint32_t* list : { targets, inTargets })
+				{
+					std::size_t begin{ list == targets ? offsets[current] : inOffsets[current] };
+					std::size_t end{ list == targets ? offsets[current + 1] : inOffsets[current + 1] };
+					for (std::size_t edge{ begin }; edge < end; ++edge)
+					{
+						std::uint32_t neighbor{ list[edge] };
+						if (!visited[neighbor])
+						{
+							visited[neighbor] = true;
+							order[tail++] = neighbor;
+						}
+					}
+				}
+				if (!byDegree)
+					continue;
+
+				for (std::size_t i{ found }; i < tail; ++i)
+				{
+					std::uint32_t id{ order[i] };
+					neighbors.insert(IdDegree{ id, offsets[id + 1] - offsets[id] + inOffsets[id + 1] - inOffsets[id] });
+				}
+				for (std::size_t i{ found }; i < tail; ++i)
+				{
+					order[i] = neighbors.top().id;
+					neighbors.pop();
+				}
+			}
+		}
+		delete[] visited;
+	}
+
+	// Breadth-first order, with every component starting from its lowest id. Vertices end up next to the vertices they were reached from
+	template <typename T, typename U, typename W>
+	void bfsOrder(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, std::uint32_t* order)
+	{
+		std::uint32_t* starts{ new std::uint32_t[graph.size()] };
+		for (std::size_t id{ 0 }; id < graph.size(); ++id)
+		{
+			starts[id] = static_cast<std::uint32_t>(id);
+		}
+		undirectedBfsOrder(graph, transposed, starts, false, order);
+		delete[] starts;
+	}
+
+	// Reverse Cuthill-McKee order: breadth-first from a vertex with the fewest edges in every component, queueing neighbors from the fewest
+	// edges to the most, and then reversed. It keeps every edge's ends close together in id (a narrow bandwidth), which suits meshes and
+	// road networks
+	template <typename T, typename U, typename W>
+	void reverseCuthillMcKeeOrder(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, std::uint32_t* order)
+	{
+		std::size_t numVerts{ graph.size() };
+		std::uint32_t* starts{ new std::uint32_t[numVerts] };
+		sortByDegree(graph, transposed, starts, false);
+		undirectedBfsOrder(graph, transposed, starts, true, order);
+		delete[] starts;
+		for (std::size_t i{ 0 }; i < numVerts / 2; ++i)
+		{
+			std::uint32_t swap{ order[i] };
+			order[i] = order[numVerts - 1 - i];
+			order[numVerts - 1 - i] = swap;
+		}
+	}
+
+	// Degree order, from the most edges to the fewest. It packs the hubs of a skewed graph, which most edges point at, into a few cache lines
+	template <typename T, typename U, typename W>
+	void degreeOrder(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, std::uint32_t* order)
+	{
+		sortByDegree(graph, transposed, order, true);
+	}
+
+	// Returns the number of edges whose ends are in different parts, given the part of every vertex (graph.size() entries)
+	template <typename T, typename U, typename W>
+	std::size_t edgeCut(const CsrGraph<T, U, W>& graph, const std::uint32_t* parts)
+	{
+		const std::size_t* offsets{ graph.offsetArray() };
+		const std::uint32_t* targets{ graph.targetArray() };
+		std::size_t cut{ 0 };
+		for (std::size_t id{ 0 }; id < graph.size(); ++id)
+		{
+			for (std::size_t edge{ offsets[id] }; edge < offsets[id + 1]; ++edge)
+			{
+				if (parts[targets[edge]] != parts[id])
+					++cut;
+			}
+		}
+		return cut;
+	}
+
+	// Splits the vertices into numParts parts of at most (1 + imbalance) * size() / numParts vertices each, writes the part of every vertex into
+	// parts (graph.size() entries) and returns the edge cut. The parts start as contiguous blocks of ids, which is already a good split for a
+	// graph relabeled by one of the orders above. Then rounds of label propagation move every vertex to the part most of its neighbors are
+	// in, if that part has room. A vertex only moves if that cuts fewer edges, so the cut never grows, and the rounds stop once no vertex
+	// moves or after maxRounds. Transposed must be graph.transpose(). Throws std::invalid_argument if numParts is 0
+	template <typename T, typename U, typename W>
+	std::size_t partition(const CsrGraph<T, U, W>& graph, const CsrGraph<T, U, W>& transposed, std::size_t numParts, std::uint32_t* parts,
+		double imbalance, std::size_t maxRounds)
+	{
+		if (numParts == 0)
+			throw std::invalid_argument("There must be at least one part");
+
+		std::size_t numVerts{ graph.size() };
+		const std::size_t* offsets{ graph.offsetArray() };
+		const std::uint32_t* targets{ graph.targetArray() };
+		const std::size_t* inOffsets{ transposed.offsetArray() };
+		const std::uint32_t* inTargets{ transposed.targetArray() };
+		std::size_t evenSize{ (numVerts + numParts - 1) / numParts };
+		std::size_t capacity{ static_cast<std::size_t>((1.0 + imbalance) * static_cast<double>(numVerts) / static_cast<double>(numParts)) };
+		if (capacity < evenSize)
+			capacity = evenSize;
+
+		std::size_t* sizes{ new std::size_t[numParts]{} };
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			parts[id] = static_cast<std::uint32_t>(id * numParts / numVerts);
+			++sizes[parts[id]];
+		}
+
+		// Neighbor counts per part, with the parts that have any listed in touched so that only they need clearing
+		std::size_t* counts{ new std::size_t[numParts]{} };
+		std::uint32_t* touched{ new std::uint32_t[numParts] };
+		for (std::size_t round{ 0 }; round < maxRounds; ++round)
+		{
+			std::size_t moved{ 0 };
+			for (std::size_t id{ 0 }; id < numVerts; ++id)
+			{
+				std::size_t numTouched{ 0 };
+				for (const std::uint32_t* list : { targets, inTargets })
+				{
+					std::size_t begin{ list == targets ? offsets[id] : inOffsets[id] };
+					std::size_t end{ list == targets ? offsets[id + 1] : inOffsets[id + 1] };
+					for (std::size_t edge{ begin }; edge < end; ++edge)
+					{
+						if (list[edge] == id)
+							continue;
+
+						std::uint32_t part{ parts[list[edge]] };
+						if (counts[part]++ == 0)
+							touched[numTouched++] = part;
+					}
+				}
+
+				std::uint32_t current{ parts[id] };
+				std::uint32_t best{ current };
+				for (std::size_t i{ 0 }; i < numTouched; ++i)
+				{
+					if (counts[touched[i]] > counts[best] && sizes[touched[i]] < capacity)
+						best = touched[i];
+				}
+				for (std::size_t i{ 0 }; i < numTouched; ++i)
+				{
+					counts[touched[i]] = 0;
+				}
+				if (best != current)
+				{
+					--sizes[current];
+					++sizes[best];
+					parts[id] = best;
+					++moved;
+				}
+			}
+			if (moved == 0)
+				break;
+		}
+		delete[] sizes;
+		delete[] counts;
+		delete[] touched;
+		return edgeCut(graph, parts);
+	}
+}
+#endif
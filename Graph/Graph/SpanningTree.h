@@ -0,0 +1,25 @@
+#ifndef JML_SPANNING_TREE_H
+#define JML_SPANNING_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "CsrGraph.h"
+#include "Graph.h"
+#include "ThreadPool.h"
+
+namespace JML
+{
+	// Minimum spanning forests. Edge directions are ignored, so an edge joins its two vertices either way, and a disconnected graph gets one
+	// tree per connected component. Tree edges are written with the direction they have in the graph
+	template <typename T, typename U>
+	std::size_t kruskal(const CsrGraph<T, U>& graph, GraphEdge<std::uint32_t>* tree, ThreadPool& pool);
+	template <typename T, typename U>
+	std::size_t kruskal(const Graph<T, U>& graph, GraphEdge<T>* tree, ThreadPool& pool);
+	template <typename T, typename U>
+	std::size_t prim(const CsrGraph<T, U>& graph, GraphEdge<std::uint32_t>* tree);
+	template <typename T, typename U>
+	std::size_t prim(const Graph<T, U>& graph, GraphEdge<T>* tree);
+}
+#include "SpanningTree.hpp"
+#endif
@@ -0,0 +1,257 @@
+#ifndef JML_SPANNING_TREE_HPP
+#define JML_SPANNING_TREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "CsrGraph.h"
+#include "Graph.h"
+#include "IndexedHeap.h"
+#include "ThreadPool.h"
+#include "UnionFind.h"
+
+namespace JML
+{
+	// Edge being sorted by Kruskal. The key is the weight with its sign bit flipped, which orders the same way as unsigned
+	struct KeyedEdge
+	{
+		std::uint32_t key{};
+		std::uint32_t from{};
+		std::uint32_t to{};
+	};
+
+	inline bool lighterWeight(const int& weight1, const int& weight2)
+	{
+		return weight1 < weight2;
+	}
+
+	// Stable least significant digit radix sort of count edges by key, one byte per pass. Every pass counts the digits of fixed blocks of the
+	// array in parallel, so the prefix sums give each block its own output range and the scatter needs no synchronization. Passes where every
+	// key has the same digit are skipped. Edges and buffer are swapped along the way and edges ends up pointing at the sorted array
+	inline void radixSortEdges(KeyedEdge*& edges, KeyedEdge*& buffer, std::size_t count, ThreadPool& pool)
+	{
+		constexpr std::size_t RADIX{ 256 };
+		constexpr std::size_t MINBLOCKSIZE{ 65536 };  // Smaller arrays are sorted as a single block, since the counts would outweigh the work
+
+		std::size_t numBlocks{ count < MINBLOCKSIZE ? 1 : pool.threadCount() * 4 };
+		std::size_t blockSize{ (count + numBlocks - 1) / numBlocks };
+		std::size_t* counts{ new std::size_t[numBlocks * RADIX] };
+		for (unsigned int shift{ 0 }; shift < 32; shift += 8)
+		{
+			pool.parallelFor(0, numBlocks, [&](std::size_t blockBegin, std::size_t blockEnd, std::size_t)
+				{
+					for (std::size_t block{ blockBegin }; block < blockEnd; ++block)
+					{
+						std::size_t* blockCounts{ counts + block * RADIX };
+						for (std::size_t digit{ 0 }; digit < RADIX; ++digit)
+						{
+							blockCounts[digit] = 0;
+						}
+						std::size_t end{ (block + 1) * blockSize < count ? (block + 1) * blockSize : count };
+						for (std::size_t i{ block * blockSize }; i < end; ++i)
+						{
+							++blockCounts[(edges[i].key >> shift) & (RADIX - 1)];
+						}
+					}
+				});
+
+			// Turning the counts into output offsets, ordered by digit and then by block so that the sort stays stable
+			bool sorted{ false };
+			std::size_t offset{ 0 };
+			for (std::size_t digit{ 0 }; digit < RADIX; ++digit)
+			{
+				std::size_t digitStart{ offset };
+				for (std::size_t block{ 0 }; block < numBlocks; ++block)
+				{
+					std::size_t blockCount{ counts[block * RADIX + digit] };
+					counts[block * RADIX + digit] = offset;
+					offset += blockCount;
+				}
+				if (offset - digitStart == count)
+					sorted = true;
+			}
+			if (sorted)
+				continue;
+
+			pool.parallelFor(0, numBlocks, [&](std::size_t blockBegin, std::size_t blockEnd, std::size_t)
+				{
+					for (std::size_t block{ blockBegin }; block < blockEnd; ++block)
+					{
+						std::size_t* cursors{ counts + block * RADIX };
+						std::size_t end{ (block + 1) * blockSize < count ? (block + 1) * blockSize : count };
+						for (std::size_t i{ block * blockSize }; i < end; ++i)
+						{
+							buffer[cursors[(edges[i].key >> shift) & (RADIX - 1)]++] = edges[i];
+						}
+					}
+				});
+			KeyedEdge* swap{ edges };
+			edges = buffer;
+			buffer = swap;
+		}
+		delete[] counts;
+	}
+
+	// Kruskal's algorithm. The edges are sorted by weight with a parallel radix sort and then added in order unless their ends are already
+	// joined, which a UnionFind tracks. Tree must have room for graph.size() - 1 edges. Returns the number of tree edges written
+	template <typename T, typename U>
+	std::size_t kruskal(const CsrGraph<T, U>& graph, GraphEdge<std::uint32_t>* tree, ThreadPool& pool)
+	{
+		std::size_t numVerts{ graph.size() };
+		std::size_t numEdges{ graph.edgeCount() };
+		const std::size_t* offsets{ graph.offsetArray() };
+		const std::uint32_t* targets{ graph.targetArray() };
+		const int* weights{ graph.weightArray() };
+		KeyedEdge* edges{ new KeyedEdge[numEdges] };
+		KeyedEdge* buffer{ new KeyedEdge[numEdges] };
+		pool.parallelFor(0, numVerts, [&](std::size_t chunkBegin, std::size_t chunkEnd, std::size_t)
+			{
+				for (std::size_t id{ chunkBegin }; id < chunkEnd; ++id)
+				{
+					for (std::size_t edge{ offsets[id] }; edge < offsets[id + 1]; ++edge)
+					{
+						edges[edge] = KeyedEdge{ static_cast<std::uint32_t>(weights[edge]) ^ 0x80000000u, static_cast<std::uint32_t>(id), targets[edge] };
+					}
+				}
+			});
+		radixSortEdges(edges, buffer, numEdges, pool);
+		delete[] buffer;
+
+		UnionFind sets{ numVerts };
+		std::size_t treeSize{ 0 };
+		for (std::size_t i{ 0 }; i < numEdges && treeSize + 1 < numVerts; ++i)
+		{
+			if (sets.unite(edges[i].from, edges[i].to))
+				tree[treeSize++] = GraphEdge<std::uint32_t>{ edges[i].from, edges[i].to, static_cast<int>(edges[i].key ^ 0x80000000u) };
+		}
+		delete[] edges;
+		return treeSize;
+	}
+
+	// Fills tree with a minimum spanning forest of the graph by key, using Kruskal's algorithm on a frozen snapshot. Tree must have room for
+	// graph.size() - 1 edges. Returns the number of tree edges written
+	template <typename T, typename U>
+	std::size_t kruskal(const Graph<T, U>& graph, GraphEdge<T>* tree, ThreadPool& pool)
+	{
+		CsrGraph<T, U> frozen{ graph.freeze() };
+		GraphEdge<std::uint32_t>* idTree{ new GraphEdge<std::uint32_t>[frozen.size()] };
+		std::size_t treeSize{ kruskal(frozen, idTree, pool) };
+		for (std::size_t i{ 0 }; i < treeSize; ++i)
+		{
+			tree[i] = GraphEdge<T>{ frozen.key(idTree[i].from), frozen.key(idTree[i].to), idTree[i].weight };
+		}
+		delete[] idTree;
+		return treeSize;
+	}
+
+	// Prim's algorithm. Vertices outside the tree wait in an IndexedHeap keyed by their lightest edge to the tree, which is lowered in place
+	// when a lighter edge shows up, so the heap never holds more than one entry per vertex. Tree must have room for graph.size() - 1 edges.
+	// Returns the number of tree edges written
+	template <typename T, typename U>
+	std::size_t prim(const CsrGraph<T, U>& graph, GraphEdge<std::uint32_t>* tree)
+	{
+		std::size_t numVerts{ graph.size() };
+		std::size_t numEdges{ graph.edgeCount() };
+		const std::size_t* offsets{ graph.offsetArray() };
+		const std::uint32_t* targets{ graph.targetArray() };
+		const int* weights{ graph.weightArray() };
+
+		// Indexing the incoming edges as well, since a tree can grow along an edge in either direction
+		std::size_t* inOffsets{ new std::size_t[numVerts + 1]{} };
+		std::uint32_t* inSources{ new std::uint32_t[numEdges] };
+		int* inWeights{ new int[numEdges] };
+		for (std::size_t edge{ 0 }; edge < numEdges; ++edge)
+		{
+			++inOffsets[targets[edge] + 1];
+		}
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			inOffsets[id + 1] += inOffsets[id];
+		}
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			for (std::size_t edge{ offsets[id] }; edge < offsets[id + 1]; ++edge)
+			{
+				std::size_t slot{ inOffsets[targets[edge]]++ };
+				inSources[slot] = static_cast<std::uint32_t>(id);
+				inWeights[slot] = weights[edge];
+			}
+		}
+		// Filling shifted every offset up by one list, so shifting them back
+		for (std::size_t id{ numVerts }; id > 0; --id)
+		{
+			inOffsets[id] = inOffsets[id - 1];
+		}
+		inOffsets[0] = 0;
+
+		bool* inTree{ new bool[numVerts]{} };
+		std::uint32_t* parents{ new std::uint32_t[numVerts] };  // Tree end of the lightest known edge to every vertex in the heap
+		bool* incoming{ new bool[numVerts] };  // Whether that edge points into the tree rather than out of it
+		IndexedHeap<int, lighterWeight> queue{ numVerts };
+		auto relax{ [&](std::uint32_t id, std::uint32_t neighbor, int weight, bool reversed)
+			{
+				if (!inTree[neighbor] && (!queue.contains(neighbor) || weight < queue.priority(neighbor)))
+				{
+					queue.insert(neighbor, weight);
+					parents[neighbor] = id;
+					incoming[neighbor] = reversed;
+				}
+			} };
+
+		std::size_t treeSize{ 0 };
+		for (std::uint32_t root{ 0 }; root < numVerts; ++root)
+		{
+			if (inTree[root])
+				continue;
+
+			// Growing a new tree from every vertex that no earlier tree reached
+			std::uint32_t id{ root };
+			while (true)
+			{
+				inTree[id] = true;
+				for (std::size_t edge{ offsets[id] }; edge < offsets[id + 1]; ++edge)
+				{
+					relax(id, targets[edge], weights[edge], false);
+				}
+				for (std::size_t edge{ inOffsets[id] }; edge < inOffsets[id + 1]; ++edge)
+				{
+					relax(id, inSources[edge], inWeights[edge], true);
+				}
+				if (queue.empty())
+					break;
+
+				id = static_cast<std::uint32_t>(queue.topIndex());
+				int weight{ queue.top() };
+				queue.pop();
+				if (incoming[id])
+					tree[treeSize++] = GraphEdge<std::uint32_t>{ id, parents[id], weight };
+				else
+					tree[treeSize++] = GraphEdge<std::uint32_t>{ parents[id], id, weight };
+			}
+		}
+		delete[] inOffsets;
+		delete[] inSources;
+		delete[] inWeights;
+		delete[] inTree;
+		delete[] parents;
+		delete[] incoming;
+		return treeSize;
+	}
+
+	// Fills tree with a minimum spanning forest of the graph by key, using Prim's algorithm on a frozen snapshot. Tree must have room for
+	// graph.size() - 1 edges. Returns the number of tree edges written
+	template <typename T, typename U>
+	std::size_t prim(const Graph<T, U>& graph, GraphEdge<T>* tree)
+	{
+		CsrGraph<T, U> frozen{ graph.freeze() };
+		GraphEdge<std::uint32_t>* idTree{ new GraphEdge<std::uint32_t>[frozen.size()] };
+		std::size_t treeSize{ prim(frozen, idTree) };
+		for (std::size_t i{ 0 }; i < treeSize; ++i)
+		{
+			tree[i] = GraphEdge<T>{ frozen.key(idTree[i].from), frozen.key(idTree[i].to), idTree[i].weight };
+		}
+		delete[] idTree;
+		return treeSize;
+	}
+}
+#endif
@@ -0,0 +1,42 @@
+#ifndef JML_THREAD_POOL_H
+#define JML_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace JML
+{
+	// Fixed set of worker threads for fork-join loops. The calling thread takes part in every loop as thread 0
+	class ThreadPool
+	{
+	public:
+		ThreadPool(std::size_t numThreads = std::thread::hardware_concurrency());
+		ThreadPool(const ThreadPool& pool) = delete;
+		ThreadPool(ThreadPool&& pool) = delete;
+		~ThreadPool();
+		ThreadPool& operator=(const ThreadPool& pool) = delete;
+		ThreadPool& operator=(ThreadPool&& pool) = delete;
+		std::size_t threadCount() const;
+		template <typename F> void parallelFor(std::size_t begin, std::size_t end, F&& body);
+
+	private:
+		std::size_t numThreads{};
+		std::thread* workers{ nullptr };
+		std::mutex lock{};
+		std::condition_variable wake{};
+		std::condition_variable finished{};
+		std::size_t generation{ 0 };  // Incremented for every loop so that workers can tell a new loop from a spurious wakeup
+		std::size_t busyWorkers{ 0 };
+		bool stopping{ false };
+		std::function<void(std::size_t)> job{};
+
+		void workerLoop(std::size_t thread);
+	};
+}
+#include "ThreadPool.hpp"
+#endif
@@ -0,0 +1,126 @@
+#ifndef JML_THREAD_POOL_HPP
+#define JML_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace JML
+{
+	inline ThreadPool::ThreadPool(std::size_t numThreads) :
+		numThreads{ numThreads ? numThreads : 1 }
+	{
+		workers = new std::thread[this->numThreads - 1];
+		for (std::size_t i{ 1 }; i < this->numThreads; ++i)
+		{
+			workers[i - 1] = std::thread([this, i]() { workerLoop(i); });
+		}
+	}
+
+	inline ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> guard{ lock };
+			stopping = true;
+		}
+		wake.notify_all();
+		for (std::size_t i{ 0 }; i + 1 < numThreads; ++i)
+		{
+			workers[i].join();
+		}
+		delete[] workers;
+	}
+
+	// Returns the number of threads taking part in each loop, including the calling thread
+	inline std::size_t ThreadPool::threadCount() const
+	{
+		return numThreads;
+	}
+
+	// Splits [begin, end) into chunks and calls body(chunkBegin, chunkEnd, thread) for each of them on the pool's threads, where thread is in
+	// [0, threadCount()). Chunks are handed out dynamically so that uneven work balances out. Returns once every chunk is done. If body throws,
+	// no further chunks are started, and once the chunks already running are done the first exception is rethrown. Not reentrant
+	template <typename F>
+	void ThreadPool::parallelFor(std::size_t begin, std::size_t end, F&& body)
+	{
+		if (begin >= end)
+			return;
+
+		// Roughly eight chunks per thread
+		std::size_t chunkSize{ (end - begin) / (numThreads * 8) + 1 };
+		std::atomic<std::size_t> next{ begin };
+		std::atomic<bool> failed{ false };
+		std::exception_ptr error{};
+		auto runChunks{ [&](std::size_t thread)
+			{
+				while (!failed.load(std::memory_order_relaxed))
+				{
+					std::size_t chunkBegin{ next.fetch_add(chunkSize) };
+					if (chunkBegin >= end)
+						return;
+
+					try
+					{
+						body(chunkBegin, end - chunkBegin < chunkSize ? end : chunkBegin + chunkSize, thread);
+					}
+					catch (...)
+					{
+						// Only the first thread to fail keeps its exception, and the wait for the workers orders its write before the rethrow
+						if (!failed.exchange(true))
+							error = std::current_exception();
+						return;
+					}
+				}
+			} };
+		if (numThreads == 1)
+		{
+			runChunks(0);
+		}
+		else
+		{
+			{
+				std::lock_guard<std::mutex> guard{ lock };
+				job = runChunks;
+				busyWorkers = numThreads - 1;
+				++generation;
+			}
+			wake.notify_all();
+			runChunks(0);
+			std::unique_lock<std::mutex> guard{ lock };
+			finished.wait(guard, [this]() { return busyWorkers == 0; });
+			job = nullptr;
+		}
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	// Runs one loop for every generation until the pool is destroyed
+	inline void ThreadPool::workerLoop(std::size_t thread)
+	{
+		std::size_t seenGeneration{ 0 };
+		while (true)
+		{
+			std::function<void(std::size_t)>* currentJob{ nullptr };
+			{
+				std::unique_lock<std::mutex> guard{ lock };
+				wake.wait(guard, [this, seenGeneration]() { return stopping || generation != seenGeneration; });
+				if (stopping)
+					return;
+
+				seenGeneration = generation;
+				currentJob = &job;
+			}
+			(*currentJob)(thread);
+			{
+				std::lock_guard<std::mutex> guard{ lock };
+				--busyWorkers;
+			}
+			finished.notify_one();
+		}
+	}
+}
+#endif
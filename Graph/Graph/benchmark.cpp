@@ -0,0 +1,1449 @@
+#if 0
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "Cohesion.h"
+#include "CsrGraph.h"
+#include "DynamicPaths.h"
+#include "Graph.h"
+#include "GraphAlgorithms.h"
+#include "GraphFile.h"
+#include "Heap.h"
+#include "ParallelGraph.h"
+#include "PathSearch.h"
+#include "Ranking.h"
+#include "Reordering.h"
+#include "SpanningTree.h"
+#include "ThreadPool.h"
+#include "UnionFind.h"
+
+constexpr int NUM_VERTICES{ 1000000 };
+constexpr int NUM_EDGES{ 10000000 };
+constexpr int MAX_WEIGHT{ 100 };
+constexpr int RMAT_SCALE{ 20 };  // R-MAT graphs have 2^RMAT_SCALE vertices
+constexpr int RMAT_EDGE_FACTOR{ 8 };  // and RMAT_EDGE_FACTOR edges per vertex
+
+struct KeyDistance
+{
+	int key{};
+	long long distance{};
+};
+
+bool closerKey(const KeyDistance& pair1, const KeyDistance& pair2)
+{
+	return pair1.distance < pair2.distance;
+}
+
+// Returns the milliseconds elapsed since start
+long long elapsed(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Builds a directed graph with numVertices vertices keyed 0 to numVertices - 1 and numEdges random edges
+JML::Graph<int, int> makeRandomGraph(int numVertices, int numEdges, unsigned int seed, JML::GraphOptions options = JML::GraphOptions::None)
+{
+	JML::Graph<int, int> graph{ options };
+	for (int i{ 0 }; i < numVertices; ++i)
+	{
+		graph.addVertex(i, i);
+	}
+	std::mt19937 generator{ seed };
+	std::uniform_int_distribution<int> vertexDistribution{ 0, numVertices - 1 };
+	std::uniform_int_distribution<int> weightDistribution{ 1, MAX_WEIGHT };
+	for (int i{ 0 }; i < numEdges; ++i)
+	{
+		graph.addEdge(vertexDistribution(generator), vertexDistribution(generator), weightDistribution(generator));
+	}
+	return graph;
+}
+
+// Draws an R-MAT edge (Chakrabarti et al.) between two of 2^scale vertices by recursively picking one of the four quadrants of the adjacency
+// matrix with probabilities 0.57, 0.19, 0.19 and 0.05
+template <typename G>
+void rmatEdge(int scale, G& generator, int& from, int& to)
+{
+	std::uniform_real_distribution<double> quadrantDistribution{ 0.0, 1.0 };
+	from = 0;
+	to = 0;
+	for (int bit{ 0 }; bit < scale; ++bit)
+	{
+		double quadrant{ quadrantDistribution(generator) };
+		if (quadrant >= 0.57)
+		{
+			if (quadrant < 0.76)
+				to |= 1 << bit;
+			else if (quadrant < 0.95)
+				from |= 1 << bit;
+			else
+			{
+				from |= 1 << bit;
+				to |= 1 << bit;
+			}
+		}
+	}
+}
+
+// Builds a skewed, small-world R-MAT graph with 2^scale vertices and edgeFactor edges per vertex
+JML::Graph<int, int> makeRmatGraph(int scale, int edgeFactor, unsigned int seed)
+{
+	int numVertices{ 1 << scale };
+	JML::Graph<int, int> graph;
+	for (int i{ 0 }; i < numVertices; ++i)
+	{
+		graph.addVertex(i, i);
+	}
+	std::mt19937 generator{ seed };
+	for (long long i{ 0 }; i < static_cast<long long>(numVertices) * edgeFactor; ++i)
+	{
+		int from{ 0 };
+		int to{ 0 };
+		rmatEdge(scale, generator, from, to);
+		graph.addEdge(from, to, 1);
+	}
+	return graph;
+}
+
+// Builds a road-like side x side grid keyed row by row, with an edge of random weight each way between neighboring cells
+template <typename G>
+JML::Graph<int, int> makeGridGraph(int side, G& generator, JML::GraphOptions options = JML::GraphOptions::None)
+{
+	JML::Graph<int, int> graph{ options };
+	graph.reserve(side * side);
+	for (int i{ 0 }; i < side * side; ++i)
+	{
+		graph.addVertex(i, i);
+	}
+	std::uniform_int_distribution<int> weightDistribution{ 1, MAX_WEIGHT };
+	for (int row{ 0 }; row < side; ++row)
+	{
+		for (int column{ 0 }; column < side; ++column)
+		{
+			int id{ row * side + column };
+			if (column + 1 < side)
+			{
+				graph.addEdge(id, id + 1, weightDistribution(generator));
+				graph.addEdge(id + 1, id, weightDistribution(generator));
+			}
+			if (row + 1 < side)
+			{
+				graph.addEdge(id, id + side, weightDistribution(generator));
+				graph.addEdge(id + side, id, weightDistribution(generator));
+			}
+		}
+	}
+	return graph;
+}
+
+// Breadth-first search through getAdjacent. Returns the number of vertices reached
+std::size_t adjacentBfs(const JML::Graph<int, int>& graph, int source)
+{
+	bool* visited{ new bool[graph.size()]{} };
+	int* queue{ new int[graph.size()] };
+	std::size_t head{ 0 };
+	std::size_t tail{ 0 };
+	queue[tail++] = source;
+	visited[source] = true;
+	while (head < tail)
+	{
+		for (const JML::VertexId& id : graph.getAdjacent(queue[head++]))
+		{
+			int key{ graph.key(id) };
+			if (!visited[key])
+			{
+				visited[key] = true;
+				queue[tail++] = key;
+			}
+		}
+	}
+	delete[] queue;
+	delete[] visited;
+	return tail;
+}
+
+// Dijkstra through getAdjacent, looking up each weight by key. Returns the sum of the distances to the reachable vertices
+long long adjacentDijkstra(const JML::Graph<int, int>& graph, int source)
+{
+	long long* distances{ new long long[graph.size()] };
+	for (std::size_t i{ 0 }; i < graph.size(); ++i)
+	{
+		distances[i] = -1;
+	}
+	distances[source] = 0;
+	JML::Heap<KeyDistance, closerKey> queue;
+	queue.insert(KeyDistance{ source, 0 });
+	while (!queue.empty())
+	{
+		KeyDistance current{ queue.top() };
+		queue.pop();
+		if (current.distance != distances[current.key])
+			continue;
+
+		auto& adjacent{ graph.getAdjacent(current.key) };
+		for (auto& id : adjacent)
+		{
+			int key{ graph.key(id) };
+			long long distance{ current.distance + adjacent[id] };
+			if (distances[key] == -1 || distance < distances[key])
+			{
+				distances[key] = distance;
+				queue.insert(KeyDistance{ key, distance });
+			}
+		}
+	}
+	long long sum{ 0 };
+	for (std::size_t i{ 0 }; i < graph.size(); ++i)
+	{
+		if (distances[i] != -1)
+			sum += distances[i];
+	}
+	delete[] distances;
+	return sum;
+}
+
+// Dijkstra through edgesOf, which yields each weight with its target. Returns the sum of the distances to the reachable vertices
+long long edgesDijkstra(const JML::Graph<int, int>& graph, int source)
+{
+	long long* distances{ new long long[graph.size()] };
+	for (std::size_t i{ 0 }; i < graph.size(); ++i)
+	{
+		distances[i] = -1;
+	}
+	distances[source] = 0;
+	JML::Heap<KeyDistance, closerKey> queue;
+	queue.insert(KeyDistance{ source, 0 });
+	while (!queue.empty())
+	{
+		KeyDistance current{ queue.top() };
+		queue.pop();
+		if (current.distance != distances[current.key])
+			continue;
+
+		for (auto& [id, weight] : graph.edgesOf(current.key))
+		{
+			int key{ graph.key(id) };
+			long long distance{ current.distance + weight };
+			if (distances[key] == -1 || distance < distances[key])
+			{
+				distances[key] = distance;
+				queue.insert(KeyDistance{ key, distance });
+			}
+		}
+	}
+	long long sum{ 0 };
+	for (std::size_t i{ 0 }; i < graph.size(); ++i)
+	{
+		if (distances[i] != -1)
+			sum += distances[i];
+	}
+	delete[] distances;
+	return sum;
+}
+
+// Baseline minimum spanning forest of a symmetric graph: lazy Prim through edgesOf with a plain Heap that keeps stale entries. Returns
+// the total weight
+long long lazyPrim(const JML::Graph<int, int>& graph)
+{
+	bool* inTree{ new bool[graph.size()]{} };
+	JML::Heap<KeyDistance, closerKey> queue;
+	long long total{ 0 };
+	for (int root{ 0 }; root < static_cast<int>(graph.size()); ++root)
+	{
+		if (inTree[root])
+			continue;
+
+		queue.insert(KeyDistance{ root, 0 });
+		while (!queue.empty())
+		{
+			KeyDistance current{ queue.top() };
+			queue.pop();
+			if (inTree[current.key])
+				continue;
+
+			inTree[current.key] = true;
+			total += current.distance;
+			for (auto& [id, weight] : graph.edgesOf(current.key))
+			{
+				int key{ graph.key(id) };
+				if (!inTree[key])
+					queue.insert(KeyDistance{ key, weight });
+			}
+		}
+	}
+	delete[] inTree;
+	return total;
+}
+
+bool lighterEdge(const JML::GraphEdge<std::uint32_t>& edge1, const JML::GraphEdge<std::uint32_t>& edge2)
+{
+	return edge1.weight < edge2.weight;
+}
+
+// Baseline Kruskal over a CSR snapshot that orders the edges by popping them from a Heap instead of radix sorting. Returns the total weight
+long long heapKruskal(const JML::CsrGraph<int, int>& graph)
+{
+	JML::Heap<JML::GraphEdge<std::uint32_t>, lighterEdge> edges{ graph.edgeCount() };
+	for (std::uint32_t id{ 0 }; id < graph.size(); ++id)
+	{
+		for (std::size_t edge{ graph.offsetArray()[id] }; edge < graph.offsetArray()[id + 1]; ++edge)
+		{
+			edges.insert(JML::GraphEdge<std::uint32_t>{ id, graph.targetArray()[edge], graph.weightArray()[edge] });
+		}
+	}
+	JML::UnionFind sets{ graph.size() };
+	long long total{ 0 };
+	while (!edges.empty())
+	{
+		if (sets.unite(edges.top().from, edges.top().to))
+			total += edges.top().weight;
+		edges.pop();
+	}
+	return total;
+}
+
+// Compares traversals through getAdjacent with traversals over a frozen CSR snapshot
+void benchmarkCsr(const JML::Graph<int, int>& graph)
+{
+	std::cout << "CSR snapshot vs getAdjacent:\n";
+	auto start{ std::chrono::steady_clock::now() };
+	JML::CsrGraph<int, int> frozen{ graph.freeze() };
+	std::cout << "  freeze: " << elapsed(start) << " ms\n";
+
+	start = std::chrono::steady_clock::now();
+	std::size_t reached{ adjacentBfs(graph, 0) };
+	std::cout << "  getAdjacent BFS: " << elapsed(start) << " ms (" << reached << " reached)\n";
+
+	std::uint32_t* order{ new std::uint32_t[frozen.size()] };
+	start = std::chrono::steady_clock::now();
+	reached = frozen.bfs(frozen.id(0), order);
+	std::cout << "  CSR BFS: " << elapsed(start) << " ms (" << reached << " reached)\n";
+
+	start = std::chrono::steady_clock::now();
+	reached = frozen.dfs(frozen.id(0), order);
+	std::cout << "  CSR DFS: " << elapsed(start) << " ms (" << reached << " reached)\n";
+	delete[] order;
+
+	start = std::chrono::steady_clock::now();
+	long long checksum{ adjacentDijkstra(graph, 0) };
+	std::cout << "  getAdjacent Dijkstra: " << elapsed(start) << " ms (checksum " << checksum << ")\n";
+
+	start = std::chrono::steady_clock::now();
+	checksum = edgesDijkstra(graph, 0);
+	std::cout << "  edgesOf Dijkstra: " << elapsed(start) << " ms (checksum " << checksum << ")\n";
+
+	long long* distances{ new long long[frozen.size()] };
+	start = std::chrono::steady_clock::now();
+	frozen.dijkstra(frozen.id(0), distances);
+	std::cout << "  CSR Dijkstra: " << elapsed(start) << " ms";
+	checksum = 0;
+	for (std::size_t i{ 0 }; i < frozen.size(); ++i)
+	{
+		if (distances[i] != JML::CsrGraph<int, int>::UNREACHABLE)
+			checksum += distances[i];
+	}
+	std::cout << " (checksum " << checksum << ")\n";
+	delete[] distances;
+}
+
+// Times the library algorithms, which include the cost of freezing the graph, against the hand-rolled getAdjacent versions
+void benchmarkAlgorithms(const JML::Graph<int, int>& graph)
+{
+	std::cout << "Library algorithms (including freeze) vs hand-rolled getAdjacent traversals:\n";
+	auto start{ std::chrono::steady_clock::now() };
+	std::size_t reached{ adjacentBfs(graph, 0) };
+	std::cout << "  getAdjacent BFS: " << elapsed(start) << " ms (" << reached << " reached)\n";
+
+	start = std::chrono::steady_clock::now();
+	reached = 0;
+	JML::bfs(graph, 0, [&reached](const int&) { ++reached; });
+	std::cout << "  bfs: " << elapsed(start) << " ms (" << reached << " reached)\n";
+
+	start = std::chrono::steady_clock::now();
+	reached = 0;
+	JML::dfs(graph, 0, [&reached](const int&) { ++reached; });
+	std::cout << "  dfs: " << elapsed(start) << " ms (" << reached << " reached)\n";
+
+	start = std::chrono::steady_clock::now();
+	long long checksum{ adjacentDijkstra(graph, 0) };
+	std::cout << "  getAdjacent Dijkstra: " << elapsed(start) << " ms (checksum " << checksum << ")\n";
+
+	start = std::chrono::steady_clock::now();
+	JML::HashTable<int, long long> distances{ JML::dijkstra(graph, 0) };
+	std::cout << "  dijkstra: " << elapsed(start) << " ms";
+	checksum = 0;
+	for (const int& key : distances)
+	{
+		checksum += distances[key];
+	}
+	std::cout << " (checksum " << checksum << ")\n";
+
+	start = std::chrono::steady_clock::now();
+	JML::HashTable<int, std::size_t> components;
+	std::size_t numComponents{ JML::connectedComponents(graph, components) };
+	std::cout << "  connectedComponents: " << elapsed(start) << " ms (" << numComponents << " components)\n";
+
+	// Topological sorting needs a DAG, so using a copy with every edge pointing from the smaller key to the larger one
+	JML::Graph<int, int> dag;
+	for (int i{ 0 }; i < static_cast<int>(graph.size()); ++i)
+	{
+		dag.addVertex(i, i);
+	}
+	for (int i{ 0 }; i < static_cast<int>(graph.size()); ++i)
+	{
+		for (const JML::VertexId& id : graph.getAdjacent(i))
+		{
+			int key{ graph.key(id) };
+			if (i < key)
+				dag.addEdge(i, key, 1);
+		}
+	}
+	int* order{ new int[dag.size()] };
+	start = std::chrono::steady_clock::now();
+	bool sorted{ JML::topologicalSort(dag, order) };
+	std::cout << "  topologicalSort: " << elapsed(start) << " ms (" << (sorted ? "sorted" : "cycle found") << ")\n";
+	delete[] order;
+}
+
+// Removes vertices from graphs with and without the incoming edge index
+void benchmarkRemoveVertex()
+{
+	constexpr int CHURN_VERTICES{ 100000 };
+	constexpr int CHURN_EDGES{ 1000000 };
+	constexpr int NUM_REMOVALS{ 100 };
+	std::cout << "Removing " << NUM_REMOVALS << " of " << CHURN_VERTICES << " vertices (" << CHURN_EDGES << " edges):\n";
+	for (JML::GraphOptions options : { JML::GraphOptions::None, JML::GraphOptions::TrackIncoming })
+	{
+		JML::Graph<int, int> graph{ makeRandomGraph(CHURN_VERTICES, CHURN_EDGES, 2, options) };
+		auto start{ std::chrono::steady_clock::now() };
+		for (int i{ 0 }; i < NUM_REMOVALS; ++i)
+		{
+			graph.removeVertex(i * (CHURN_VERTICES / NUM_REMOVALS));
+		}
+		std::cout << "  " << (options == JML::GraphOptions::TrackIncoming ? "with" : "without") << " incoming index: " << elapsed(start) << " ms\n";
+	}
+}
+
+// Times an R-MAT graph of undirected friendships stored three ways: as a directed graph given every edge both ways, the same with an
+// incoming index so that removeVertex takes time proportional to the degree, and as an undirected graph. Reports the edge table links
+// each one keeps and the time to remove the same vertices from it
+void benchmarkUndirected()
+{
+	constexpr int SOCIAL_SCALE{ 19 };
+	constexpr int NUM_REMOVALS{ 100 };
+	int numVertices{ 1 << SOCIAL_SCALE };
+	long long numEdges{ static_cast<long long>(numVertices) * RMAT_EDGE_FACTOR };
+	std::cout << "Undirected R-MAT graph with " << numVertices << " vertices and " << numEdges << " edges before duplicates:\n";
+	const char* names[]{ "directed, both ways", "directed, both ways, incoming index", "undirected" };
+	std::size_t linkSize{ sizeof(JML::KeyValue<JML::VertexId, int>) + sizeof(void*) };
+	for (int version{ 0 }; version < 3; ++version)
+	{
+		std::mt19937 generator{ 13 };
+		auto start{ std::chrono::steady_clock::now() };
+		JML::Graph<int, int> graph{ version == 1 ? JML::GraphOptions::TrackIncoming : version == 2 ? JML::GraphOptions::Undirected : JML::GraphOptions::None };
+		graph.reserve(numVertices);
+		for (int i{ 0 }; i < numVertices; ++i)
+		{
+			graph.addVertex(i, i);
+		}
+		for (long long i{ 0 }; i < numEdges; ++i)
+		{
+			int from{ 0 };
+			int to{ 0 };
+			rmatEdge(SOCIAL_SCALE, generator, from, to);
+			graph.addEdge(from, to, 1);
+			if (graph.directed())
+				graph.addEdge(to, from, 1);
+		}
+		long long buildTime{ elapsed(start) };
+		std::size_t links{ 0 };
+		for (std::uint32_t index{ 0 }; index < graph.idBound(); ++index)
+		{
+			links += graph.getAdjacent(JML::VertexId{ index }).size();
+			if (version == 1)
+				links += graph.getIncoming(JML::VertexId{ index }).size();
+		}
+		start = std::chrono::steady_clock::now();
+		for (int i{ 0 }; i < NUM_REMOVALS; ++i)
+		{
+			graph.removeVertex(i * (numVertices / NUM_REMOVALS));
+		}
+		std::cout << "  " << names[version] << ": build " << buildTime << " ms, " << links << " edge table links (" << links * linkSize / (1 << 20)
+			<< " MB), " << NUM_REMOVALS << " removals " << elapsed(start) << " ms\n";
+	}
+}
+
+// Times a breadth-first search over a string-keyed graph through the key overloads, which hash every key, and through the id overloads
+void benchmarkIdAccess()
+{
+	constexpr int STRING_VERTICES{ 200000 };
+	constexpr int STRING_EDGES{ 2000000 };
+	std::cout << "String-keyed graph with " << STRING_VERTICES << " vertices and " << STRING_EDGES << " edges:\n";
+	JML::Graph<std::string, int> graph;
+	std::string* keys{ new std::string[STRING_VERTICES] };
+	for (int i{ 0 }; i < STRING_VERTICES; ++i)
+	{
+		keys[i] = "vertex/" + std::to_string(i) + "/with-a-longer-key";
+		graph.addVertex(keys[i], i);
+	}
+	std::mt19937 generator{ 5 };
+	std::uniform_int_distribution<int> vertexDistribution{ 0, STRING_VERTICES - 1 };
+	for (int i{ 0 }; i < STRING_EDGES; ++i)
+	{
+		graph.addEdge(keys[vertexDistribution(generator)], keys[vertexDistribution(generator)], 1);
+	}
+
+	auto start{ std::chrono::steady_clock::now() };
+	JML::HashTable<std::string, bool> visitedKeys{ STRING_VERTICES };
+	std::string* keyQueue{ new std::string[STRING_VERTICES] };
+	std::size_t head{ 0 };
+	std::size_t tail{ 0 };
+	keyQueue[tail++] = keys[0];
+	visitedKeys[keys[0]] = true;
+	while (head < tail)
+	{
+		for (const JML::VertexId& id : graph.getAdjacent(keyQueue[head++]))
+		{
+			const std::string& key{ graph.key(id) };
+			if (!visitedKeys.contains(key))
+			{
+				visitedKeys[key] = true;
+				keyQueue[tail++] = key;
+			}
+		}
+	}
+	std::cout << "  BFS by key: " << elapsed(start) << " ms (" << tail << " reached)\n";
+	delete[] keyQueue;
+
+	start = std::chrono::steady_clock::now();
+	bool* visited{ new bool[graph.idBound()]{} };
+	JML::VertexId* idQueue{ new JML::VertexId[graph.idBound()] };
+	head = 0;
+	tail = 0;
+	idQueue[tail++] = graph.id(keys[0]);
+	visited[idQueue[0].index] = true;
+	while (head < tail)
+	{
+		for (const JML::VertexId& id : graph.getAdjacent(idQueue[head++]))
+		{
+			if (!visited[id.index])
+			{
+				visited[id.index] = true;
+				idQueue[tail++] = id;
+			}
+		}
+	}
+	std::cout << "  BFS by id: " << elapsed(start) << " ms (" << tail << " reached)\n";
+	delete[] idQueue;
+	delete[] visited;
+	delete[] keys;
+}
+
+// Times loading the same vertices and edges one call at a time and through the batch methods
+void benchmarkBatchLoad()
+{
+	constexpr int LOAD_VERTICES{ 1000000 };
+	constexpr int LOAD_EDGES{ 5000000 };
+	std::cout << "Loading " << LOAD_VERTICES << " vertices and " << LOAD_EDGES << " edges:\n";
+	int* keys{ new int[LOAD_VERTICES] };
+	for (int i{ 0 }; i < LOAD_VERTICES; ++i)
+	{
+		keys[i] = i;
+	}
+	JML::GraphEdge<int>* edges{ new JML::GraphEdge<int>[LOAD_EDGES] };
+	std::mt19937 generator{ 4 };
+	std::uniform_int_distribution<int> vertexDistribution{ 0, LOAD_VERTICES - 1 };
+	std::uniform_int_distribution<int> weightDistribution{ 1, MAX_WEIGHT };
+	for (int i{ 0 }; i < LOAD_EDGES; ++i)
+	{
+		edges[i] = JML::GraphEdge<int>{ vertexDistribution(generator), vertexDistribution(generator), weightDistribution(generator) };
+	}
+
+	for (JML::GraphOptions options : { JML::GraphOptions::None, JML::GraphOptions::TrackIncoming })
+	{
+		auto start{ std::chrono::steady_clock::now() };
+		{
+			JML::Graph<int, int> graph{ options };
+			for (int i{ 0 }; i < LOAD_VERTICES; ++i)
+			{
+				graph.addVertex(keys[i], keys[i]);
+			}
+			for (int i{ 0 }; i < LOAD_EDGES; ++i)
+			{
+				graph.addEdge(edges[i].from, edges[i].to, edges[i].weight);
+			}
+			std::cout << "  addVertex/addEdge" << (options == JML::GraphOptions::TrackIncoming ? " with incoming index: " : ": ") << elapsed(start) << " ms\n";
+		}
+
+		start = std::chrono::steady_clock::now();
+		{
+			JML::Graph<int, int> graph{ options };
+			graph.addVertices(keys, keys, LOAD_VERTICES);
+			graph.addEdges(edges, LOAD_EDGES);
+			std::cout << "  addVertices/addEdges" << (options == JML::GraphOptions::TrackIncoming ? " with incoming index: " : ": ") << elapsed(start) << " ms\n";
+		}
+	}
+	delete[] edges;
+	delete[] keys;
+}
+
+// Times saving the graph to a binary file, loading it back into a mutable graph and mapping it as a read-only view
+void benchmarkGraphFile(const JML::Graph<int, int>& graph)
+{
+	const char* path{ "benchmark_graph.bin" };
+	std::cout << "Binary graph file:\n";
+	auto start{ std::chrono::steady_clock::now() };
+	JML::saveGraph(graph, path);
+	std::cout << "  save: " << elapsed(start) << " ms\n";
+
+	start = std::chrono::steady_clock::now();
+	{
+		JML::Graph<int, int> loaded{ JML::loadGraph<int, int>(path) };
+		std::cout << "  load into Graph: " << elapsed(start) << " ms (" << loaded.size() << " vertices)\n";
+	}
+
+	start = std::chrono::steady_clock::now();
+	{
+		JML::MappedGraph<int, int> mapped{ path };
+		std::size_t degree{ mapped.degree(mapped.id(0)) };
+		std::cout << "  map and look up a key: " << elapsed(start) << " ms (" << mapped.edgeCount() << " edges, degree of 0 is " << degree << ")\n";
+	}
+	std::remove(path);
+}
+
+// Times the direction-optimizing parallel BFS on an R-MAT graph against the serial CSR BFS for growing thread counts
+void benchmarkParallelBfs()
+{
+	std::cout << "Parallel BFS on an R-MAT graph with " << (1 << RMAT_SCALE) << " vertices and " << (1 << RMAT_SCALE) * RMAT_EDGE_FACTOR << " edges:\n";
+	JML::CsrGraph<int, int> frozen{ makeRmatGraph(RMAT_SCALE, RMAT_EDGE_FACTOR, 3).freeze() };
+	auto start{ std::chrono::steady_clock::now() };
+	JML::CsrGraph<int, int> transposed{ frozen.transpose() };
+	std::cout << "  transpose: " << elapsed(start) << " ms\n";
+
+	// Vertex 0 gets the most edges from the R-MAT quadrant skew, so it's in the giant component
+	std::uint32_t* order{ new std::uint32_t[frozen.size()] };
+	start = std::chrono::steady_clock::now();
+	std::size_t reached{ frozen.bfs(0, order) };
+	std::cout << "  serial CSR BFS: " << elapsed(start) << " ms (" << reached << " reached)\n";
+	delete[] order;
+
+	std::uint32_t* levels{ new std::uint32_t[frozen.size()] };
+	std::size_t maxThreads{ std::thread::hardware_concurrency() > 16 ? std::thread::hardware_concurrency() : 16 };
+	for (std::size_t numThreads{ 1 }; numThreads <= maxThreads; numThreads *= 2)
+	{
+		JML::ThreadPool pool{ numThreads };
+		start = std::chrono::steady_clock::now();
+		reached = JML::parallelBfs(frozen, transposed, 0, levels, pool);
+		std::cout << "  parallel BFS, " << numThreads << " threads: " << elapsed(start) << " ms (" << reached << " reached)\n";
+	}
+	delete[] levels;
+}
+
+// Times parallel delta-stepping against the serial CSR Dijkstra for growing thread counts
+void benchmarkDeltaStepping(const JML::Graph<int, int>& graph)
+{
+	std::cout << "Delta-stepping vs CSR Dijkstra:\n";
+	JML::CsrGraph<int, int> frozen{ graph.freeze() };
+	long long* distances{ new long long[frozen.size()] };
+	auto checksum{ [&]()
+		{
+			long long sum{ 0 };
+			for (std::size_t i{ 0 }; i < frozen.size(); ++i)
+			{
+				if (distances[i] != JML::CsrGraph<int, int>::UNREACHABLE)
+					sum += distances[i];
+			}
+			return sum;
+		} };
+	auto start{ std::chrono::steady_clock::now() };
+	frozen.dijkstra(frozen.id(0), distances);
+	long long time{ elapsed(start) };
+	std::cout << "  CSR Dijkstra: " << time << " ms (checksum " << checksum() << ")\n";
+
+	std::size_t maxThreads{ std::thread::hardware_concurrency() > 16 ? std::thread::hardware_concurrency() : 16 };
+	for (std::size_t numThreads{ 1 }; numThreads <= maxThreads; numThreads *= 2)
+	{
+		JML::ThreadPool pool{ numThreads };
+		start = std::chrono::steady_clock::now();
+		JML::deltaStepping(frozen, frozen.id(0), distances, pool);
+		time = elapsed(start);
+		std::cout << "  delta-stepping, " << numThreads << " threads: " << time << " ms (checksum " << checksum() << ")\n";
+	}
+	delete[] distances;
+}
+
+// Times strongly connected components, cycle detection and condensation on a graph whose long chain would overflow a recursive DFS
+void benchmarkScc()
+{
+	constexpr int SCC_VERTICES{ 10000000 };
+	constexpr int SCC_RANDOM_EDGES{ 10000000 };
+	constexpr int SCC_BACK_EDGES{ 1000 };
+	std::cout << "Strongly connected components of a " << SCC_VERTICES << "-vertex chain with " << SCC_BACK_EDGES << " back edges and "
+		<< SCC_RANDOM_EDGES << " random forward edges:\n";
+	int* keys{ new int[SCC_VERTICES] };
+	for (int i{ 0 }; i < SCC_VERTICES; ++i)
+	{
+		keys[i] = i;
+	}
+	constexpr int SCC_EDGES{ SCC_VERTICES - 1 + SCC_BACK_EDGES + SCC_RANDOM_EDGES };
+	JML::GraphEdge<int>* edges{ new JML::GraphEdge<int>[SCC_EDGES] };
+	std::mt19937 generator{ 5 };
+	std::uniform_int_distribution<int> vertexDistribution{ 0, SCC_VERTICES - 1 };
+	std::uniform_int_distribution<int> weightDistribution{ 1, MAX_WEIGHT };
+	int numEdges{ 0 };
+	for (int i{ 0 }; i + 1 < SCC_VERTICES; ++i)
+	{
+		edges[numEdges++] = JML::GraphEdge<int>{ i, i + 1, weightDistribution(generator) };
+	}
+	for (int i{ 0 }; i < SCC_BACK_EDGES + SCC_RANDOM_EDGES; ++i)
+	{
+		// Back edges close cycles along the chain and random edges point forward, so the components stay intervals of the chain
+		int from{ vertexDistribution(generator) };
+		int to{ vertexDistribution(generator) };
+		if ((i < SCC_BACK_EDGES) != (from > to))
+		{
+			int swap{ from };
+			from = to;
+			to = swap;
+		}
+		edges[numEdges++] = JML::GraphEdge<int>{ from, to, weightDistribution(generator) };
+	}
+	JML::Graph<int, int> graph;
+	graph.addVertices(keys, keys, SCC_VERTICES);
+	graph.addEdges(edges, SCC_EDGES);
+	delete[] edges;
+	delete[] keys;
+
+	auto start{ std::chrono::steady_clock::now() };
+	JML::HashTable<int, std::size_t> components;
+	std::size_t numComponents{ JML::stronglyConnectedComponents(graph, components) };
+	std::cout << "  Graph SCC: " << elapsed(start) << " ms (" << numComponents << " components)\n";
+
+	JML::CsrGraph<int, int> frozen{ graph.freeze() };
+	std::uint32_t* csrComponents{ new std::uint32_t[frozen.size()] };
+	start = std::chrono::steady_clock::now();
+	numComponents = frozen.stronglyConnectedComponents(csrComponents);
+	std::cout << "  CSR SCC: " << elapsed(start) << " ms (" << numComponents << " components)\n";
+
+	start = std::chrono::steady_clock::now();
+	bool cyclic{ frozen.hasCycle() };
+	std::cout << "  CSR hasCycle: " << elapsed(start) << " ms (" << (cyclic ? "cyclic" : "acyclic") << ")\n";
+
+	start = std::chrono::steady_clock::now();
+	JML::CsrGraph<std::uint32_t, std::uint32_t> condensed{ frozen.condensation(csrComponents, numComponents) };
+	std::cout << "  CSR condensation: " << elapsed(start) << " ms (" << condensed.edgeCount() << " edges)\n";
+	delete[] csrComponents;
+}
+
+// Times minimum spanning forests of a symmetric similarity graph against the lazy Prim and heap-sorted Kruskal baselines
+void benchmarkSpanningTree()
+{
+	constexpr int MST_VERTICES{ 1000000 };
+	constexpr int MST_EDGES{ 5000000 };  // Each one is added in both directions
+	std::cout << "Minimum spanning forest of a symmetric graph with " << MST_VERTICES << " vertices and " << MST_EDGES << " edge pairs:\n";
+	int* keys{ new int[MST_VERTICES] };
+	for (int i{ 0 }; i < MST_VERTICES; ++i)
+	{
+		keys[i] = i;
+	}
+	JML::GraphEdge<int>* edges{ new JML::GraphEdge<int>[2 * MST_EDGES] };
+	std::mt19937 generator{ 6 };
+	std::uniform_int_distribution<int> vertexDistribution{ 0, MST_VERTICES - 1 };
+	std::uniform_int_distribution<int> weightDistribution{ 1, 1000000 };
+	for (int i{ 0 }; i < MST_EDGES; ++i)
+	{
+		int from{ vertexDistribution(generator) };
+		int to{ vertexDistribution(generator) };
+		int weight{ weightDistribution(generator) };
+		edges[2 * i] = JML::GraphEdge<int>{ from, to, weight };
+		edges[2 * i + 1] = JML::GraphEdge<int>{ to, from, weight };
+	}
+	JML::Graph<int, int> graph;
+	graph.addVertices(keys, keys, MST_VERTICES);
+	graph.addEdges(edges, 2 * MST_EDGES);
+	delete[] edges;
+	delete[] keys;
+
+	auto start{ std::chrono::steady_clock::now() };
+	long long total{ lazyPrim(graph) };
+	std::cout << "  lazy Prim through edgesOf: " << elapsed(start) << " ms (weight " << total << ")\n";
+
+	JML::CsrGraph<int, int> frozen{ graph.freeze() };
+	start = std::chrono::steady_clock::now();
+	total = heapKruskal(frozen);
+	std::cout << "  Kruskal with heap-sorted edges: " << elapsed(start) << " ms (weight " << total << ")\n";
+
+	JML::GraphEdge<std::uint32_t>* tree{ new JML::GraphEdge<std::uint32_t>[frozen.size()] };
+	auto treeWeight{ [&](std::size_t treeSize)
+		{
+			long long sum{ 0 };
+			for (std::size_t i{ 0 }; i < treeSize; ++i)
+			{
+				sum += tree[i].weight;
+			}
+			return sum;
+		} };
+	std::size_t maxThreads{ std::thread::hardware_concurrency() > 16 ? std::thread::hardware_concurrency() : 16 };
+	for (std::size_t numThreads{ 1 }; numThreads <= maxThreads; numThreads *= 2)
+	{
+		JML::ThreadPool pool{ numThreads };
+		start = std::chrono::steady_clock::now();
+		std::size_t treeSize{ JML::kruskal(frozen, tree, pool) };
+		std::cout << "  Kruskal with radix sort, " << numThreads << " threads: " << elapsed(start) << " ms (weight " << treeWeight(treeSize) << ")\n";
+	}
+
+	start = std::chrono::steady_clock::now();
+	std::size_t treeSize{ JML::prim(frozen, tree) };
+	std::cout << "  Prim with IndexedHeap: " << elapsed(start) << " ms (weight " << treeWeight(treeSize) << ")\n";
+	delete[] tree;
+}
+
+// Times building, freezing and searching the same random graph with the given edge weight type, and reports the bytes every edge takes
+// in an edge table link and in the CSR arrays
+template <typename W>
+void benchmarkEdgeWeights(const char* name)
+{
+	using Weight = typename JML::EdgeWeight<W>::Stored;
+	using Distance = typename JML::EdgeWeight<W>::Distance;
+	std::cout << "Graph with " << name << " edge weights, " << NUM_VERTICES << " vertices and " << NUM_EDGES << " edges:\n";
+	std::mt19937 generator{ 7 };
+	std::uniform_int_distribution<int> vertexDistribution{ 0, NUM_VERTICES - 1 };
+	std::uniform_int_distribution<int> weightDistribution{ 1, MAX_WEIGHT };
+	auto start{ std::chrono::steady_clock::now() };
+	JML::Graph<int, int, W> graph;
+	graph.reserve(NUM_VERTICES);
+	for (int i{ 0 }; i < NUM_VERTICES; ++i)
+	{
+		graph.addVertex(i, i);
+	}
+	for (int i{ 0 }; i < NUM_EDGES; ++i)
+	{
+		int from{ vertexDistribution(generator) };
+		int to{ vertexDistribution(generator) };
+		if constexpr (std::is_void_v<W>)
+			graph.addEdge(from, to);
+		else
+			graph.addEdge(from, to, static_cast<W>(weightDistribution(generator)));
+	}
+	std::cout << "  build: " << elapsed(start) << " ms, edge table link: " << sizeof(JML::KeyValue<JML::VertexId, Weight>) + sizeof(void*)
+		<< " bytes per edge\n";
+
+	start = std::chrono::steady_clock::now();
+	JML::CsrGraph<int, int, W> frozen{ graph.freeze() };
+	std::cout << "  freeze: " << elapsed(start) << " ms, CSR arrays: " << sizeof(std::uint32_t) + (frozen.WEIGHTED ? sizeof(Weight) : 0)
+		<< " bytes per edge\n";
+
+	Distance* distances{ new Distance[frozen.size()] };
+	start = std::chrono::steady_clock::now();
+	frozen.dijkstra(frozen.id(0), distances);
+	Distance sum{ 0 };
+	for (std::size_t i{ 0 }; i < frozen.size(); ++i)
+	{
+		if (distances[i] != frozen.UNREACHABLE)
+			sum += distances[i];
+	}
+	std::cout << "  CSR Dijkstra: " << elapsed(start) << " ms (distance sum " << sum << ")\n";
+	delete[] distances;
+}
+
+// Serial push-based PageRank with one running sum per vertex, as a baseline for the pull-based engine. Runs the given number of iterations
+void pushPageRank(const JML::CsrGraph<int, int, void>& graph, double* ranks, int iterations)
+{
+	std::size_t numVerts{ graph.size() };
+	const std::size_t* offsets{ graph.offsetArray() };
+	const std::uint32_t* targets{ graph.targetArray() };
+	double* next{ new double[numVerts] };
+	for (std::size_t id{ 0 }; id < numVerts; ++id)
+	{
+		ranks[id] = 1.0 / static_cast<double>(numVerts);
+	}
+	for (int iteration{ 0 }; iteration < iterations; ++iteration)
+	{
+		double dangling{ 0 };
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			if (offsets[id] == offsets[id + 1])
+				dangling += ranks[id];
+		}
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			next[id] = (0.15 + 0.85 * dangling) / static_cast<double>(numVerts);
+		}
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			std::size_t degree{ offsets[id + 1] - offsets[id] };
+			for (std::size_t edge{ offsets[id] }; edge < offsets[id + 1]; ++edge)
+			{
+				next[targets[edge]] += 0.85 * ranks[id] / static_cast<double>(degree);
+			}
+		}
+		for (std::size_t id{ 0 }; id < numVerts; ++id)
+		{
+			ranks[id] = next[id];
+		}
+	}
+	delete[] next;
+}
+
+// Times PageRank iterations on an unweighted R-MAT graph with about 100M edges, for float and double ranks and growing thread counts, against
+// the serial push baseline. The tolerance is zero so that every run does the same number of iterations
+void benchmarkPageRank()
+{
+	constexpr int PAGERANK_SCALE{ 23 };
+	constexpr int PAGERANK_EDGE_FACTOR{ 12 };
+	constexpr int PAGERANK_ITERATIONS{ 20 };
+	constexpr std::size_t BATCH_SIZE{ 1 << 20 };
+	int numVertices{ 1 << PAGERANK_SCALE };
+	long long numEdges{ static_cast<long long>(numVertices) * PAGERANK_EDGE_FACTOR };
+	std::cout << "PageRank on an R-MAT graph with " << numVertices << " vertices and " << numEdges << " edges before duplicates:\n";
+	auto start{ std::chrono::steady_clock::now() };
+	JML::Graph<int, int, void> graph;
+	int* keys{ new int[numVertices] };
+	for (int i{ 0 }; i < numVertices; ++i)
+	{
+		keys[i] = i;
+	}
+	graph.addVertices(keys, keys, numVertices);
+	delete[] keys;
+	JML::GraphEdge<JML::VertexId, void>* batch{ new JML::GraphEdge<JML::VertexId, void>[BATCH_SIZE] };
+	std::mt19937 generator{ 8 };
+	for (long long added{ 0 }; added < numEdges; added += BATCH_SIZE)
+	{
+		std::size_t count{ numEdges - added < static_cast<long long>(BATCH_SIZE) ? static_cast<std::size_t>(numEdges - added) : BATCH_SIZE };
+		for (std::size_t i{ 0 }; i < count; ++i)
+		{
+			int from{ 0 };
+			int to{ 0 };
+			rmatEdge(PAGERANK_SCALE, generator, from, to);
+			batch[i].from = JML::VertexId{ static_cast<std::uint32_t>(from) };
+			batch[i].to = JML::VertexId{ static_cast<std::uint32_t>(to) };
+		}
+		graph.addEdges(batch, count);
+	}
+	delete[] batch;
+	JML::CsrGraph<int, int, void> frozen{ graph.freeze() };
+	graph.clear();
+	JML::CsrGraph<int, int, void> transposed{ frozen.transpose() };
+	std::cout << "  build, freeze and transpose: " << elapsed(start) << " ms (" << frozen.edgeCount() << " distinct edges)\n";
+
+	auto iterationsPerSecond{ [](std::size_t iterations, long long time)
+		{
+			return static_cast<double>(iterations) * 1000.0 / static_cast<double>(time ? time : 1);
+		} };
+	double* doubleRanks{ new double[frozen.size()] };
+	float* floatRanks{ new float[frozen.size()] };
+	start = std::chrono::steady_clock::now();
+	pushPageRank(frozen, doubleRanks, PAGERANK_ITERATIONS);
+	long long time{ elapsed(start) };
+	std::cout << "  serial push: " << iterationsPerSecond(PAGERANK_ITERATIONS, time) << " iterations/s (rank of 0: " << doubleRanks[0] << ")\n";
+
+	std::size_t maxThreads{ std::thread::hardware_concurrency() > 16 ? std::thread::hardware_concurrency() : 16 };
+	for (std::size_t numThreads{ 1 }; numThreads <= maxThreads; numThreads *= 2)
+	{
+		JML::ThreadPool pool{ numThreads };
+		start = std::chrono::steady_clock::now();
+		std::size_t iterations{ JML::pageRank(frozen, transposed, doubleRanks, pool, 0.85, 0.0, PAGERANK_ITERATIONS) };
+		time = elapsed(start);
+		std::cout << "  pull, double, " << numThreads << " threads: " << iterationsPerSecond(iterations, time) << " iterations/s (rank of 0: "
+			<< doubleRanks[0] << ")\n";
+		start = std::chrono::steady_clock::now();
+		iterations = JML::pageRank(frozen, transposed, floatRanks, pool, 0.85, 0.0, PAGERANK_ITERATIONS);
+		time = elapsed(start);
+		std::cout << "  pull, float, " << numThreads << " threads: " << iterationsPerSecond(iterations, time) << " iterations/s (rank of 0: "
+			<< floatRanks[0] << ")\n";
+	}
+
+	// Running to convergence instead, to show how much early termination saves
+	JML::ThreadPool pool{};
+	start = std::chrono::steady_clock::now();
+	std::size_t iterations{ JML::pageRank(frozen, transposed, doubleRanks, pool) };
+	std::cout << "  pull, double, tolerance 1e-6: " << iterations << " iterations in " << elapsed(start) << " ms\n";
+	delete[] doubleRanks;
+	delete[] floatRanks;
+}
+
+// Times DynamicShortestPaths repairing a road-like grid through random edge updates against rerunning CSR Dijkstra after every update
+void benchmarkDynamicPaths()
+{
+	constexpr int GRID_SIDE{ 1000 };
+	constexpr int UPDATES{ 2000 };
+	constexpr int RECOMPUTES{ 20 };  // Full recomputations are timed for fewer updates and scaled up
+	std::cout << "Shortest paths on a " << GRID_SIDE << " x " << GRID_SIDE << " grid through " << UPDATES << " edge updates:\n";
+	std::mt19937 generator{ 9 };
+	JML::Graph<int, int> graph{ makeGridGraph(GRID_SIDE, generator, JML::GraphOptions::TrackIncoming) };
+	std::uniform_int_distribution<int> weightDistribution{ 1, MAX_WEIGHT };
+
+	// Every update reweights, removes or restores a random edge of the grid
+	std::uniform_int_distribution<int> vertexDistribution{ 0, GRID_SIDE * GRID_SIDE - 1 };
+	std::uniform_int_distribution<int> kindDistribution{ 0, 2 };
+	auto update{ [&](auto&& addEdge, auto&& removeEdge)
+		{
+			int from{ vertexDistribution(generator) };
+			int to{ from % GRID_SIDE + 1 < GRID_SIDE ? from + 1 : from - 1 };
+			if (kindDistribution(generator) == 0)
+				removeEdge(from, to);
+			else
+				addEdge(from, to, weightDistribution(generator));
+		} };
+
+	auto start{ std::chrono::steady_clock::now() };
+	JML::DynamicShortestPaths<int, int> paths{ graph, 0 };
+	std::cout << "  initial Dijkstra: " << elapsed(start) << " ms\n";
+	std::size_t totalRepaired{ 0 };
+	start = std::chrono::steady_clock::now();
+	for (int i{ 0 }; i < UPDATES; ++i)
+	{
+		update([&](int from, int to, int weight) { paths.addEdge(from, to, weight); }, [&](int from, int to) { paths.removeEdge(from, to); });
+		totalRepaired += paths.lastRepairSize();
+	}
+	long long time{ elapsed(start) };
+	std::cout << "  incremental repairs: " << time << " ms (" << totalRepaired / UPDATES << " vertices repaired per update, distance to the far "
+		<< "corner " << paths.distance(GRID_SIDE * GRID_SIDE - 1) << ")\n";
+
+	long long* distances{ new long long[GRID_SIDE * GRID_SIDE] };
+	start = std::chrono::steady_clock::now();
+	for (int i{ 0 }; i < RECOMPUTES; ++i)
+	{
+		update([&](int from, int to, int weight) { graph.addEdge(from, to, weight); }, [&](int from, int to) { graph.removeEdge(from, to); });
+		JML::CsrGraph<int, int> frozen{ graph.freeze() };
+		frozen.dijkstra(frozen.id(0), distances);
+	}
+	time = elapsed(start);
+	std::cout << "  freezing and rerunning CSR Dijkstra: " << time * UPDATES / RECOMPUTES << " ms (scaled from " << RECOMPUTES << " updates)\n";
+	delete[] distances;
+}
+
+// Times point-to-point queries on a road-like grid: a full Dijkstra per query through the key-based library call, and PathSearch with
+// bidirectional Dijkstra, A* with no estimate (Dijkstra that stops at the target) and A* with the Manhattan distance, which never
+// overestimates because every edge weighs at least 1. Queries run between random cells and between cells at most NEARBY rows and columns
+// apart, where making a new PathSearch per query costs more than the search itself
+void benchmarkPathSearch()
+{
+	constexpr int GRID_SIDE{ 1000 };
+	constexpr int NEARBY{ 20 };
+	constexpr int QUERIES{ 50 };
+	constexpr int FULL_QUERIES{ 5 };  // Full Dijkstra runs are timed for fewer queries
+	std::cout << "Point-to-point queries on a " << GRID_SIDE << " x " << GRID_SIDE << " grid:\n";
+	std::mt19937 generator{ 12 };
+	JML::Graph<int, int> graph{ makeGridGraph(GRID_SIDE, generator, JML::GraphOptions::TrackIncoming) };
+	std::uniform_int_distribution<int> vertexDistribution{ 0, GRID_SIDE * GRID_SIDE - 1 };
+	std::uniform_int_distribution<int> offsetDistribution{ -NEARBY, NEARBY };
+	int sources[QUERIES]{};
+	int targets[QUERIES]{};
+
+	auto start{ std::chrono::steady_clock::now() };
+	long long checksum{ 0 };
+	for (int i{ 0 }; i < FULL_QUERIES; ++i)
+	{
+		checksum += JML::dijkstra(graph, vertexDistribution(generator))[vertexDistribution(generator)];
+	}
+	std::cout << "  full Dijkstra: " << elapsed(start) / FULL_QUERIES << " ms per query (checksum " << checksum << ")\n";
+
+	JML::PathSearch<int, int> search;
+	auto report{ [&](const char* name, auto&& query)
+		{
+			long long total{ 0 };
+			std::size_t settled{ 0 };
+			auto start{ std::chrono::steady_clock::now() };
+			for (int i{ 0 }; i < QUERIES; ++i)
+			{
+				total += query(sources[i], targets[i]);
+				settled += search.lastSettledCount();
+			}
+			std::cout << "    " << name << ": " << static_cast<double>(elapsed(start)) / QUERIES << " ms per query, " << settled / QUERIES
+				<< " vertices settled per query (distance sum " << total << ")\n";
+		} };
+	auto manhattan{ [](int key, int target)
+		{
+			int rows{ key / GRID_SIDE - target / GRID_SIDE };
+			int columns{ key % GRID_SIDE - target % GRID_SIDE };
+			return (rows < 0 ? -rows : rows) + (columns < 0 ? -columns : columns);
+		} };
+	for (bool nearby : { false, true })
+	{
+		for (int i{ 0 }; i < QUERIES; ++i)
+		{
+			sources[i] = vertexDistribution(generator);
+			targets[i] = vertexDistribution(generator);
+			if (nearby)
+			{
+				int row{ sources[i] / GRID_SIDE + offsetDistribution(generator) };
+				int column{ sources[i] % GRID_SIDE + offsetDistribution(generator) };
+				row = row < 0 ? 0 : (row >= GRID_SIDE ? GRID_SIDE - 1 : row);
+				column = column < 0 ? 0 : (column >= GRID_SIDE ? GRID_SIDE - 1 : column);
+				targets[i] = row * GRID_SIDE + column;
+			}
+		}
+		std::cout << (nearby ? "  Nearby cells:\n" : "  Random cells:\n");
+		report("bidirectional Dijkstra", [&](int source, int target) { return search.shortestPath(graph, source, target); });
+		report("A* with no estimate", [&](int source, int target)
+			{
+				return search.shortestPath(graph, source, target, [](int) { return 0; });
+			});
+		report("A* with Manhattan distance", [&](int source, int target)
+			{
+				return search.shortestPath(graph, source, target, [&](int key) { return manhattan(key, target); });
+			});
+
+		start = std::chrono::steady_clock::now();
+		for (int i{ 0 }; i < QUERIES; ++i)
+		{
+			JML::PathSearch<int, int> fresh;
+			fresh.shortestPath(graph, sources[i], targets[i]);
+		}
+		std::cout << "    bidirectional Dijkstra, new PathSearch per query: " << static_cast<double>(elapsed(start)) / QUERIES << " ms per query\n";
+	}
+}
+
+// Times CSR BFS, Dijkstra and PageRank over one labeling of a snapshot
+void timeTraversals(const char* name, const JML::CsrGraph<int, int>& frozen, const JML::CsrGraph<int, int>& transposed, JML::ThreadPool& pool)
+{
+	constexpr std::size_t PAGERANK_ITERATIONS{ 10 };
+	std::uint32_t* order{ new std::uint32_t[frozen.size()] };
+	long long* distances{ new long long[frozen.size()] };
+	double* ranks{ new double[frozen.size()] };
+	auto start{ std::chrono::steady_clock::now() };
+	std::size_t reached{ frozen.bfs(frozen.id(0), order) };
+	long long bfsTime{ elapsed(start) };
+	start = std::chrono::steady_clock::now();
+	frozen.dijkstra(frozen.id(0), distances);
+	long long dijkstraTime{ elapsed(start) };
+	start = std::chrono::steady_clock::now();
+	JML::pageRank(frozen, transposed, ranks, pool, 0.85, 0.0, PAGERANK_ITERATIONS);
+	std::cout << "  " << name << ": BFS " << bfsTime << " ms, Dijkstra " << dijkstraTime << " ms, " << PAGERANK_ITERATIONS << " PageRank iterations "
+		<< elapsed(start) << " ms (" << reached << " reached)\n";
+	delete[] order;
+	delete[] distances;
+	delete[] ranks;
+}
+
+// Compares traversals of snapshots whose ids were shuffled, as if the vertices had been added in random order, against the same snapshots
+// relabeled by each locality order, and the edge cut of contiguous blocks of ids against label propagation
+void benchmarkReordering()
+{
+	constexpr int GRID_SIDE{ 1500 };
+	constexpr std::size_t NUM_PARTS{ 16 };
+	using Order = void (*)(const JML::CsrGraph<int, int>&, const JML::CsrGraph<int, int>&, std::uint32_t*);
+	const char* orderNames[]{ "BFS order", "reverse Cuthill-McKee", "degree order" };
+	Order orders[]{ JML::bfsOrder<int, int, int>, JML::reverseCuthillMcKeeOrder<int, int, int>, JML::degreeOrder<int, int, int> };
+	JML::ThreadPool pool{ 1 };
+	std::mt19937 generator{ 10 };
+	for (bool grid : { true, false })
+	{
+		if (grid)
+			std::cout << "Reordering a " << GRID_SIDE << " x " << GRID_SIDE << " grid with shuffled ids:\n";
+		else
+			std::cout << "Reordering an R-MAT graph with " << (1 << RMAT_SCALE) << " vertices and shuffled ids:\n";
+		JML::CsrGraph<int, int> frozen{ (grid ? makeGridGraph(GRID_SIDE, generator) : makeRmatGraph(RMAT_SCALE, RMAT_EDGE_FACTOR, 11)).freeze() };
+		std::uint32_t* order{ new std::uint32_t[frozen.size()] };
+		for (std::uint32_t id{ 0 }; id < frozen.size(); ++id)
+		{
+			order[id] = id;
+		}
+		for (std::uint32_t i{ static_cast<std::uint32_t>(frozen.size()) }; i > 1; --i)
+		{
+			std::uint32_t swap{ order[i - 1] };
+			std::uint32_t other{ std::uniform_int_distribution<std::uint32_t>{ 0, i - 1 }(generator) };
+			order[i - 1] = order[other];
+			order[other] = swap;
+		}
+		JML::CsrGraph<int, int> shuffled{ frozen.relabel(order) };
+		JML::CsrGraph<int, int> shuffledTransposed{ shuffled.transpose() };
+		timeTraversals("shuffled ids", shuffled, shuffledTransposed, pool);
+
+		std::uint32_t* parts{ new std::uint32_t[frozen.size()] };
+		std::size_t blockCut{ JML::partition(shuffled, shuffledTransposed, NUM_PARTS, parts, 0.03, 0) };
+		auto start{ std::chrono::steady_clock::now() };
+		std::size_t propagatedCut{ JML::partition(shuffled, shuffledTransposed, NUM_PARTS, parts) };
+		std::cout << "  " << NUM_PARTS << " parts, shuffled ids: blocks cut " << blockCut << " edges, label propagation cuts " << propagatedCut
+			<< " in " << elapsed(start) << " ms\n";
+
+		for (std::size_t i{ 0 }; i < 3; ++i)
+		{
+			start = std::chrono::steady_clock::now();
+			orders[i](shuffled, shuffledTransposed, order);
+			JML::CsrGraph<int, int> relabeled{ shuffled.relabel(order) };
+			JML::CsrGraph<int, int> transposed{ relabeled.transpose() };
+			std::cout << "  " << orderNames[i] << " computed, relabeled and transposed in " << elapsed(start) << " ms\n";
+			timeTraversals(orderNames[i], relabeled, transposed, pool);
+			blockCut = JML::partition(relabeled, transposed, NUM_PARTS, parts, 0.03, 0);
+			propagatedCut = JML::partition(relabeled, transposed, NUM_PARTS, parts);
+			std::cout << "  " << NUM_PARTS << " parts, " << orderNames[i] << ": blocks cut " << blockCut << " edges, label propagation cuts "
+				<< propagatedCut << '\n';
+		}
+		delete[] order;
+		delete[] parts;
+	}
+}
+
+// Serial triangle count over the same ranked lists as the library, intersecting them one id at a time, as a baseline for the block merge
+std::size_t scalarTriangles(const JML::RankedAdjacency& adjacency)
+{
+	std::size_t count{ 0 };
+	for (std::uint32_t rank{ 0 }; rank < adjacency.numVerts; ++rank)
+	{
+		for (std::size_t edge{ adjacency.aboveOffsets[rank] }; edge < adjacency.aboveOffsets[rank + 1]; ++edge)
+		{
+			std::uint32_t higher{ adjacency.above[edge] };
+			std::size_t i{ adjacency.aboveOffsets[rank] };
+			std::size_t j{ adjacency.aboveOffsets[higher] };
+			while (i < adjacency.aboveOffsets[rank + 1] && j < adjacency.aboveOffsets[higher + 1])
+			{
+				if (adjacency.above[i] < adjacency.above[j])
+					++i;
+				else if (adjacency.above[j] < adjacency.above[i])
+					++j;
+				else
+				{
+					++count;
+					++i;
+					++j;
+				}
+			}
+		}
+	}
+	return count;
+}
+
+// Core numbers by peeling the vertex of fewest remaining neighbors off a heap that keeps stale entries and skips them when they come up,
+// as a baseline for the bucket peeling. Returns the degeneracy
+std::uint32_t heapCoreNumbers(const JML::RankedAdjacency& adjacency, std::uint32_t* cores)
+{
+	std::size_t* degrees{ new std::size_t[adjacency.numVerts] };
+	bool* peeled{ new bool[adjacency.numVerts]{} };
+	JML::Heap<JML::IdDegree, JML::fewerEdges> queue{ adjacency.numVerts };
+	for (std::uint32_t rank{ 0 }; rank < adjacency.numVerts; ++rank)
+	{
+		degrees[rank] = adjacency.degree(rank);
+		queue.insert(JML::IdDegree{ rank, degrees[rank] });
+	}
+	std::size_t core{ 0 };
+	while (!queue.empty())
+	{
+		JML::IdDegree next{ queue.top() };
+		queue.pop();
+		if (peeled[next.id] || next.degree != degrees[next.id])
+			continue;
+
+		peeled[next.id] = true;
+		core = next.degree > core ? next.degree : core;
+		cores[adjacency.ids[next.id]] = static_cast<std::uint32_t>(core);
+		for (const std::uint32_t* list : { adjacency.below, adjacency.above })
+		{
+			const std::size_t* offsets{ list == adjacency.below ? adjacency.belowOffsets : adjacency.aboveOffsets };
+			for (std::size_t edge{ offsets[next.id] }; edge < offsets[next.id + 1]; ++edge)
+			{
+				if (!peeled[list[edge]])
+					queue.insert(JML::IdDegree{ list[edge], --degrees[list[edge]] });
+			}
+		}
+	}
+	delete[] degrees;
+	delete[] peeled;
+	return static_cast<std::uint32_t>(core);
+}
+
+// Times triangle counting, clustering coefficients and k-cores on an R-MAT graph, whose few hubs make intersecting full neighbor lists
+// quadratic in their degree. The library keeps every edge at its end of fewer edges, and is compared against a serial scalar merge over
+// the same lists and against heap peeling
+void benchmarkCohesion()
+{
+	std::cout << "Triangles and cores of an R-MAT graph with " << (1 << RMAT_SCALE) << " vertices:\n";
+	JML::CsrGraph<int, int> frozen{ makeRmatGraph(RMAT_SCALE, RMAT_EDGE_FACTOR, 12).freeze() };
+	JML::CsrGraph<int, int> transposed{ frozen.transpose() };
+	auto start{ std::chrono::steady_clock::now() };
+	JML::RankedAdjacency adjacency{ frozen, transposed };
+	std::cout << "  ranked lists: " << elapsed(start) << " ms (" << adjacency.aboveOffsets[adjacency.numVerts] << " undirected edges)\n";
+	start = std::chrono::steady_clock::now();
+	std::size_t triangles{ scalarTriangles(adjacency) };
+	std::cout << "  serial scalar merge: " << elapsed(start) << " ms (" << triangles << " triangles)\n";
+
+	std::size_t maxThreads{ std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() : 1 };
+	for (std::size_t numThreads{ 1 }; numThreads <= maxThreads; numThreads *= 2)
+	{
+		JML::ThreadPool pool{ numThreads };
+		start = std::chrono::steady_clock::now();
+		triangles = JML::countTriangles(frozen, transposed, pool);
+		std::cout << "  countTriangles, " << numThreads << " threads: " << elapsed(start) << " ms (" << triangles << " triangles)\n";
+	}
+
+	JML::ThreadPool pool{};
+	std::size_t* perVertex{ new std::size_t[frozen.size()] };
+	start = std::chrono::steady_clock::now();
+	JML::countTriangles(frozen, transposed, perVertex, pool);
+	std::cout << "  triangles through every vertex: " << elapsed(start) << " ms (vertex 0 is in " << perVertex[0] << ")\n";
+	double* coefficients{ new double[frozen.size()] };
+	start = std::chrono::steady_clock::now();
+	JML::clusteringCoefficients(frozen, transposed, coefficients, pool);
+	std::cout << "  clustering coefficients: " << elapsed(start) << " ms (vertex 0: " << coefficients[0] << ")\n";
+
+	std::uint32_t* cores{ new std::uint32_t[frozen.size()] };
+	start = std::chrono::steady_clock::now();
+	std::uint32_t degeneracy{ heapCoreNumbers(adjacency, cores) };
+	std::cout << "  heap peeling: " << elapsed(start) << " ms (degeneracy " << degeneracy << ")\n";
+	start = std::chrono::steady_clock::now();
+	degeneracy = JML::coreNumbers(frozen, transposed, cores);
+	std::cout << "  coreNumbers: " << elapsed(start) << " ms (degeneracy " << degeneracy << ")\n";
+	delete[] perVertex;
+	delete[] coefficients;
+	delete[] cores;
+}
+
+// Counts the edges two steps out of a vertex of the snapshot, a small random read standing in for an analytics query
+long long twoHopEdges(const JML::Graph<int, int>& graph, JML::VertexId id)
+{
+	long long count{ 0 };
+	for (const auto& [target, weight] : graph.edgesOf(id))
+	{
+		count += static_cast<long long>(graph.getAdjacent(target).size());
+	}
+	return count;
+}
+
+// Times snapshots of the graph for readers: a deep copy against share() and the changes after it, which copy only what they touch. Then
+// readers run queries on the latest snapshot for a while, first with the graph left alone and then with a writer changing it and
+// publishing a snapshot every SNAPSHOT_INTERVAL changes
+void benchmarkSnapshot(const JML::Graph<int, int>& graph)
+{
+	constexpr int SNAPSHOT_INTERVAL{ 100 };
+	constexpr int RUN_MILLISECONDS{ 3000 };
+	std::cout << "Snapshots of the same graph:\n";
+	auto start{ std::chrono::steady_clock::now() };
+	JML::Graph<int, int> copy{ graph };
+	std::cout << "  copy constructor: " << elapsed(start) << " ms (" << copy.size() << " vertices)\n";
+
+	start = std::chrono::steady_clock::now();
+	JML::Graph<int, int> writer{ graph.share() };
+	std::cout << "  share: " << elapsed(start) << " ms (" << writer.size() << " vertices)\n";
+	auto microStart{ std::chrono::steady_clock::now() };
+	writer.addEdge(0, 1, 1);
+	std::cout << "  first addEdge after sharing: "
+		<< std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - microStart).count() << " us\n";
+	start = std::chrono::steady_clock::now();
+	for (int i{ 0 }; i < 1000; ++i)
+	{
+		writer.addEdge(i, i + 1, 1);
+	}
+	std::cout << "  1000 more addEdge calls: " << elapsed(start) << " ms (shared graph unchanged: " << (copy == graph) << ")\n";
+
+	unsigned int numReaders{ std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 1 };
+	std::mutex latestLock;
+	JML::GraphSnapshot<int, int> latest{ writer.snapshot() };
+	for (bool writing : { false, true })
+	{
+		std::atomic<bool> stop{ false };
+		std::atomic<long long> queries{ 0 };
+		std::atomic<long long> checksum{ 0 };
+		auto read{ [&](unsigned int seed)
+		{
+			std::mt19937 generator{ seed };
+			long long done{ 0 };
+			long long sum{ 0 };
+			while (!stop.load(std::memory_order_relaxed))
+			{
+				JML::GraphSnapshot<int, int> snapshot{};
+				{
+					std::lock_guard<std::mutex> guard{ latestLock };
+					snapshot = latest;
+				}
+				std::uniform_int_distribution<std::uint32_t> idDistribution{ 0, static_cast<std::uint32_t>(snapshot->idBound() - 1) };
+				for (int i{ 0 }; i < 100; ++i)
+				{
+					JML::VertexId id{ idDistribution(generator) };
+					if (snapshot->contains(id))
+						sum += twoHopEdges(*snapshot, id);
+				}
+				done += 100;
+			}
+			queries += done;
+			checksum += sum;
+		} };
+
+		start = std::chrono::steady_clock::now();
+		std::thread* readers{ new std::thread[numReaders] };
+		for (unsigned int i{ 0 }; i < numReaders; ++i)
+		{
+			readers[i] = std::thread{ read, i + 1 };
+		}
+		long long writes{ 0 };
+		std::mt19937 generator{ 12 };
+		std::uniform_int_distribution<int> keyDistribution{ 0, NUM_VERTICES - 1 };
+		std::uniform_int_distribution<int> weightDistribution{ 1, MAX_WEIGHT };
+		while (elapsed(start) < RUN_MILLISECONDS)
+		{
+			if (!writing)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+				continue;
+			}
+
+			// Adding an edge, removing another and changing a vertex's value, then publishing the new version now and then
+			int from{ keyDistribution(generator) };
+			writer.addEdge(from, keyDistribution(generator), weightDistribution(generator));
+			int other{ keyDistribution(generator) };
+			const JML::Graph<int, int>::EdgeTable& edges{ writer.getAdjacent(other) };
+			if (!edges.empty())
+				writer.removeEdge(writer.id(other), *edges.begin());
+			writer[keyDistribution(generator)] = static_cast<int>(generator());
+			writes += 3;
+			if (writes % (3 * SNAPSHOT_INTERVAL) == 0)
+			{
+				JML::GraphSnapshot<int, int> snapshot{ writer.snapshot() };
+				std::lock_guard<std::mutex> guard{ latestLock };
+				latest = snapshot;
+			}
+		}
+		stop = true;
+		for (unsigned int i{ 0 }; i < numReaders; ++i)
+		{
+			readers[i].join();
+		}
+		delete[] readers;
+		long long time{ elapsed(start) };
+		std::cout << "  " << numReaders << (numReaders == 1 ? " reader" : " readers") << (writing ? " under writes: " : " alone: ")
+			<< queries * 1000 / time << " queries/s";
+		if (writing)
+			std::cout << ", writer: " << writes * 1000 / time << " changes/s";
+		std::cout << " (checksum " << checksum << ")\n";
+	}
+}
+
+int main()
+{
+	std::cout << "Building a graph with " << NUM_VERTICES << " vertices and " << NUM_EDGES << " edges\n";
+	auto start{ std::chrono::steady_clock::now() };
+	JML::Graph<int, int> graph{ makeRandomGraph(NUM_VERTICES, NUM_EDGES, 1) };
+	std::cout << "  build: " << elapsed(start) << " ms\n";
+
+	benchmarkCsr(graph);
+	benchmarkAlgorithms(graph);
+	benchmarkRemoveVertex();
+	benchmarkUndirected();
+	benchmarkBatchLoad();
+	benchmarkIdAccess();
+	benchmarkGraphFile(graph);
+	benchmarkParallelBfs();
+	benchmarkDeltaStepping(graph);
+	benchmarkScc();
+	benchmarkSpanningTree();
+	benchmarkEdgeWeights<int>("int");
+	benchmarkEdgeWeights<float>("float");
+	benchmarkEdgeWeights<double>("double");
+	benchmarkEdgeWeights<void>("void");
+	benchmarkPageRank();
+	benchmarkDynamicPaths();
+	benchmarkPathSearch();
+	benchmarkReordering();
+	benchmarkCohesion();
+	benchmarkSnapshot(graph);
+	return 0;
+}
+#endif
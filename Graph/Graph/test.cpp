@@ -1,7 +1,24 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <stdexcept>
 
+#include "Cohesion.h"
+#include "CsrGraph.h"
+#include "DynamicPaths.h"
 #include "Graph.h"
+#include "GraphAlgorithms.h"
+#include "GraphFile.h"
 #include "Heap.h"
+#include "ParallelGraph.h"
+#include "PathSearch.h"
+#include "Ranking.h"
+#include "Reordering.h"
+#include "SpanningTree.h"
+#include "ThreadPool.h"
 
 struct EdgePair
 {
@@ -62,12 +79,354 @@ int main()
 		EdgePair curr{ pq.top() };
 		pq.pop();
 		std::cout << "Key: " << curr.key << " value: " << test[curr.key] << '\n';
-		auto& adjacent{ test.getAdjacent(curr.key) };
-		for (auto& key : adjacent)
+		for (auto& [id, weight] : test.edgesOf(curr.key))
 		{
-			pq.insert(EdgePair(key, adjacent[key]));
+			pq.insert(EdgePair(test.key(id), weight));
 		}
 	}
 	std::cout << '\n';
+
+	std::cout << "Freezing the graph into a CSR snapshot:\n";
+	JML::CsrGraph<char, int> frozen{ test.freeze() };
+	std::cout << "Vertices: " << frozen.size() << " edges: " << frozen.edgeCount() << '\n';
+	std::uint32_t* order{ new std::uint32_t[frozen.size()] };
+	std::size_t visited{ frozen.bfs(frozen.id('a'), order) };
+	std::cout << "BFS from a:";
+	for (std::size_t i{ 0 }; i < visited; ++i)
+	{
+		std::cout << ' ' << frozen.key(order[i]);
+	}
+	std::cout << '\n';
+	long long* distances{ new long long[frozen.size()] };
+	frozen.dijkstra(frozen.id('a'), distances);
+	std::cout << "Shortest distance from a to z: " << distances[frozen.id('z')] << "\n\n";
+	delete[] distances;
+	delete[] order;
+
+	std::cout << "Library DFS from a:";
+	JML::dfs(test, 'a', [](const char& key) { std::cout << ' ' << key; });
+	std::cout << '\n';
+
+	JML::HashTable<char, long long> shortest{ JML::dijkstra(test, 'a') };
+	std::cout << "Library Dijkstra, distance from a to m: " << shortest['m'] << '\n';
+
+	char sorted[26]{};
+	if (JML::topologicalSort(test, sorted))
+	{
+		std::cout << "Topological order:";
+		for (char key : sorted)
+		{
+			std::cout << ' ' << key;
+		}
+		std::cout << '\n';
+	}
+
+	test.addVertex('!', -1);
+	JML::HashTable<char, std::size_t> components;
+	std::cout << "Connected components after adding an isolated vertex: " << JML::connectedComponents(test, components) << "\n\n";
+
+	std::cout << "Strongly connected components:\n";
+	JML::Graph<char, int> cyclic;
+	for (char key : { 'u', 'v', 'w', 'x', 'y' })
+	{
+		cyclic.addVertex(key, 0);
+	}
+	cyclic.addEdge('u', 'v', 1);
+	cyclic.addEdge('v', 'w', 2);
+	cyclic.addEdge('w', 'u', 3);
+	cyclic.addEdge('w', 'x', 4);
+	cyclic.addEdge('v', 'x', 6);
+	cyclic.addEdge('x', 'y', 5);
+	std::cout << "Has a cycle: " << JML::hasCycle(cyclic) << '\n';
+	JML::HashTable<char, std::size_t> strong;
+	std::cout << "Components: " << JML::stronglyConnectedComponents(cyclic, strong) << ", u, v and w share component " << strong['u'] << '\n';
+	JML::Graph<std::size_t, std::size_t> condensed{ JML::condensation(cyclic, strong) };
+	std::cout << "Condensation has a cycle: " << JML::hasCycle(condensed) << ", size of {u, v, w}: " << condensed[strong['u']]
+		<< ", weight of {u, v, w} -> x: " << condensed.getWeight(strong['u'], strong['x']) << "\n\n";
+
+	std::cout << "PageRank of the cyclic graph:\n";
+	JML::ThreadPool rankPool{ 2 };
+	JML::HashTable<char, double> ranks{ JML::pageRank(cyclic, rankPool) };
+	for (char key : { 'u', 'v', 'w', 'x', 'y' })
+	{
+		std::cout << key << ": " << ranks[key] << ' ';
+	}
+	std::cout << "\n\n";
+
+	std::cout << "Triangles and cores of the cyclic graph, read as undirected:\n";
+	JML::HashTable<char, double> clustering{ JML::clusteringCoefficients(cyclic, rankPool) };
+	JML::HashTable<char, std::uint32_t> cores{ JML::coreNumbers(cyclic) };
+	std::cout << "Triangles: " << JML::countTriangles(cyclic, rankPool) << '\n';
+	for (char key : { 'u', 'v', 'w', 'x', 'y' })
+	{
+		std::cout << key << ": clustering " << clustering[key] << ", core " << cores[key] << '\n';
+	}
+	std::cout << '\n';
+
+	std::cout << "Graph that tracks incoming edges:\n";
+	JML::Graph<char, int> tracked{ JML::GraphOptions::TrackIncoming };
+	for (char key : { 'a', 'b', 'c', 'd' })
+	{
+		tracked.addVertex(key, 0);
+	}
+	tracked.addEdge('a', 'd', 1);
+	tracked.addEdge('b', 'd', 2);
+	tracked.addEdge('d', 'c', 3);
+	std::cout << "Incoming edges of d:";
+	for (auto& [id, weight] : tracked.getIncoming('d').pairs())
+	{
+		std::cout << ' ' << tracked.key(id) << " (weight " << weight << ')';
+	}
+	std::cout << '\n';
+	tracked.removeVertex('d');
+	std::cout << "After removing d, a is adjacent to nothing: " << tracked.getAdjacent('a').empty()
+		<< ", c has no incoming edges: " << tracked.getIncoming('c').empty() << "\n\n";
+
+	std::cout << "Undirected graph:\n";
+	JML::Graph<char, int> friends{ JML::GraphOptions::Undirected | JML::GraphOptions::TrackIncoming };
+	for (char key : { 'a', 'b', 'c', 'd' })
+	{
+		friends.addVertex(key, 0);
+	}
+	friends.addEdge('a', 'b', 1);
+	friends.addEdge('c', 'a', 2);
+	friends.addEdge('a', 'd', 3);
+	std::cout << "Neighbors of a:";
+	for (auto& [id, weight] : friends.edgesOf('a'))
+	{
+		std::cout << ' ' << friends.key(id) << " (weight " << weight << ')';
+	}
+	std::cout << "\nc is adjacent to a: " << friends.adjacent('c', 'a') << ", a is adjacent to c: " << friends.adjacent('a', 'c') << '\n';
+	friends.removeEdge('b', 'a');
+	friends.removeVertex('c');
+	std::cout << "After removing b - a and c, a has " << friends.getAdjacent('a').size() << " neighbor, b has " << friends.getAdjacent('b').size()
+		<< '\n';
+	JML::Graph<char, int> bothWays;
+	for (char key : { 'a', 'b', 'd' })
+	{
+		bothWays.addVertex(key, 0);
+	}
+	bothWays.addEdge('a', 'd', 3);
+	bothWays.addEdge('d', 'a', 3);
+	std::cout << "A directed graph with a - d added both ways equals it: " << (bothWays == friends) << '\n';
+	JML::Graph<char, int> tree{ JML::GraphOptions::Undirected };
+	for (char key : { 'a', 'b', 'c', 'd' })
+	{
+		tree.addVertex(key, 0);
+	}
+	tree.addEdge('a', 'b', 1);
+	tree.addEdge('a', 'c', 1);
+	tree.addEdge('c', 'd', 1);
+	std::cout << "Undirected tree has a cycle: " << JML::hasCycle(tree) << ", frozen: " << tree.freeze().hasCycle();
+	tree.addEdge('d', 'a', 1);
+	std::cout << ", after adding d - a: " << JML::hasCycle(tree) << ", frozen: " << tree.freeze().hasCycle() << '\n';
+	try
+	{
+		char treeOrder[4]{};
+		JML::topologicalSort(tree, treeOrder);
+	}
+	catch (const std::logic_error&)
+	{
+		std::cout << "Topological sort of an undirected graph rejected\n";
+	}
+	std::cout << '\n';
+
+	std::cout << "Shortest paths kept up to date through edge updates:\n";
+	JML::Graph<char, int> roads{ JML::GraphOptions::TrackIncoming };
+	for (char key : { 'a', 'b', 'c', 'd' })
+	{
+		roads.addVertex(key, 0);
+	}
+	JML::DynamicShortestPaths<char, int> routes{ roads, 'a' };
+	routes.addEdge('a', 'b', 1);
+	routes.addEdge('b', 'c', 1);
+	routes.addEdge('c', 'd', 1);
+	routes.addEdge('a', 'd', 5);
+	std::cout << "Distance from a to d: " << routes.distance('d') << ", through " << roads.key(routes.predecessor(roads.id('d'))) << '\n';
+	routes.removeEdge('b', 'c');
+	std::cout << "After removing b -> c: " << routes.distance('d') << ", recomputed " << routes.lastRepairSize() << " vertices, c is unreachable: "
+		<< (routes.distance('c') == routes.UNREACHABLE) << '\n';
+	routes.addEdge('a', 'd', 2);
+	std::cout << "After making a -> d lighter: " << routes.distance('d') << "\n\n";
+
+	std::cout << "Point-to-point queries reusing one search context:\n";
+	JML::PathSearch<char, int> search;
+	std::cout << "Bidirectional Dijkstra from a to d: " << search.shortestPath(roads, 'a', 'd') << ", path:";
+	for (std::size_t i{ 0 }; i < search.pathSize(); ++i)
+	{
+		std::cout << ' ' << roads.key(search.path()[i]);
+	}
+	// Every vertex but d is at least one edge of weight 1 or more away from it, so the estimate never overestimates
+	std::cout << "\nA* from a to d: " << search.shortestPath(roads, 'a', 'd', [](char key) { return key == 'd' ? 0 : 1; }) << " after settling "
+		<< search.lastSettledCount() << " vertices, c to a is unreachable: " << (search.shortestPath(roads, 'c', 'a') == search.UNREACHABLE)
+		<< "\n\n";
+
+	std::cout << "Parallel BFS levels from a:\n";
+	JML::CsrGraph<char, int> snapshot{ test.freeze() };
+	JML::ThreadPool pool{ 4 };
+	std::uint32_t* levels{ new std::uint32_t[snapshot.size()] };
+	std::size_t reached{ JML::parallelBfs(snapshot, snapshot.transpose(), snapshot.id('a'), levels, pool) };
+	for (std::uint32_t id{ 0 }; id < snapshot.size(); ++id)
+	{
+		if (levels[id] != JML::UNVISITED)
+			std::cout << snapshot.key(id) << ':' << levels[id] << ' ';
+	}
+	std::cout << "\nReached " << reached << " of " << snapshot.size() << " vertices\n";
+	delete[] levels;
+	try
+	{
+		pool.parallelFor(0, 1000, [](std::size_t chunkBegin, std::size_t, std::size_t)
+			{
+				if (chunkBegin >= 500)
+					throw std::runtime_error("Chunk failed");
+			});
+	}
+	catch (const std::runtime_error& error)
+	{
+		std::cout << "Parallel loop rethrew: " << error.what() << '\n';
+	}
+	std::atomic<std::size_t> chunksDone{ 0 };
+	pool.parallelFor(0, 1000, [&chunksDone](std::size_t, std::size_t, std::size_t) { ++chunksDone; });
+	std::cout << "The pool still runs loops: " << (chunksDone > 0) << "\n\n";
+
+	std::cout << "Snapshot relabeled in reverse Cuthill-McKee order and split in two:\n";
+	JML::CsrGraph<char, int> transposedSnapshot{ snapshot.transpose() };
+	std::uint32_t* ordering{ new std::uint32_t[snapshot.size()] };
+	JML::reverseCuthillMcKeeOrder(snapshot, transposedSnapshot, ordering);
+	JML::CsrGraph<char, int> relabeled{ snapshot.relabel(ordering) };
+	for (std::uint32_t id{ 0 }; id < relabeled.size(); ++id)
+	{
+		std::cout << relabeled.key(id) << ' ';
+	}
+	std::uint32_t* parts{ new std::uint32_t[relabeled.size()] };
+	std::size_t cut{ JML::partition(relabeled, relabeled.transpose(), 2, parts) };
+	std::cout << "\nPart of a: " << parts[relabeled.id('a')] << ", part of m: " << parts[relabeled.id('m')] << ", edges cut: " << cut << " of "
+		<< relabeled.edgeCount() << "\n\n";
+	delete[] ordering;
+	delete[] parts;
+
+	JML::HashTable<char, long long> parallelShortest{ JML::deltaStepping(test, 'a', pool) };
+	std::cout << "Parallel delta-stepping, distance from a to m: " << parallelShortest['m'] << " (Dijkstra: " << shortest['m'] << ")\n\n";
+
+	std::cout << "Loading a graph in batches:\n";
+	JML::Graph<char, int> batched;
+	char batchKeys[]{ 'p', 'q', 'r', 's' };
+	int batchValues[]{ 1, 2, 3, 4 };
+	batched.addVertices(batchKeys, batchValues, 4);
+	JML::GraphEdge<char> batchEdges[]{ { 'p', 'q', 5 }, { 'p', 'r', 2 }, { 'r', 's', 1 }, { 's', 'p', 7 } };
+	batched.addEdges(batchEdges, 4);
+	std::cout << "Vertices: " << batched.size() << ", weight of r -> s: " << batched.getWeight('r', 's') << '\n';
+	JML::GraphEdge<char> badEdges[]{ { 'q', 's', 3 }, { 'q', 'z', 1 } };
+	try
+	{
+		batched.addEdges(badEdges, 2);
+	}
+	catch (const std::invalid_argument&)
+	{
+		std::cout << "Batch with an unknown key rejected, q -> s added: " << batched.adjacent('q', 's') << "\n\n";
+	}
+
+	std::cout << "Working through vertex ids:\n";
+	JML::VertexId p{ batched.id('p') };
+	JML::VertexId t{ batched.addVertex('t', 9) };
+	batched.addEdge(p, t, 4);
+	std::cout << "Key of " << t.index << ": " << batched.key(t) << ", value: " << batched.getVertex(t) << ", edges out of p:";
+	for (auto& [id, weight] : batched.edgesOf(p))
+	{
+		std::cout << ' ' << batched.key(id) << " (weight " << weight << ')';
+	}
+	std::cout << "\n\n";
+
+	std::cout << "Float and void edge weights:\n";
+	JML::Graph<char, int, float> latencies;
+	JML::Graph<char, int, void> links;
+	for (char key : { 'a', 'b', 'c', 'd' })
+	{
+		latencies.addVertex(key, 0);
+		links.addVertex(key, 0);
+	}
+	latencies.addEdge('a', 'b', 0.25f);
+	latencies.addEdge('b', 'c', 0.5f);
+	latencies.addEdge('a', 'c', 1.5f);
+	latencies.addEdge('c', 'd', 0.125f);
+	links.addEdge('a', 'b');
+	links.addEdge('b', 'c');
+	links.addEdge('a', 'c');
+	links.addEdge('c', 'd');
+	JML::HashTable<char, double> latency{ JML::dijkstra(latencies, 'a') };
+	JML::HashTable<char, long long> hops{ JML::dijkstra(links, 'a') };
+	std::cout << "Lowest latency from a to d: " << latency['d'] << ", fewest edges from a to d: " << hops['d'] << '\n';
+	JML::CsrGraph<char, int, void> frozenLinks{ links.freeze() };
+	std::cout << "Unweighted snapshot has " << frozenLinks.edgeCount() << " edges and a weight array: " << (frozenLinks.weightArray() != nullptr)
+		<< "\n\n";
+
+	std::cout << "Minimum spanning forest, ignoring edge directions:\n";
+	JML::GraphEdge<char> spanning[26]{};
+	std::size_t spanningSize{ JML::kruskal(test, spanning, pool) };
+	long long spanningWeight{ 0 };
+	std::cout << "Kruskal:";
+	for (std::size_t i{ 0 }; i < spanningSize; ++i)
+	{
+		std::cout << ' ' << spanning[i].from << spanning[i].to;
+		spanningWeight += spanning[i].weight;
+	}
+	std::cout << "\nEdges: " << spanningSize << ", total weight: " << spanningWeight << '\n';
+	spanningSize = JML::prim(test, spanning);
+	spanningWeight = 0;
+	for (std::size_t i{ 0 }; i < spanningSize; ++i)
+	{
+		spanningWeight += spanning[i].weight;
+	}
+	std::cout << "Prim, edges: " << spanningSize << ", total weight: " << spanningWeight << "\n\n";
+
+	std::cout << "Sharing the graph with a reader, then changing the original:\n";
+	JML::Graph<char, int> shared{ test.share() };
+	test.addEdge('m', 'a', 4);
+	JML::GraphSnapshot<char, int> version{ test.snapshot() };
+	test.removeVertex('z');
+	std::cout << "Original has m -> a: " << test.adjacent('m', 'a') << ", contains z: " << test.contains('z') << '\n';
+	std::cout << "Snapshot has m -> a: " << version->adjacent('m', 'a') << ", contains z: " << version->contains('z') << '\n';
+	std::cout << "Shared copy has m -> a: " << shared.adjacent('m', 'a') << ", contains z: " << shared.contains('z') << "\n\n";
+	test = static_cast<JML::Graph<char, int>&&>(shared);
+
+	std::cout << "Saving the graph to a file and reading it back:\n";
+	JML::saveGraph(test, "graph.bin");
+	JML::Graph<char, int> loaded{ JML::loadGraph<char, int>("graph.bin") };
+	std::cout << "Loaded graph equals the original: " << (loaded == test) << '\n';
+	{
+		JML::MappedGraph<char, int> mapped{ "graph.bin" };
+		std::uint32_t mappedM{ mapped.id('m') };
+		std::cout << "Mapped view: " << mapped.size() << " vertices, " << mapped.edgeCount() << " edges, m has value " << mapped.value(mappedM)
+			<< " and " << mapped.degree(mappedM) << " outgoing edges\n";
+	}
+	// Pointing the edges of the first vertex past the end of the edge array, then cutting the file short
+	{
+		std::fstream file{ "graph.bin", std::ios::binary | std::ios::in | std::ios::out };
+		std::uint64_t badOffset{ 1000 };
+		file.seekp(static_cast<std::streamoff>(JML::graphFileLayout(JML::GraphFileHeader{}).offsets + sizeof(std::uint64_t)));
+		file.write(reinterpret_cast<const char*>(&badOffset), sizeof(badOffset));
+	}
+	try
+	{
+		JML::loadGraph<char, int>("graph.bin");
+	}
+	catch (const std::invalid_argument&)
+	{
+		std::cout << "File with a bad edge offset rejected\n";
+	}
+	{
+		std::ofstream file{ "graph.bin", std::ios::binary | std::ios::trunc };
+		JML::GraphFileHeader header{};
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header) / 2);
+	}
+	try
+	{
+		JML::MappedGraph<char, int> truncated{ "graph.bin" };
+	}
+	catch (const std::invalid_argument&)
+	{
+		std::cout << "Truncated file rejected\n\n";
+	}
+	std::remove("graph.bin");
 	return 0;
 }
\ No newline at end of file
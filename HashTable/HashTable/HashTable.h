@@ -3,16 +3,35 @@
 
 #include <cstddef>
 
+// Lets an empty member share its address with the other members, so it takes no space. MSVC only honors its own spelling of the attribute
+#ifdef _MSC_VER
+#define JML_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define JML_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
 namespace JML
 {
+	// Key-value pair stored in a HashTable. Iterating over pairs() yields references to these, so for (auto& [key, value] : table.pairs())
+	// reads every value without hashing its key again. A value of an empty type, such as the weight of an unweighted edge, takes no space
+	template <typename T, typename U>
+	struct KeyValue
+	{
+		const T key;
+		JML_NO_UNIQUE_ADDRESS U value;
+	};
+
 	template <typename T, typename U = T>
 	class HashTable
 	{
 	private:
 		class BucketLink;
 		class Iterator;
+		template <typename Pair> class PairIterator;
 
 	public:
+		template <typename Pair> class PairRange;
+
 		HashTable(std::size_t reserveCount = 10, float maxLoad = 1.0);
 		HashTable(const HashTable<T, U>& table);  // Copy constructor
 		HashTable(HashTable<T, U>&& table) noexcept;  // Move constructor
@@ -41,6 +60,8 @@ namespace JML
 		void rehash(std::size_t count = 1);
 		Iterator begin() const;
 		Iterator end() const;
+		PairRange<KeyValue<T, U>> pairs();
+		PairRange<const KeyValue<T, U>> pairs() const;
 		
 	private:
 		BucketLink** buckets{};
@@ -52,20 +73,19 @@ namespace JML
 		template <typename V> BucketLink* getBucketLink(V&& key);
 		BucketLink* getBucketLink(const T& key) const;
 
-		class BucketLink
+		// Buckets are singly linked, since removal walks the chain from its head anyway
+		class BucketLink : public KeyValue<T, U>
 		{
 		public:
-			T key{};
-			U value{};
 			BucketLink* next{ nullptr };
-			BucketLink* prev{ nullptr };
 
-			BucketLink();
+			template <typename V> BucketLink(V&& key);
 		};
 
 		class Iterator
 		{
 		public:
+			Iterator() = default;
 			Iterator(BucketLink** bucketHead, BucketLink* currentLink, std::size_t bucketsLeft);
 			const T& operator*();
 			void operator++();
@@ -76,7 +96,32 @@ namespace JML
 		protected:
 			BucketLink** bucketHead{ nullptr };
 			BucketLink* currentLink{ nullptr };
-			std::size_t bucketsLeft;  // The number of buckets left until the end (one past the end of the bucket array)
+			std::size_t bucketsLeft{ 0 };  // The number of buckets left until the end (one past the end of the bucket array)
+		};
+
+		// Iterator over the same links that returns references to whole key-value pairs instead of keys
+		template <typename Pair>
+		class PairIterator : public Iterator
+		{
+		public:
+			PairIterator() = default;
+			PairIterator(const Iterator& iterator);
+			Pair& operator*();
+		};
+
+	public:
+		// Range returned by pairs() for range-based for loops
+		template <typename Pair>
+		class PairRange
+		{
+		public:
+			PairRange(const Iterator& first, const Iterator& last);
+			PairIterator<Pair> begin() const;
+			PairIterator<Pair> end() const;
+
+		private:
+			Iterator first;
+			Iterator last;
 		};
 	};
 }
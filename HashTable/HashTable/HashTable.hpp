@@ -36,27 +36,26 @@ namespace JML
 				if (table.buckets[i]->next)
 				{
 					BucketLink* curr{ table.buckets[i] };
-					BucketLink* copyCurr{ new BucketLink() };
+					BucketLink* copyCurr{ new BucketLink(curr->key) };
 					buckets[i] = copyCurr;
-					copyCurr->key = curr->key;
 					copyCurr->value = curr->value;
 					curr = curr->next;
 					while (curr)
 					{
-						copyCurr->next = new BucketLink();
+						copyCurr->next = new BucketLink(curr->key);
 						copyCurr = copyCurr->next;
-						copyCurr->key = curr->key;
 						copyCurr->value = curr->value;
 						curr = curr->next;
 					}
 				}
 				else
 				{
-					buckets[i] = new BucketLink();
-					buckets[i]->key = table.buckets[i]->key;
+					buckets[i] = new BucketLink(table.buckets[i]->key);
 					buckets[i]->value = table.buckets[i]->value;
 				}
 			}
+			else
+				buckets[i] = nullptr;
 		}
 	}
 
@@ -100,27 +99,26 @@ namespace JML
 				if (table.buckets[i]->next)
 				{
 					BucketLink* curr{ table.buckets[i] };
-					BucketLink* copyCurr{ new BucketLink() };
+					BucketLink* copyCurr{ new BucketLink(curr->key) };
 					buckets[i] = copyCurr;
-					copyCurr->key = curr->key;
 					copyCurr->value = curr->value;
 					curr = curr->next;
 					while (curr)
 					{
-						copyCurr->next = new BucketLink();
+						copyCurr->next = new BucketLink(curr->key);
 						copyCurr = copyCurr->next;
-						copyCurr->key = curr->key;
 						copyCurr->value = curr->value;
 						curr = curr->next;
 					}
 				}
 				else
 				{
-					buckets[i] = new BucketLink();
-					buckets[i]->key = table.buckets[i]->key;
+					buckets[i] = new BucketLink(table.buckets[i]->key);
 					buckets[i]->value = table.buckets[i]->value;
 				}
 			}
+			else
+				buckets[i] = nullptr;
 		}
 		return *this;
 	}
@@ -150,11 +148,11 @@ namespace JML
 	{
 		if (table1.numPairs == table2.numPairs)
 		{
-			for (const T1& key : table1)
+			for (const KeyValue<T1, U1>& pair : table1.pairs())
 			{
 				try
 				{
-					if (table1.getBucketLink(key)->value != table2.getBucketLink(key)->value)
+					if (pair.value != table2.getBucketLink(pair.key)->value)
 						return false;
 				}
 				catch (std::invalid_argument&)
@@ -423,6 +421,19 @@ namespace JML
 		return Iterator(buckets + numBuckets, nullptr, 0);
 	}
 
+	// Returns a range over the key-value pairs of the hash table, for use in range-based for loops. Values can be changed through it but keys can't
+	template <typename T, typename U>
+	HashTable<T, U>::PairRange<KeyValue<T, U>> HashTable<T, U>::pairs()
+	{
+		return PairRange<KeyValue<T, U>>(begin(), end());
+	}
+
+	template <typename T, typename U>
+	HashTable<T, U>::PairRange<const KeyValue<T, U>> HashTable<T, U>::pairs() const
+	{
+		return PairRange<const KeyValue<T, U>>(begin(), end());
+	}
+
 	// Returns the link with the given key. Creates a new link if no link with the given key exists. Supports perfect forwarding
 	template <typename T, typename U>
 	template <typename V> HashTable<T, U>::BucketLink* HashTable<T, U>::getBucketLink(V&& key)
@@ -443,17 +454,16 @@ namespace JML
 				curr = curr->next;
 			}
 			// Adding a new pair to a non-empty bucket
-			curr = new BucketLink();
+			curr = new BucketLink(static_cast<V&&>(key));
 			prev->next = curr;
 		}
 		else
 		{
 			// Adding a new pair to an empty bucket
-			curr = new BucketLink();
+			curr = new BucketLink(static_cast<V&&>(key));
 			buckets[index] = curr;
 		}
 
-		curr->key = static_cast<V&&>(key);
 		++numPairs;
 		if (loadFactor() >= maxLoadFactor())
 			rehash();
@@ -482,8 +492,10 @@ namespace JML
 
 	// Bucket link implementation
 
+	// Parentheses rather than braces so that keys of other types convert to T as they would by assignment
 	template <typename T, typename U>
-	HashTable<T, U>::BucketLink::BucketLink()
+	template <typename V> HashTable<T, U>::BucketLink::BucketLink(V&& key) :
+		KeyValue<T, U>(static_cast<V&&>(key), U{})
 	{}
 
 	// Hash table forward iterator implementation
@@ -540,5 +552,37 @@ namespace JML
 	{
 		return !operator==(iterator);
 	}
+
+	// Key-value pair iterator implementation
+
+	template <typename T, typename U>
+	template <typename Pair> HashTable<T, U>::PairIterator<Pair>::PairIterator(const Iterator& iterator) :
+		Iterator{ iterator }
+	{}
+
+	template <typename T, typename U>
+	template <typename Pair> Pair& HashTable<T, U>::PairIterator<Pair>::operator*()
+	{
+		return *this->currentLink;
+	}
+
+	// Key-value pair range implementation
+
+	template <typename T, typename U>
+	template <typename Pair> HashTable<T, U>::PairRange<Pair>::PairRange(const Iterator& first, const Iterator& last) :
+		first{ first }, last{ last }
+	{}
+
+	template <typename T, typename U>
+	template <typename Pair> HashTable<T, U>::PairIterator<Pair> HashTable<T, U>::PairRange<Pair>::begin() const
+	{
+		return PairIterator<Pair>(first);
+	}
+
+	template <typename T, typename U>
+	template <typename Pair> HashTable<T, U>::PairIterator<Pair> HashTable<T, U>::PairRange<Pair>::end() const
+	{
+		return PairIterator<Pair>(last);
+	}
 }
 #endif
\ No newline at end of file
@@ -29,5 +29,13 @@ int main()
 	{
 		std::cout << "key: " << key << " value: " << test[key] << '\n';
 	}
+	std::cout << '\n';
+
+	std::cout << "Doubling values through key-value pairs:\n";
+	for (auto& [key, value] : test.pairs())
+	{
+		value *= 2;
+		std::cout << "key: " << key << " value: " << value << '\n';
+	}
 	return 0;
 }
\ No newline at end of file
@@ -17,21 +17,29 @@ namespace JML
 		Heap(Heap<T, comparator>&& heap) noexcept;  // Move constructor
 		~Heap();
 		Heap<T, comparator>& operator=(const Heap<T, comparator>& heap);  // Copy assignment
-		Heap<T, comparator>& operator=(Heap<T, comparator>&& heap);  // Move assignment
-		template <typename T1, bool (*comparator)(const T1&, const T1&)> friend bool operator==(const Heap<T1, comparator>& heap1, const Heap <T1, comparator>& heap2);
-		template <typename T1, bool (*comparator)(const T1&, const T1&)> friend bool operator!=(const Heap<T1, comparator>& heap1, const Heap <T1, comparator>& heap2);
+		Heap<T, comparator>& operator=(Heap<T, comparator>&& heap) noexcept;  // Move assignment
+		template <typename T1, bool (*comparator1)(const T1&, const T1&)> friend bool operator==(const Heap<T1, comparator1>& heap1, const Heap <T1, comparator1>& heap2);
+		template <typename T1, bool (*comparator1)(const T1&, const T1&)> friend bool operator!=(const Heap<T1, comparator1>& heap1, const Heap <T1, comparator1>& heap2);
 		std::size_t size() const;
 		bool empty() const;
 		template <typename U> void insert(U&& item);
 		T& top();
 		const T& top() const;
 		void pop();
+		template <typename U> void replaceTop(U&& item);
 		void reserve(std::size_t reserveNum = 1);
+		void shrink_to_fit();
 
 	private:
 		std::size_t capacity{};
 		std::size_t heapSize{ 0 };
-		T* items{};
+		T* items{};  // Uninitialized storage for capacity items. Only the first heapSize are constructed
+
+		static T* allocate(std::size_t count);
+		static void deallocate(T* storage);
+		void reallocate(std::size_t newCapacity);
+		static T* copyItems(const Heap<T, comparator>& heap);
+		void destroyItems();
 
 		std::size_t getParent(std::size_t index) const;
 		std::size_t getLeft(std::size_t index) const;
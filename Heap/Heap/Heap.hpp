@@ -2,7 +2,10 @@
 #define JML_HEAP_HPP
 
 #include <cstddef>
+#include <cstring>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
 
 namespace JML
 {
@@ -14,74 +17,71 @@ namespace JML
 
 	template <typename T, bool (*comparator)(const T&, const T&)>
 	Heap<T, comparator>::Heap(std::size_t reserveNum) :
-		capacity{reserveNum}, items{new T[reserveNum]}
+		capacity{reserveNum}, items{allocate(reserveNum)}
 	{}
 
-	// Copy constructor
+	// Copy constructor. Only the items are copied, so the new heap's capacity is exactly the size of the old one
 	template <typename T, bool (*comparator)(const T&, const T&)>
 	Heap<T, comparator>::Heap(const Heap<T, comparator>& heap) :
-		capacity{heap.capacity}, heapSize{heap.heapSize}, items{new T[capacity]}
-	{
-		for (std::size_t i{ 0 }; i < capacity; ++i)
-		{
-			items[i] = heap.items[i];
-		}
-	}
+		capacity{heap.heapSize}, heapSize{heap.heapSize}, items{copyItems(heap)}
+	{}
 
 	// Move constructor
 	template <typename T, bool (*comparator)(const T&, const T&)>
 	Heap<T, comparator>::Heap(Heap<T, comparator>&& heap) noexcept :
 		capacity{heap.capacity}, heapSize{heap.heapSize}, items{heap.items}
 	{
-		// Allocating a capacity of exactly one so that the old heap is still valid after the move
-		heap.capacity = 1;
+		// A capacity of zero is valid, so the old heap doesn't need a new allocation
+		heap.capacity = 0;
 		heap.heapSize = 0;
-		heap.items = new T[1];
+		heap.items = nullptr;
 	}
 
 	template <typename T, bool (*comparator)(const T&, const T&)>
 	Heap<T, comparator>::~Heap()
 	{
-		delete[] items;
+		destroyItems();
+		deallocate(items);
 	}
 
-	// Copy assignment
+	// Copy assignment. The items are copied before the old ones are released, so the heap is left as it was if a copy throws
 	template <typename T, bool (*comparator)(const T&, const T&)>
 	Heap<T, comparator>& Heap<T, comparator>::operator=(const Heap<T, comparator>& heap)
 	{
 		if (&heap == this)
 			return *this;
-		
-		delete[] items;
-		capacity = heap.capacity;
+
+		T* newItems{ copyItems(heap) };
+		destroyItems();
+		deallocate(items);
+		items = newItems;
+		capacity = heap.heapSize;
 		heapSize = heap.heapSize;
-		items = new T[heap.capacity];
-		for (std::size_t i{ 0 }; i < capacity; ++i)
-		{
-			items[i] = heap.items[i];
-		}
 		return *this;
 	}
 
 	// Move assignment
 	template <typename T, bool (*comparator)(const T&, const T&)>
-	Heap<T, comparator>& Heap<T, comparator>::operator=(Heap<T, comparator>&& heap)
+	Heap<T, comparator>& Heap<T, comparator>::operator=(Heap<T, comparator>&& heap) noexcept
 	{
-		delete[] items;
+		if (&heap == this)
+			return *this;
+
+		destroyItems();
+		deallocate(items);
 		capacity = heap.capacity;
 		heapSize = heap.heapSize;
 		items = heap.items;
 
-		// Allocating a capacity of exactly one so that the old heap is still valid after the move
-		heap.capacity = 1;
+		heap.capacity = 0;
 		heap.heapSize = 0;
-		heap.items = new T[1];
+		heap.items = nullptr;
 
 		return *this;
 	}
 
-	template <typename T1, bool (*comparator)(const T1&, const T1&)> 
-	bool operator==(const Heap<T1, comparator>& heap1, const Heap <T1, comparator>& heap2)
+	template <typename T1, bool (*comparator1)(const T1&, const T1&)> 
+	bool operator==(const Heap<T1, comparator1>& heap1, const Heap <T1, comparator1>& heap2)
 	{
 		if (heap1.heapSize == heap2.heapSize)
 		{
@@ -95,8 +95,8 @@ namespace JML
 		return false;
 	}
 
-	template <typename T1, bool (*comparator)(const T1&, const T1&)>
-	bool operator!=(const Heap<T1, comparator>& heap1, const Heap <T1, comparator>& heap2)
+	template <typename T1, bool (*comparator1)(const T1&, const T1&)>
+	bool operator!=(const Heap<T1, comparator1>& heap1, const Heap <T1, comparator1>& heap2)
 	{
 		return !operator==(heap1, heap2);
 	}
@@ -121,9 +121,9 @@ namespace JML
 	{
 		// Growing the heap by a factor of two if the maximum capacity has been reached
 		if (heapSize == capacity)
-			reserve(2 * capacity);
+			reallocate(capacity ? 2 * capacity : 1);
 		
-		items[heapSize] = static_cast<U&&>(item);
+		new (items + heapSize) T(static_cast<U&&>(item));
 		heapifyUp(heapSize++);
 	}
 
@@ -153,31 +153,153 @@ namespace JML
 		if (heapSize == 0)
 			throw std::range_error("Cannot pop an empty heap");
 
-		if (heapSize == 1)
-			--heapSize;
-		else
+		--heapSize;
+		if (heapSize > 0)
 		{
-			items[0] = items[heapSize - 1];
-			--heapSize;
+			items[0] = static_cast<T&&>(items[heapSize]);
+			items[heapSize].~T();
 			heapifyDown(0);
 		}
+		else
+			items[0].~T();
 	}
 
-	// Reserves at least reserveNum elements
+	// Replaces the item at the top of the heap with the given item. Cheaper than a pop followed by an insert. Supports perfect forwarding
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	template <typename U> void Heap<T, comparator>::replaceTop(U&& item)
+	{
+		if (heapSize == 0)
+			throw std::range_error("Cannot replace the top of an empty heap");
+
+		items[0] = static_cast<U&&>(item);
+		heapifyDown(0);
+	}
+
+	// Reserves at least reserveNum elements. Reserved slots are left unconstructed
 	template <typename T, bool (*comparator)(const T&, const T&)>
 	void Heap<T, comparator>::reserve(std::size_t reserveNum)
 	{
 		if (reserveNum > capacity)
+			reallocate(reserveNum);
+	}
+
+	// Shrinks the capacity of the heap to its size
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void Heap<T, comparator>::shrink_to_fit()
+	{
+		if (heapSize < capacity)
+			reallocate(heapSize);
+	}
+
+	// Returns uninitialized storage for count items
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	T* Heap<T, comparator>::allocate(std::size_t count)
+	{
+		if (count == 0)
+			return nullptr;
+
+		if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ alignof(T) }));
+		else
+			return static_cast<T*>(::operator new(count * sizeof(T)));
+	}
+
+	// Frees storage returned by allocate. Any items in it must already be destroyed
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void Heap<T, comparator>::deallocate(T* storage)
+	{
+		if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			::operator delete(storage, std::align_val_t{ alignof(T) });
+		else
+			::operator delete(storage);
+	}
+
+	// Moves the items into new storage for exactly newCapacity items. Trivially copyable items are relocated with a single memcpy. If moving
+	// an item throws, the new storage is released and the heap keeps its old storage and every item
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void Heap<T, comparator>::reallocate(std::size_t newCapacity)
+	{
+		T* newItems{ allocate(newCapacity) };
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			if (heapSize > 0)
+				std::memcpy(static_cast<void*>(newItems), static_cast<const void*>(items), heapSize * sizeof(T));
+		}
+		else
+		{
+			std::size_t moved{ 0 };
+			try
+			{
+				for (; moved < heapSize; ++moved)
+				{
+					new (newItems + moved) T(static_cast<T&&>(items[moved]));
+				}
+			}
+			catch (...)
+			{
+				for (std::size_t i{ 0 }; i < moved; ++i)
+				{
+					newItems[i].~T();
+				}
+				deallocate(newItems);
+				throw;
+			}
+			for (std::size_t i{ 0 }; i < heapSize; ++i)
+			{
+				items[i].~T();
+			}
+		}
+		deallocate(items);
+		items = newItems;
+		capacity = newCapacity;
+	}
+
+	// Returns fresh storage sized to fit the items of the given heap, holding copies of them. If a copy throws, the copies made so far are
+	// destroyed and the storage is released before the exception goes on
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	T* Heap<T, comparator>::copyItems(const Heap<T, comparator>& heap)
+	{
+		T* newItems{ allocate(heap.heapSize) };
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			if (heap.heapSize > 0)
+				std::memcpy(static_cast<void*>(newItems), static_cast<const void*>(heap.items), heap.heapSize * sizeof(T));
+		}
+		else
+		{
+			std::size_t copied{ 0 };
+			try
+			{
+				for (; copied < heap.heapSize; ++copied)
+				{
+					new (newItems + copied) T(heap.items[copied]);
+				}
+			}
+			catch (...)
+			{
+				for (std::size_t i{ 0 }; i < copied; ++i)
+				{
+					newItems[i].~T();
+				}
+				deallocate(newItems);
+				throw;
+			}
+		}
+		return newItems;
+	}
+
+	// Destroys the constructed items without releasing storage
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void Heap<T, comparator>::destroyItems()
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
 		{
-			capacity = reserveNum;
-			T* newItems{ new T[capacity] };
 			for (std::size_t i{ 0 }; i < heapSize; ++i)
 			{
-				newItems[i] = static_cast<T&&>(items[i]);
+				items[i].~T();
 			}
-			delete[] items;
-			items = newItems;
 		}
+		heapSize = 0;
 	}
 
 	// Returns the parent index of the given index
@@ -0,0 +1,52 @@
+#ifndef JML_INDEXED_HEAP_H
+#define JML_INDEXED_HEAP_H
+
+#include <cstddef>
+
+#include "Heap.h"
+
+namespace JML
+{
+	// Heap of priorities attached to indices from 0 to indexCount - 1. Each index is in the heap at most once, and its position is tracked so
+	// that the priority of an index already in the heap can be changed in place instead of inserting a stale duplicate
+	template <typename T, bool (*comparator)(const T&, const T&) = heapGreater>
+	class IndexedHeap
+	{
+	public:
+		static constexpr std::size_t NOT_QUEUED{ ~std::size_t{ 0 } };  // Position of indices that aren't in the heap
+
+		IndexedHeap(std::size_t indexCount = 0);
+		IndexedHeap(const IndexedHeap<T, comparator>& heap);  // Copy constructor
+		IndexedHeap(IndexedHeap<T, comparator>&& heap) noexcept;  // Move constructor
+		~IndexedHeap();
+		IndexedHeap<T, comparator>& operator=(const IndexedHeap<T, comparator>& heap);  // Copy assignment
+		IndexedHeap<T, comparator>& operator=(IndexedHeap<T, comparator>&& heap) noexcept;  // Move assignment
+		std::size_t size() const;
+		bool empty() const;
+		std::size_t indexCount() const;
+		bool contains(std::size_t index) const;
+		const T& priority(std::size_t index) const;
+		template <typename U> void insert(std::size_t index, U&& priority);
+		std::size_t topIndex() const;
+		const T& top() const;
+		void pop();
+		void erase(std::size_t index);
+		void clear();
+
+	private:
+		std::size_t numIndices{ 0 };
+		std::size_t heapSize{ 0 };
+		std::size_t* order{ nullptr };  // Indices in heap order
+		std::size_t* positions{ nullptr };  // Position of every index in order, or NOT_QUEUED
+		T* priorities{ nullptr };  // Indexed by index. Only meaningful for indices in the heap
+
+		void copyFrom(const IndexedHeap<T, comparator>& heap);
+		void release();
+		void checkIndex(std::size_t index) const;
+		void heapifyUp(std::size_t position);
+		void heapifyDown(std::size_t position);
+		void place(std::size_t position, std::size_t index);
+	};
+}
+#include "IndexedHeap.hpp"
+#endif
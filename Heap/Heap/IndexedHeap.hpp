@@ -0,0 +1,282 @@
+#ifndef JML_INDEXED_HEAP_HPP
+#define JML_INDEXED_HEAP_HPP
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace JML
+{
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	IndexedHeap<T, comparator>::IndexedHeap(std::size_t indexCount) :
+		numIndices{ indexCount }, order{ new std::size_t[indexCount] }, positions{ new std::size_t[indexCount] }, priorities{ new T[indexCount] }
+	{
+		for (std::size_t i{ 0 }; i < numIndices; ++i)
+		{
+			positions[i] = NOT_QUEUED;
+		}
+	}
+
+	// Copy constructor
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	IndexedHeap<T, comparator>::IndexedHeap(const IndexedHeap<T, comparator>& heap)
+	{
+		copyFrom(heap);
+	}
+
+	// Move constructor
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	IndexedHeap<T, comparator>::IndexedHeap(IndexedHeap<T, comparator>&& heap) noexcept :
+		numIndices{ heap.numIndices }, heapSize{ heap.heapSize }, order{ heap.order }, positions{ heap.positions }, priorities{ heap.priorities }
+	{
+		heap.numIndices = 0;
+		heap.heapSize = 0;
+		heap.order = nullptr;
+		heap.positions = nullptr;
+		heap.priorities = nullptr;
+	}
+
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	IndexedHeap<T, comparator>::~IndexedHeap()
+	{
+		release();
+	}
+
+	// Copy assignment
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	IndexedHeap<T, comparator>& IndexedHeap<T, comparator>::operator=(const IndexedHeap<T, comparator>& heap)
+	{
+		if (&heap == this)
+			return *this;
+
+		release();
+		copyFrom(heap);
+		return *this;
+	}
+
+	// Move assignment
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	IndexedHeap<T, comparator>& IndexedHeap<T, comparator>::operator=(IndexedHeap<T, comparator>&& heap) noexcept
+	{
+		if (&heap == this)
+			return *this;
+
+		release();
+		numIndices = heap.numIndices;
+		heapSize = heap.heapSize;
+		order = heap.order;
+		positions = heap.positions;
+		priorities = heap.priorities;
+
+		heap.numIndices = 0;
+		heap.heapSize = 0;
+		heap.order = nullptr;
+		heap.positions = nullptr;
+		heap.priorities = nullptr;
+
+		return *this;
+	}
+
+	// Returns the number of indices in the heap
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	std::size_t IndexedHeap<T, comparator>::size() const
+	{
+		return heapSize;
+	}
+
+	// Returns true if the heap has no indices
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	bool IndexedHeap<T, comparator>::empty() const
+	{
+		return heapSize == 0;
+	}
+
+	// Returns the number of indices the heap was created for
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	std::size_t IndexedHeap<T, comparator>::indexCount() const
+	{
+		return numIndices;
+	}
+
+	// Returns true if the given index is in the heap
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	bool IndexedHeap<T, comparator>::contains(std::size_t index) const
+	{
+		return index < numIndices && positions[index] != NOT_QUEUED;
+	}
+
+	// Returns the priority of the given index. Raises std::invalid_argument if the index isn't in the heap
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	const T& IndexedHeap<T, comparator>::priority(std::size_t index) const
+	{
+		if (!contains(index))
+			throw std::invalid_argument("Index is not in the heap");
+
+		return priorities[index];
+	}
+
+	// Inserts the given index with the given priority, or changes its priority in place if it's already in the heap. Supports perfect forwarding
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	template <typename U> void IndexedHeap<T, comparator>::insert(std::size_t index, U&& priority)
+	{
+		checkIndex(index);
+		priorities[index] = static_cast<U&&>(priority);
+		if (positions[index] == NOT_QUEUED)
+		{
+			place(heapSize, index);
+			heapifyUp(heapSize++);
+		}
+		else
+		{
+			heapifyUp(positions[index]);
+			heapifyDown(positions[index]);
+		}
+	}
+
+	// Returns the index at the top of the heap. Raises std::range_error if the heap is empty
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	std::size_t IndexedHeap<T, comparator>::topIndex() const
+	{
+		if (heapSize == 0)
+			throw std::range_error("Cannot return the top of an empty heap");
+
+		return order[0];
+	}
+
+	// Returns the priority of the index at the top of the heap. Raises std::range_error if the heap is empty
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	const T& IndexedHeap<T, comparator>::top() const
+	{
+		if (heapSize == 0)
+			throw std::range_error("Cannot return the top of an empty heap");
+
+		return priorities[order[0]];
+	}
+
+	// Removes the index at the top of the heap
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void IndexedHeap<T, comparator>::pop()
+	{
+		if (heapSize == 0)
+			throw std::range_error("Cannot pop an empty heap");
+
+		erase(order[0]);
+	}
+
+	// Removes the given index from the heap if it's in it
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void IndexedHeap<T, comparator>::erase(std::size_t index)
+	{
+		if (!contains(index))
+			return;
+
+		std::size_t position{ positions[index] };
+		positions[index] = NOT_QUEUED;
+		if (position == --heapSize)
+			return;
+
+		// Filling the hole with the last index, which can belong either above or below it
+		std::size_t last{ order[heapSize] };
+		place(position, last);
+		heapifyUp(position);
+		heapifyDown(positions[last]);
+	}
+
+	// Removes every index from the heap
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void IndexedHeap<T, comparator>::clear()
+	{
+		for (std::size_t i{ 0 }; i < heapSize; ++i)
+		{
+			positions[order[i]] = NOT_QUEUED;
+		}
+		heapSize = 0;
+	}
+
+	// Copies the given heap into fresh arrays. Any previous arrays must already be released
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void IndexedHeap<T, comparator>::copyFrom(const IndexedHeap<T, comparator>& heap)
+	{
+		numIndices = heap.numIndices;
+		heapSize = heap.heapSize;
+		order = new std::size_t[numIndices];
+		positions = new std::size_t[numIndices];
+		priorities = new T[numIndices];
+		for (std::size_t i{ 0 }; i < numIndices; ++i)
+		{
+			positions[i] = heap.positions[i];
+			if (positions[i] != NOT_QUEUED)
+				priorities[i] = heap.priorities[i];
+		}
+		for (std::size_t i{ 0 }; i < heapSize; ++i)
+		{
+			order[i] = heap.order[i];
+		}
+	}
+
+	// Frees the arrays
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void IndexedHeap<T, comparator>::release()
+	{
+		delete[] order;
+		delete[] positions;
+		delete[] priorities;
+	}
+
+	// Raises std::out_of_range if the given index is outside the range the heap was created for
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void IndexedHeap<T, comparator>::checkIndex(std::size_t index) const
+	{
+		if (index >= numIndices)
+			throw std::out_of_range("Index is outside the range of the heap");
+	}
+
+	// Restores the heap property upwards starting at the given position
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void IndexedHeap<T, comparator>::heapifyUp(std::size_t position)
+	{
+		// Moving the index up through a hole instead of swapping at every level
+		std::size_t index{ order[position] };
+		while (position > 0)
+		{
+			std::size_t parent{ (position - 1) / 2 };
+			if (!comparator(priorities[index], priorities[order[parent]]))
+				break;
+
+			place(position, order[parent]);
+			position = parent;
+		}
+		place(position, index);
+	}
+
+	// Restores the heap property down starting at the given position
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void IndexedHeap<T, comparator>::heapifyDown(std::size_t position)
+	{
+		std::size_t index{ order[position] };
+		while (true)
+		{
+			std::size_t child{ 2 * position + 1 };
+			if (child >= heapSize)
+				break;
+
+			if (child + 1 < heapSize && comparator(priorities[order[child + 1]], priorities[order[child]]))
+				++child;
+
+			if (!comparator(priorities[order[child]], priorities[index]))
+				break;
+
+			place(position, order[child]);
+			position = child;
+		}
+		place(position, index);
+	}
+
+	// Puts the given index at the given position of the heap and records the position
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void IndexedHeap<T, comparator>::place(std::size_t position, std::size_t index)
+	{
+		order[position] = index;
+		positions[index] = position;
+	}
+}
+#endif
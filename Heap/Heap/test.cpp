@@ -1,7 +1,37 @@
 #if 1
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
 #include "Heap.h"
+#include "IndexedHeap.h"
+
+// Item whose copy constructor throws once copiesLeft runs out, for showing that a failed copy leaves the heap as it was
+struct FragileItem
+{
+    static int copiesLeft;
+    int key{};
+
+    FragileItem(int key) :
+        key{key}
+    {}
+
+    FragileItem(const FragileItem& item) :
+        key{item.key}
+    {
+        if (copiesLeft-- <= 0)
+            throw std::runtime_error("Copy failed");
+    }
+
+    FragileItem& operator=(const FragileItem& item) = default;
+};
+
+int FragileItem::copiesLeft{ 0 };
+
+bool fragileGreater(const FragileItem& x, const FragileItem& y)
+{
+    return x.key > y.key;
+}
 
 int main()
 {
@@ -35,5 +65,60 @@ int main()
         std::cout << maxHeap.top() << '\n';
         maxHeap.pop();
     }
+
+    std::cout << '\n';
+    std::cout << "Indexed min heap over indices 0 to 4:" << '\n';
+    JML::IndexedHeap<int, [](const int& x, const int& y) {return x < y; } > indexedHeap{ 5 };
+    indexedHeap.insert(0, 40);
+    indexedHeap.insert(1, 10);
+    indexedHeap.insert(2, 30);
+    indexedHeap.insert(3, 20);
+    indexedHeap.insert(2, 5);
+    indexedHeap.erase(3);
+
+    std::cout << "Popping after lowering index 2 to 5 and erasing index 3\n";
+    while (!indexedHeap.empty())
+    {
+        std::cout << indexedHeap.topIndex() << ": " << indexedHeap.top() << '\n';
+        indexedHeap.pop();
+    }
+
+    std::cout << '\n';
+    std::cout << "Max heap of strings with starting capacity 1:" << '\n';
+    JML::Heap<std::string> stringHeap{ 1 };
+    for (const char* word : { "pear", "apple", "quince", "fig", "banana" })
+    {
+        stringHeap.insert(std::string{ word } + " with a name long enough to live outside the string object");
+    }
+    stringHeap.pop();
+    stringHeap.shrink_to_fit();
+    JML::Heap<std::string> stringCopy{ stringHeap };
+    stringCopy.insert("zucchini");
+    stringHeap = stringCopy;
+    std::cout << "Size after a pop, shrink_to_fit, copy, insert and copy assignment: " << stringHeap.size() << '\n';
+    while (!stringHeap.empty())
+    {
+        std::cout << stringHeap.top().substr(0, stringHeap.top().find(' ')) << '\n';
+        stringHeap.pop();
+    }
+
+    std::cout << '\n';
+    JML::Heap<FragileItem, fragileGreater> fragileHeap;
+    JML::Heap<FragileItem, fragileGreater> fragileSource;
+    FragileItem::copiesLeft = 100;
+    fragileHeap.insert(FragileItem{ 1 });
+    fragileSource.insert(FragileItem{ 7 });
+    fragileSource.insert(FragileItem{ 8 });
+    fragileSource.insert(FragileItem{ 9 });
+    FragileItem::copiesLeft = 2;
+    try
+    {
+        fragileHeap = fragileSource;
+    }
+    catch (const std::runtime_error&)
+    {
+        std::cout << "Copy assignment failed partway, the heap still holds " << fragileHeap.size() << " item with key " << fragileHeap.top().key
+            << '\n';
+    }
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef JML_MERGEABLE_HEAP_H
+#define JML_MERGEABLE_HEAP_H
+
+#include <cstddef>
+
+#include "Heap.h"
+
+namespace JML
+{
+	// Pairing heap with the same interface as Heap plus an O(1) meld. Nodes are drawn from pooled blocks owned by the heap
+	template <typename T, bool (*comparator)(const T&, const T&) = heapGreater>
+	class MergeableHeap
+	{
+	private:
+		class Node;
+		class Block;
+
+	public:
+		MergeableHeap(std::size_t reserveNum = 10);
+		MergeableHeap(const MergeableHeap<T, comparator>& heap);  // Copy constructor
+		MergeableHeap(MergeableHeap<T, comparator>&& heap) noexcept;  // Move constructor
+		~MergeableHeap();
+		MergeableHeap<T, comparator>& operator=(const MergeableHeap<T, comparator>& heap);  // Copy assignment
+		MergeableHeap<T, comparator>& operator=(MergeableHeap<T, comparator>&& heap) noexcept;  // Move assignment
+		template <typename T1, bool (*comparator1)(const T1&, const T1&)> friend bool operator==(const MergeableHeap<T1, comparator1>& heap1, const MergeableHeap<T1, comparator1>& heap2);
+		template <typename T1, bool (*comparator1)(const T1&, const T1&)> friend bool operator!=(const MergeableHeap<T1, comparator1>& heap1, const MergeableHeap<T1, comparator1>& heap2);
+		std::size_t size() const;
+		bool empty() const;
+		void clear();
+		template <typename U> void insert(U&& item);
+		T& top();
+		const T& top() const;
+		void pop();
+		void reserve(std::size_t reserveNum = 1);
+		void meld(MergeableHeap<T, comparator>& heap);
+		void meld(MergeableHeap<T, comparator>&& heap);
+
+	private:
+		static constexpr std::size_t BLOCKSIZE{ 512 / sizeof(T) ? 512 / sizeof(T) : 1 };
+		Node* root{ nullptr };
+		std::size_t heapSize{ 0 };
+		std::size_t capacity{ 0 };  // The number of nodes in the pool, used or free
+		Block* blocks{ nullptr };
+		Block* lastBlock{ nullptr };
+		Node* freeHead{ nullptr };
+		Node* freeTail{ nullptr };
+
+		Node* link(Node* node1, Node* node2);
+		Node* mergePairs(Node* first);
+		Node* allocateNode();
+		void freeNode(Node* node);
+		void addBlock(std::size_t blockSize);
+		void copyFrom(const MergeableHeap<T, comparator>& heap);
+		void destroyItems();
+		void release();
+
+		class Node
+		{
+		public:
+			union
+			{
+				T item;  // Only constructed while the node is in the tree, so T needn't be default constructible
+			};
+			Node* child{ nullptr };
+			Node* sibling{ nullptr };  // Doubles as the free list link for unused nodes
+
+			Node() {}
+			~Node() {}
+		};
+
+		class Block
+		{
+		public:
+			Node* nodes{ nullptr };
+			std::size_t blockSize{ 0 };
+			Block* next{ nullptr };
+
+			Block(std::size_t blockSize);
+			~Block();
+		};
+	};
+}
+#include "MergeableHeap.hpp"
+#endif
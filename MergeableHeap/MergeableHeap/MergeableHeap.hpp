@@ -0,0 +1,455 @@
+#ifndef JML_MERGEABLE_HEAP_HPP
+#define JML_MERGEABLE_HEAP_HPP
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+
+namespace JML
+{
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	MergeableHeap<T, comparator>::MergeableHeap(std::size_t reserveNum)
+	{
+		reserve(reserveNum);
+	}
+
+	// Copy constructor
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	MergeableHeap<T, comparator>::MergeableHeap(const MergeableHeap<T, comparator>& heap)
+	{
+		copyFrom(heap);
+	}
+
+	// Move constructor
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	MergeableHeap<T, comparator>::MergeableHeap(MergeableHeap<T, comparator>&& heap) noexcept :
+		root{heap.root}, heapSize{heap.heapSize}, capacity{heap.capacity}, blocks{heap.blocks}, lastBlock{heap.lastBlock},
+		freeHead{heap.freeHead}, freeTail{heap.freeTail}
+	{
+		// An empty pool is a valid state, so the old heap doesn't need a new allocation
+		heap.root = nullptr;
+		heap.heapSize = 0;
+		heap.capacity = 0;
+		heap.blocks = heap.lastBlock = nullptr;
+		heap.freeHead = heap.freeTail = nullptr;
+	}
+
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	MergeableHeap<T, comparator>::~MergeableHeap()
+	{
+		release();
+	}
+
+	// Copy assignment
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	MergeableHeap<T, comparator>& MergeableHeap<T, comparator>::operator=(const MergeableHeap<T, comparator>& heap)
+	{
+		if (&heap == this)
+			return *this;
+
+		// Copying into a temporary first leaves this heap unchanged if an item copy throws
+		MergeableHeap<T, comparator> copy{ heap };
+		return *this = static_cast<MergeableHeap<T, comparator>&&>(copy);
+	}
+
+	// Move assignment
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	MergeableHeap<T, comparator>& MergeableHeap<T, comparator>::operator=(MergeableHeap<T, comparator>&& heap) noexcept
+	{
+		if (&heap == this)
+			return *this;
+
+		release();
+		root = heap.root;
+		heapSize = heap.heapSize;
+		capacity = heap.capacity;
+		blocks = heap.blocks;
+		lastBlock = heap.lastBlock;
+		freeHead = heap.freeHead;
+		freeTail = heap.freeTail;
+
+		heap.root = nullptr;
+		heap.heapSize = 0;
+		heap.capacity = 0;
+		heap.blocks = heap.lastBlock = nullptr;
+		heap.freeHead = heap.freeTail = nullptr;
+
+		return *this;
+	}
+
+	// Heaps are equal if they hold the same items, so this compares the pop order of copies of both heaps
+	template <typename T1, bool (*comparator1)(const T1&, const T1&)>
+	bool operator==(const MergeableHeap<T1, comparator1>& heap1, const MergeableHeap<T1, comparator1>& heap2)
+	{
+		if (heap1.heapSize == heap2.heapSize)
+		{
+			MergeableHeap<T1, comparator1> copy1{ heap1 };
+			MergeableHeap<T1, comparator1> copy2{ heap2 };
+			while (!copy1.empty())
+			{
+				if (copy1.top() != copy2.top())
+					return false;
+
+				copy1.pop();
+				copy2.pop();
+			}
+			return true;
+		}
+		return false;
+	}
+
+	template <typename T1, bool (*comparator1)(const T1&, const T1&)>
+	bool operator!=(const MergeableHeap<T1, comparator1>& heap1, const MergeableHeap<T1, comparator1>& heap2)
+	{
+		return !operator==(heap1, heap2);
+	}
+
+	// Returns the number of items in the heap
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	std::size_t MergeableHeap<T, comparator>::size() const
+	{
+		return heapSize;
+	}
+
+	// Returns true if the heap has no items
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	bool MergeableHeap<T, comparator>::empty() const
+	{
+		return heapSize == 0;
+	}
+
+	// Clears all items from the heap. Pooled nodes are kept for reuse
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void MergeableHeap<T, comparator>::clear()
+	{
+		destroyItems();
+		freeHead = freeTail = nullptr;
+		for (Block* block{ blocks }; block; block = block->next)
+		{
+			for (std::size_t i{ 0 }; i < block->blockSize; ++i)
+			{
+				freeNode(block->nodes + i);
+			}
+		}
+		root = nullptr;
+		heapSize = 0;
+	}
+
+	// Inserts the given item into the heap in constant time. Supports perfect forwarding
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	template <typename U> void MergeableHeap<T, comparator>::insert(U&& item)
+	{
+		Node* node{ allocateNode() };
+		try
+		{
+			new (&node->item) T(static_cast<U&&>(item));
+		}
+		catch (...)
+		{
+			freeNode(node);
+			throw;
+		}
+		root = link(root, node);
+		++heapSize;
+	}
+
+	// Returns a reference to the item at the top of the heap. Raises std::range_error if the heap is empty
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	T& MergeableHeap<T, comparator>::top()
+	{
+		if (heapSize == 0)
+			throw std::range_error("Cannot return the top of an empty heap");
+
+		return root->item;
+	}
+
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	const T& MergeableHeap<T, comparator>::top() const
+	{
+		if (heapSize == 0)
+			throw std::range_error("Cannot return the top of an empty heap");
+
+		return root->item;
+	}
+
+	// Removes the item at the top of the heap in amortized logarithmic time
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void MergeableHeap<T, comparator>::pop()
+	{
+		if (heapSize == 0)
+			throw std::range_error("Cannot pop an empty heap");
+
+		Node* oldRoot{ root };
+		root = mergePairs(root->child);
+		oldRoot->item.~T();
+		freeNode(oldRoot);
+		--heapSize;
+	}
+
+	// Reserves at least reserveNum pooled nodes
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void MergeableHeap<T, comparator>::reserve(std::size_t reserveNum)
+	{
+		if (reserveNum > capacity)
+			addBlock(reserveNum - capacity);
+	}
+
+	// Moves every item of the given heap into this one in constant time. The given heap's node pool is taken over and it's left empty
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void MergeableHeap<T, comparator>::meld(MergeableHeap<T, comparator>& heap)
+	{
+		if (&heap == this)
+			return;
+
+		root = link(root, heap.root);
+		heapSize += heap.heapSize;
+		capacity += heap.capacity;
+		if (heap.blocks)
+		{
+			if (lastBlock)
+				lastBlock->next = heap.blocks;
+			else
+				blocks = heap.blocks;
+
+			lastBlock = heap.lastBlock;
+		}
+		if (heap.freeHead)
+		{
+			if (freeTail)
+				freeTail->sibling = heap.freeHead;
+			else
+				freeHead = heap.freeHead;
+
+			freeTail = heap.freeTail;
+		}
+
+		heap.root = nullptr;
+		heap.heapSize = 0;
+		heap.capacity = 0;
+		heap.blocks = heap.lastBlock = nullptr;
+		heap.freeHead = heap.freeTail = nullptr;
+	}
+
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void MergeableHeap<T, comparator>::meld(MergeableHeap<T, comparator>&& heap)
+	{
+		meld(heap);
+	}
+
+	// Links the two given trees and returns the root of the result. Both trees must have no siblings
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	MergeableHeap<T, comparator>::Node* MergeableHeap<T, comparator>::link(Node* node1, Node* node2)
+	{
+		if (!node1)
+			return node2;
+
+		if (!node2)
+			return node1;
+
+		if (comparator(node2->item, node1->item))
+		{
+			Node* temp{ node1 };
+			node1 = node2;
+			node2 = temp;
+		}
+		node2->sibling = node1->child;
+		node1->child = node2;
+		return node1;
+	}
+
+	// Combines the sibling list starting at first into a single tree using the two-pass pairing strategy. Iterative so that long sibling lists can't overflow the stack
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	MergeableHeap<T, comparator>::Node* MergeableHeap<T, comparator>::mergePairs(Node* first)
+	{
+		// First pass: linking pairs from left to right. The results are chained in reverse order through their sibling pointers
+		Node* pairs{ nullptr };
+		while (first)
+		{
+			Node* node1{ first };
+			Node* node2{ first->sibling };
+			if (!node2)
+			{
+				node1->sibling = pairs;
+				pairs = node1;
+				break;
+			}
+			first = node2->sibling;
+			node1->sibling = nullptr;
+			node2->sibling = nullptr;
+			Node* linked{ link(node1, node2) };
+			linked->sibling = pairs;
+			pairs = linked;
+		}
+
+		// Second pass: linking the pairs from right to left
+		Node* result{ nullptr };
+		while (pairs)
+		{
+			Node* next{ pairs->sibling };
+			pairs->sibling = nullptr;
+			result = link(result, pairs);
+			pairs = next;
+		}
+		return result;
+	}
+
+	// Takes a node from the pool, growing the pool geometrically if it's exhausted
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	MergeableHeap<T, comparator>::Node* MergeableHeap<T, comparator>::allocateNode()
+	{
+		if (!freeHead)
+			addBlock(capacity > BLOCKSIZE ? capacity : BLOCKSIZE);
+
+		Node* node{ freeHead };
+		freeHead = node->sibling;
+		if (!freeHead)
+			freeTail = nullptr;
+
+		node->child = nullptr;
+		node->sibling = nullptr;
+		return node;
+	}
+
+	// Returns the given node to the pool
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void MergeableHeap<T, comparator>::freeNode(Node* node)
+	{
+		node->child = nullptr;
+		node->sibling = freeHead;
+		if (!freeHead)
+			freeTail = node;
+
+		freeHead = node;
+	}
+
+	// Adds a block of blockSize nodes to the pool
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void MergeableHeap<T, comparator>::addBlock(std::size_t blockSize)
+	{
+		Block* block{ new Block(blockSize) };
+		if (lastBlock)
+			lastBlock->next = block;
+		else
+			blocks = block;
+
+		lastBlock = block;
+		capacity += blockSize;
+		for (std::size_t i{ 0 }; i < blockSize; ++i)
+		{
+			freeNode(block->nodes + i);
+		}
+	}
+
+	// Copies the items of the given heap into this (empty) heap, preserving the tree shape. Only called by the copy constructor,
+	// so if an item copy throws, the items copied so far and the pool are freed before rethrowing
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void MergeableHeap<T, comparator>::copyFrom(const MergeableHeap<T, comparator>& heap)
+	{
+		reserve(heap.heapSize ? heap.heapSize : 1);
+		if (!heap.root)
+			return;
+
+		// Each node is pushed once, so the explicit stack never holds more than heapSize pairs. Nodes are linked into the copy
+		// only after their item is constructed, so the partial tree can be destroyed like a whole one
+		Node** sourceStack{ new Node*[heap.heapSize] };
+		Node** copyStack{ new Node*[heap.heapSize] };
+		std::size_t stackSize{ 0 };
+		Node* node{ allocateNode() };
+		try
+		{
+			new (&node->item) T(heap.root->item);
+			root = node;
+			sourceStack[stackSize] = heap.root;
+			copyStack[stackSize++] = root;
+			while (stackSize > 0)
+			{
+				--stackSize;
+				Node* source{ sourceStack[stackSize] };
+				Node* copy{ copyStack[stackSize] };
+				if (source->child)
+				{
+					node = allocateNode();
+					new (&node->item) T(source->child->item);
+					copy->child = node;
+					sourceStack[stackSize] = source->child;
+					copyStack[stackSize++] = copy->child;
+				}
+				if (source->sibling)
+				{
+					node = allocateNode();
+					new (&node->item) T(source->sibling->item);
+					copy->sibling = node;
+					sourceStack[stackSize] = source->sibling;
+					copyStack[stackSize++] = copy->sibling;
+				}
+			}
+		}
+		catch (...)
+		{
+			delete[] sourceStack;
+			delete[] copyStack;
+			release();
+			throw;
+		}
+		heapSize = heap.heapSize;
+		delete[] sourceStack;
+		delete[] copyStack;
+	}
+
+	// Destroys the items of every node in the tree. Rotates each child up in place of its parent until the parent has none,
+	// so the tree is walked in linear time without a stack. The nodes are left for the caller to return to the pool
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void MergeableHeap<T, comparator>::destroyItems()
+	{
+		Node* node{ root };
+		while (node)
+		{
+			if (node->child)
+			{
+				Node* child{ node->child };
+				node->child = child->sibling;
+				child->sibling = node;
+				node = child;
+			}
+			else
+			{
+				Node* next{ node->sibling };
+				node->item.~T();
+				node = next;
+			}
+		}
+		root = nullptr;
+	}
+
+	// Frees the node pool and leaves the heap empty
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void MergeableHeap<T, comparator>::release()
+	{
+		destroyItems();
+		while (blocks)
+		{
+			Block* next{ blocks->next };
+			delete blocks;
+			blocks = next;
+		}
+		root = nullptr;
+		heapSize = 0;
+		capacity = 0;
+		lastBlock = nullptr;
+		freeHead = freeTail = nullptr;
+	}
+
+	// Block class implementation
+
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	MergeableHeap<T, comparator>::Block::Block(std::size_t blockSize) :
+		nodes{ new Node[blockSize] }, blockSize{blockSize}
+	{}
+
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	MergeableHeap<T, comparator>::Block::~Block()
+	{
+		delete[] nodes;
+	}
+}
+#endif
@@ -0,0 +1,109 @@
+#if 0
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+
+#include "Heap.h"
+#include "MergeableHeap.h"
+
+// Simulates work rebalancing: every round each worker queue receives new items, then all queues are merged into one and the best items are popped
+constexpr std::size_t NUM_WORKERS{ 16 };
+constexpr std::size_t NUM_ROUNDS{ 200 };
+constexpr std::size_t ITEMS_PER_ROUND{ 5000 };
+constexpr std::size_t POPS_PER_ROUND{ 1000 };
+
+long long benchmarkHeap(const int* values)
+{
+	auto start{ std::chrono::steady_clock::now() };
+	JML::Heap<int> merged;
+	JML::Heap<int>* workers{ new JML::Heap<int>[NUM_WORKERS] };
+	std::size_t next{ 0 };
+	long long checksum{ 0 };
+	for (std::size_t round{ 0 }; round < NUM_ROUNDS; ++round)
+	{
+		for (std::size_t worker{ 0 }; worker < NUM_WORKERS; ++worker)
+		{
+			for (std::size_t i{ 0 }; i < ITEMS_PER_ROUND; ++i)
+			{
+				workers[worker].insert(values[next++]);
+			}
+		}
+
+		// An array-backed heap can only merge by re-inserting every item
+		for (std::size_t worker{ 0 }; worker < NUM_WORKERS; ++worker)
+		{
+			while (!workers[worker].empty())
+			{
+				merged.insert(workers[worker].top());
+				workers[worker].pop();
+			}
+		}
+
+		for (std::size_t i{ 0 }; i < POPS_PER_ROUND; ++i)
+		{
+			checksum += merged.top();
+			merged.pop();
+		}
+	}
+	delete[] workers;
+	auto end{ std::chrono::steady_clock::now() };
+	std::cout << "Heap checksum: " << checksum << '\n';
+	return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+}
+
+long long benchmarkMergeableHeap(const int* values)
+{
+	auto start{ std::chrono::steady_clock::now() };
+	JML::MergeableHeap<int> merged;
+	JML::MergeableHeap<int>* workers{ new JML::MergeableHeap<int>[NUM_WORKERS] };
+	std::size_t next{ 0 };
+	long long checksum{ 0 };
+	for (std::size_t round{ 0 }; round < NUM_ROUNDS; ++round)
+	{
+		for (std::size_t worker{ 0 }; worker < NUM_WORKERS; ++worker)
+		{
+			for (std::size_t i{ 0 }; i < ITEMS_PER_ROUND; ++i)
+			{
+				workers[worker].insert(values[next++]);
+			}
+		}
+
+		for (std::size_t worker{ 0 }; worker < NUM_WORKERS; ++worker)
+		{
+			merged.meld(workers[worker]);
+		}
+
+		for (std::size_t i{ 0 }; i < POPS_PER_ROUND; ++i)
+		{
+			checksum += merged.top();
+			merged.pop();
+		}
+	}
+	delete[] workers;
+	auto end{ std::chrono::steady_clock::now() };
+	std::cout << "MergeableHeap checksum: " << checksum << '\n';
+	return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+}
+
+int main()
+{
+	std::size_t numValues{ NUM_WORKERS * NUM_ROUNDS * ITEMS_PER_ROUND };
+	int* values{ new int[numValues] };
+	std::mt19937 generator{ 42 };
+	std::uniform_int_distribution<int> distribution{ 0, 1000000000 };
+	for (std::size_t i{ 0 }; i < numValues; ++i)
+	{
+		values[i] = distribution(generator);
+	}
+
+	std::cout << NUM_ROUNDS << " rounds of " << NUM_WORKERS << " workers x " << ITEMS_PER_ROUND << " inserts, one merge and "
+		<< POPS_PER_ROUND << " pops\n";
+	long long heapTime{ benchmarkHeap(values) };
+	long long mergeableTime{ benchmarkMergeableHeap(values) };
+	std::cout << "Heap (merge by re-insertion): " << heapTime << " ms\n";
+	std::cout << "MergeableHeap (meld): " << mergeableTime << " ms\n";
+	delete[] values;
+	return 0;
+}
+#endif
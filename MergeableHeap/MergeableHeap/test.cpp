@@ -0,0 +1,99 @@
+#if 1
+#include <iostream>
+#include <string>
+
+#include "MergeableHeap.h"
+
+bool lessThan(const int& x, const int& y)
+{
+	return x < y;
+}
+
+// Item with no default constructor that counts how many instances are alive
+struct Task
+{
+	static int alive;
+	int priority;
+	std::string name;
+
+	Task(int priority, const std::string& name) :
+		priority{priority}, name{name}
+	{
+		++alive;
+	}
+
+	Task(const Task& task) :
+		priority{task.priority}, name{task.name}
+	{
+		++alive;
+	}
+
+	~Task()
+	{
+		--alive;
+	}
+
+	Task& operator=(const Task& task) = default;
+};
+
+int Task::alive{ 0 };
+
+bool morePressing(const Task& x, const Task& y)
+{
+	return x.priority > y.priority;
+}
+
+int main()
+{
+	std::cout << "Max heap with starting capacity 2:" << '\n';
+	JML::MergeableHeap<int> maxHeap{ 2 };
+	maxHeap.insert(5);
+	maxHeap.insert(17);
+	maxHeap.insert(3);
+	maxHeap.insert(0);
+	maxHeap.insert(6);
+
+	std::cout << "Popping from max heap\n";
+	while (!maxHeap.empty())
+	{
+		std::cout << maxHeap.top() << '\n';
+		maxHeap.pop();
+	}
+
+	std::cout << '\n';
+	std::cout << "Melding two min heaps:" << '\n';
+	JML::MergeableHeap<int, lessThan> minHeap1;
+	JML::MergeableHeap<int, lessThan> minHeap2;
+	for (int i{ 0 }; i < 5; ++i)
+	{
+		minHeap1.insert(2 * i);
+		minHeap2.insert(2 * i + 1);
+	}
+	minHeap1.meld(minHeap2);
+	std::cout << "Size after meld: " << minHeap1.size() << ", size of the melded heap: " << minHeap2.size() << '\n';
+
+	JML::MergeableHeap<int, lessThan> copy{ minHeap1 };
+	std::cout << "Copy equals original: " << (copy == minHeap1) << '\n';
+
+	std::cout << "Popping from min heap\n";
+	while (!minHeap1.empty())
+	{
+		std::cout << minHeap1.top() << '\n';
+		minHeap1.pop();
+	}
+
+	std::cout << '\n';
+	std::cout << "Heap of tasks, which can't be default constructed:" << '\n';
+	JML::MergeableHeap<Task, morePressing> tasks;
+	tasks.insert(Task{ 2, "write the report" });
+	tasks.insert(Task{ 5, "fix the build" });
+	tasks.insert(Task{ 1, "water the plants" });
+	JML::MergeableHeap<Task, morePressing> taskCopy{ tasks };
+	std::cout << "Most pressing task: " << tasks.top().name << '\n';
+	tasks.pop();
+	std::cout << "Tasks alive after a pop: " << Task::alive << '\n';
+	taskCopy.clear();
+	std::cout << "Tasks alive after clearing the copy: " << Task::alive << '\n';
+	return 0;
+}
+#endif
@@ -0,0 +1,43 @@
+#ifndef JML_BUCKET_QUEUE_H
+#define JML_BUCKET_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "RadixHeap.h"
+#include "Stack.h"
+
+namespace JML
+{
+	// Dial's bucket queue: a monotone min-priority queue for integer keys that never differ by more than maxSpread from the last key returned,
+	// such as Dijkstra distances with edge weights of at most maxSpread. Keeps maxSpread + 1 buckets in a circular array
+	template <typename T, std::uint64_t (*keyOf)(const T&) = radixKey>
+	class BucketQueue
+	{
+	public:
+		BucketQueue(std::size_t maxSpread);
+		BucketQueue(const BucketQueue<T, keyOf>& queue);  // Copy constructor
+		BucketQueue(BucketQueue<T, keyOf>&& queue) noexcept;  // Move constructor
+		~BucketQueue();
+		BucketQueue<T, keyOf>& operator=(const BucketQueue<T, keyOf>& queue);  // Copy assignment
+		BucketQueue<T, keyOf>& operator=(BucketQueue<T, keyOf>&& queue) noexcept;  // Move assignment
+		std::size_t size() const;
+		bool empty() const;
+		void clear();
+		template <typename U> void insert(U&& item);
+		T& top();
+		const T& top() const;
+		void pop();
+
+	private:
+		std::size_t numBuckets{};
+		// Looking at the top may advance the current key, so the cursor is mutable to keep top usable on const queues
+		Stack<T>* buckets{};
+		mutable std::uint64_t current{ 0 };
+		std::size_t numItems{ 0 };
+
+		void advance() const;
+	};
+}
+#include "BucketQueue.hpp"
+#endif
@@ -0,0 +1,167 @@
+#ifndef JML_BUCKET_QUEUE_HPP
+#define JML_BUCKET_QUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "Stack.h"
+
+namespace JML
+{
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	BucketQueue<T, keyOf>::BucketQueue(std::size_t maxSpread) :
+		numBuckets{ maxSpread + 1 }, buckets{ new Stack<T>[maxSpread + 1] }
+	{}
+
+	// Copy constructor
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	BucketQueue<T, keyOf>::BucketQueue(const BucketQueue<T, keyOf>& queue) :
+		numBuckets{ queue.numBuckets }, buckets{ new Stack<T>[queue.numBuckets] }, current{ queue.current }, numItems{ queue.numItems }
+	{
+		for (std::size_t i{ 0 }; i < numBuckets; ++i)
+		{
+			buckets[i] = queue.buckets[i];
+		}
+	}
+
+	// Move constructor
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	BucketQueue<T, keyOf>::BucketQueue(BucketQueue<T, keyOf>&& queue) noexcept :
+		numBuckets{ queue.numBuckets }, buckets{ queue.buckets }, current{ queue.current }, numItems{ queue.numItems }
+	{
+		// Allocating new buckets so that the old queue is still valid after the move
+		queue.buckets = new Stack<T>[queue.numBuckets];
+		queue.current = 0;
+		queue.numItems = 0;
+	}
+
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	BucketQueue<T, keyOf>::~BucketQueue()
+	{
+		delete[] buckets;
+	}
+
+	// Copy assignment
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	BucketQueue<T, keyOf>& BucketQueue<T, keyOf>::operator=(const BucketQueue<T, keyOf>& queue)
+	{
+		if (&queue == this)
+			return *this;
+
+		delete[] buckets;
+		numBuckets = queue.numBuckets;
+		buckets = new Stack<T>[numBuckets];
+		current = queue.current;
+		numItems = queue.numItems;
+		for (std::size_t i{ 0 }; i < numBuckets; ++i)
+		{
+			buckets[i] = queue.buckets[i];
+		}
+		return *this;
+	}
+
+	// Move assignment
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	BucketQueue<T, keyOf>& BucketQueue<T, keyOf>::operator=(BucketQueue<T, keyOf>&& queue) noexcept
+	{
+		if (&queue == this)
+			return *this;
+
+		delete[] buckets;
+		numBuckets = queue.numBuckets;
+		buckets = queue.buckets;
+		current = queue.current;
+		numItems = queue.numItems;
+
+		// Allocating new buckets so that the old queue is still valid after the move
+		queue.buckets = new Stack<T>[queue.numBuckets];
+		queue.current = 0;
+		queue.numItems = 0;
+
+		return *this;
+	}
+
+	// Returns the number of items in the queue
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	std::size_t BucketQueue<T, keyOf>::size() const
+	{
+		return numItems;
+	}
+
+	// Returns true if the queue has no items
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	bool BucketQueue<T, keyOf>::empty() const
+	{
+		return numItems == 0;
+	}
+
+	// Clears all items from the queue and resets the current key to zero
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	void BucketQueue<T, keyOf>::clear()
+	{
+		for (std::size_t i{ 0 }; i < numBuckets; ++i)
+		{
+			buckets[i].clear();
+		}
+		current = 0;
+		numItems = 0;
+	}
+
+	// Inserts the given item into the queue. Throws std::invalid_argument if its key is smaller than the last key returned or more than
+	// maxSpread larger. Supports perfect forwarding
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	template <typename U> void BucketQueue<T, keyOf>::insert(U&& item)
+	{
+		std::uint64_t key{ keyOf(item) };
+		if (key < current || key - current >= numBuckets)
+			throw std::invalid_argument("Key is outside of the range of the queue");
+
+		buckets[key % numBuckets].push(static_cast<U&&>(item));
+		++numItems;
+	}
+
+	// Returns a reference to an item with the smallest key. Raises std::range_error if the queue is empty
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	T& BucketQueue<T, keyOf>::top()
+	{
+		if (numItems == 0)
+			throw std::range_error("Cannot return the top of an empty queue");
+
+		advance();
+		return buckets[current % numBuckets].top();
+	}
+
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	const T& BucketQueue<T, keyOf>::top() const
+	{
+		if (numItems == 0)
+			throw std::range_error("Cannot return the top of an empty queue");
+
+		advance();
+		return buckets[current % numBuckets].top();
+	}
+
+	// Removes an item with the smallest key
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	void BucketQueue<T, keyOf>::pop()
+	{
+		if (numItems == 0)
+			throw std::range_error("Cannot pop an empty queue");
+
+		advance();
+		buckets[current % numBuckets].pop();
+		--numItems;
+	}
+
+	// Moves the current key forward to the first non-empty bucket. The queue must not be empty
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	void BucketQueue<T, keyOf>::advance() const
+	{
+		while (buckets[current % numBuckets].empty())
+		{
+			++current;
+		}
+	}
+}
+#endif
@@ -0,0 +1,43 @@
+#ifndef JML_RADIX_HEAP_H
+#define JML_RADIX_HEAP_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Stack.h"
+
+namespace JML
+{
+	template <typename T>
+	std::uint64_t radixKey(const T& item);
+
+	// Monotone min-priority queue for unsigned integer keys, taken from items with keyOf. Inserted keys must not be smaller than the key of
+	// the last item returned by top or pop, which is always the case in Dijkstra-style searches. All operations are amortized O(1)
+	// for a fixed key width
+	template <typename T, std::uint64_t (*keyOf)(const T&) = radixKey>
+	class RadixHeap
+	{
+	public:
+		RadixHeap();
+		std::size_t size() const;
+		bool empty() const;
+		void clear();
+		template <typename U> void insert(U&& item);
+		T& top();
+		const T& top() const;
+		void pop();
+
+	private:
+		static constexpr std::size_t NUMBUCKETS{ 65 };  // One bucket per bit position plus one for keys equal to the last key
+		// Looking at the top may redistribute a bucket, so the buckets are mutable to keep top usable on const heaps
+		mutable Stack<T> buckets[NUMBUCKETS];
+		mutable Stack<T> scratch{};
+		mutable std::uint64_t last{ 0 };
+		std::size_t numItems{ 0 };
+
+		static std::size_t bucketIndex(std::uint64_t key, std::uint64_t base);
+		void refill() const;
+	};
+}
+#include "RadixHeap.hpp"
+#endif
@@ -0,0 +1,133 @@
+#ifndef JML_RADIX_HEAP_HPP
+#define JML_RADIX_HEAP_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "Stack.h"
+
+namespace JML
+{
+	template <typename T>
+	std::uint64_t radixKey(const T& item)
+	{
+		return static_cast<std::uint64_t>(item);
+	}
+
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	RadixHeap<T, keyOf>::RadixHeap()
+	{}
+
+	// Returns the number of items in the heap
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	std::size_t RadixHeap<T, keyOf>::size() const
+	{
+		return numItems;
+	}
+
+	// Returns true if the heap has no items
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	bool RadixHeap<T, keyOf>::empty() const
+	{
+		return numItems == 0;
+	}
+
+	// Clears all items from the heap and resets the last key to zero
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	void RadixHeap<T, keyOf>::clear()
+	{
+		for (std::size_t i{ 0 }; i < NUMBUCKETS; ++i)
+		{
+			buckets[i].clear();
+		}
+		last = 0;
+		numItems = 0;
+	}
+
+	// Inserts the given item into the heap. Throws std::invalid_argument if its key is smaller than the last key returned. Supports perfect forwarding
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	template <typename U> void RadixHeap<T, keyOf>::insert(U&& item)
+	{
+		std::uint64_t key{ keyOf(item) };
+		if (key < last)
+			throw std::invalid_argument("Key is smaller than the last key returned by the heap");
+
+		buckets[bucketIndex(key, last)].push(static_cast<U&&>(item));
+		++numItems;
+	}
+
+	// Returns a reference to an item with the smallest key. Raises std::range_error if the heap is empty
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	T& RadixHeap<T, keyOf>::top()
+	{
+		if (numItems == 0)
+			throw std::range_error("Cannot return the top of an empty heap");
+
+		refill();
+		return buckets[0].top();
+	}
+
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	const T& RadixHeap<T, keyOf>::top() const
+	{
+		if (numItems == 0)
+			throw std::range_error("Cannot return the top of an empty heap");
+
+		refill();
+		return buckets[0].top();
+	}
+
+	// Removes an item with the smallest key
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	void RadixHeap<T, keyOf>::pop()
+	{
+		if (numItems == 0)
+			throw std::range_error("Cannot pop an empty heap");
+
+		refill();
+		buckets[0].pop();
+		--numItems;
+	}
+
+	// Returns the bucket for the given key: the position of the highest bit in which it differs from base
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	std::size_t RadixHeap<T, keyOf>::bucketIndex(std::uint64_t key, std::uint64_t base)
+	{
+		return static_cast<std::size_t>(64 - std::countl_zero(key ^ base));
+	}
+
+	// Ensures that bucket 0 holds the items with the smallest key. If it's empty, the first non-empty bucket is redistributed around its
+	// smallest key, which sends at least one item to bucket 0 and every other item to a lower bucket
+	template <typename T, std::uint64_t (*keyOf)(const T&)>
+	void RadixHeap<T, keyOf>::refill() const
+	{
+		if (!buckets[0].empty())
+			return;
+
+		std::size_t index{ 1 };
+		while (buckets[index].empty())
+		{
+			++index;
+		}
+
+		std::uint64_t minKey{ keyOf(buckets[index].top()) };
+		while (!buckets[index].empty())
+		{
+			std::uint64_t key{ keyOf(buckets[index].top()) };
+			if (key < minKey)
+				minKey = key;
+
+			scratch.push(static_cast<T&&>(buckets[index].top()));
+			buckets[index].pop();
+		}
+		last = minKey;
+		while (!scratch.empty())
+		{
+			buckets[bucketIndex(keyOf(scratch.top()), last)].push(static_cast<T&&>(scratch.top()));
+			scratch.pop();
+		}
+	}
+}
+#endif
@@ -0,0 +1,115 @@
+#if 0
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#include "BucketQueue.h"
+#include "Graph.h"
+#include "Heap.h"
+#include "RadixHeap.h"
+
+constexpr int NUM_VERTICES{ 200000 };
+constexpr int NUM_EDGES{ 2000000 };
+constexpr int MAX_WEIGHT{ 100 };
+constexpr int NUM_SOURCES{ 5 };
+
+struct QueueItem
+{
+	int vertex{};
+	std::uint64_t distance{};
+};
+
+bool closer(const QueueItem& item1, const QueueItem& item2)
+{
+	return item1.distance < item2.distance;
+}
+
+std::uint64_t itemDistance(const QueueItem& item)
+{
+	return item.distance;
+}
+
+// Dijkstra with lazy deletion: stale queue entries are skipped when popped. Returns the sum of the distances to the reachable vertices
+template <typename Queue>
+std::uint64_t dijkstra(const JML::Graph<int, int>& graph, Queue& queue, int source, std::uint64_t* distances)
+{
+	constexpr std::uint64_t UNREACHED{ ~static_cast<std::uint64_t>(0) };
+	for (int i{ 0 }; i < NUM_VERTICES; ++i)
+	{
+		distances[i] = UNREACHED;
+	}
+	distances[source] = 0;
+	queue.insert(QueueItem{ source, 0 });
+	while (!queue.empty())
+	{
+		QueueItem current{ queue.top() };
+		queue.pop();
+		if (current.distance != distances[current.vertex])
+			continue;
+
+		for (auto& [id, weight] : graph.edgesOf(current.vertex))
+		{
+			int key{ graph.key(id) };
+			std::uint64_t distance{ current.distance + static_cast<std::uint64_t>(weight) };
+			if (distance < distances[key])
+			{
+				distances[key] = distance;
+				queue.insert(QueueItem{ key, distance });
+			}
+		}
+	}
+
+	std::uint64_t sum{ 0 };
+	for (int i{ 0 }; i < NUM_VERTICES; ++i)
+	{
+		if (distances[i] != UNREACHED)
+			sum += distances[i];
+	}
+	return sum;
+}
+
+// Runs one search per source, each on a fresh copy of the given empty queue since monotone queues can't go back to smaller keys
+template <typename Queue>
+void benchmark(const char* name, const JML::Graph<int, int>& graph, const Queue& emptyQueue, std::uint64_t* distances)
+{
+	std::uint64_t checksum{ 0 };
+	auto start{ std::chrono::steady_clock::now() };
+	for (int source{ 0 }; source < NUM_SOURCES; ++source)
+	{
+		Queue queue{ emptyQueue };
+		checksum += dijkstra(graph, queue, source, distances);
+	}
+	auto end{ std::chrono::steady_clock::now() };
+	std::cout << name << ": " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms (checksum " << checksum << ")\n";
+}
+
+int main()
+{
+	std::cout << "Building a graph with " << NUM_VERTICES << " vertices and " << NUM_EDGES << " edges with weights from 1 to " << MAX_WEIGHT << '\n';
+	JML::Graph<int, int> graph;
+	for (int i{ 0 }; i < NUM_VERTICES; ++i)
+	{
+		graph.addVertex(i, i);
+	}
+	std::mt19937 generator{ 3 };
+	std::uniform_int_distribution<int> vertexDistribution{ 0, NUM_VERTICES - 1 };
+	std::uniform_int_distribution<int> weightDistribution{ 1, MAX_WEIGHT };
+	for (int i{ 0 }; i < NUM_EDGES; ++i)
+	{
+		graph.addEdge(vertexDistribution(generator), vertexDistribution(generator), weightDistribution(generator));
+	}
+
+	std::uint64_t* distances{ new std::uint64_t[NUM_VERTICES] };
+	std::cout << "Dijkstra from " << NUM_SOURCES << " sources:\n";
+	JML::Heap<QueueItem, closer> heap;
+	benchmark("Heap", graph, heap, distances);
+	JML::RadixHeap<QueueItem, itemDistance> radixHeap;
+	benchmark("RadixHeap", graph, radixHeap, distances);
+	JML::BucketQueue<QueueItem, itemDistance> bucketQueue{ MAX_WEIGHT };
+	benchmark("BucketQueue", graph, bucketQueue, distances);
+	delete[] distances;
+	return 0;
+}
+#endif
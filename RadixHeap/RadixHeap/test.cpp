@@ -0,0 +1,56 @@
+#if 1
+#include <cstdint>
+#include <iostream>
+
+#include "BucketQueue.h"
+#include "RadixHeap.h"
+
+struct Entry
+{
+	char key{};
+	std::uint64_t distance{};
+};
+
+std::uint64_t entryDistance(const Entry& entry)
+{
+	return entry.distance;
+}
+
+int main()
+{
+	std::cout << "Radix heap:" << '\n';
+	JML::RadixHeap<int> radixHeap;
+	radixHeap.insert(5);
+	radixHeap.insert(17);
+	radixHeap.insert(3);
+	radixHeap.insert(0);
+	radixHeap.insert(6);
+
+	std::cout << "Popping from radix heap\n";
+	while (!radixHeap.empty())
+	{
+		std::cout << radixHeap.top() << '\n';
+		radixHeap.pop();
+	}
+
+	std::cout << '\n';
+	std::cout << "Bucket queue with a maximum spread of 10:" << '\n';
+	JML::BucketQueue<Entry, entryDistance> bucketQueue{ 10 };
+	bucketQueue.insert(Entry{ 'a', 4 });
+	bucketQueue.insert(Entry{ 'b', 9 });
+	bucketQueue.insert(Entry{ 'c', 1 });
+	std::cout << "Popping " << bucketQueue.top().key << '\n';
+	bucketQueue.pop();
+
+	// Keys may now reach up to 1 + 10
+	bucketQueue.insert(Entry{ 'd', 11 });
+	bucketQueue.insert(Entry{ 'e', 2 });
+	std::cout << "Popping from bucket queue\n";
+	while (!bucketQueue.empty())
+	{
+		std::cout << bucketQueue.top().key << " at " << bucketQueue.top().distance << '\n';
+		bucketQueue.pop();
+	}
+	return 0;
+}
+#endif
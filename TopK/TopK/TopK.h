@@ -0,0 +1,37 @@
+#ifndef JML_TOP_K_H
+#define JML_TOP_K_H
+
+#include <cstddef>
+
+#include "Heap.h"
+
+namespace JML
+{
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	bool topKWorse(const T& x, const T& y);
+
+	// Keeps the k best items (according to comparator) seen in a stream. The kept items live in a heap with the worst item on top,
+	// so an item that can't make the cut is rejected with a single comparison
+	template <typename T, bool (*comparator)(const T&, const T&) = heapGreater>
+	class TopK
+	{
+	public:
+		TopK(std::size_t k);
+		std::size_t size() const;
+		bool empty() const;
+		bool full() const;
+		std::size_t capacity() const;
+		void clear();
+		template <typename U> bool offer(U&& item);
+		void offerMany(const T* items, std::size_t count);
+		const T& threshold() const;
+		std::size_t drainSorted(T* output);
+
+	private:
+		static constexpr std::size_t FILTERSIZE{ 16 };  // The number of items checked against the threshold at once by offerMany
+		std::size_t k{};
+		Heap<T, topKWorse<T, comparator>> heap;
+	};
+}
+#include "TopK.hpp"
+#endif
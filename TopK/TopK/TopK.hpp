@@ -0,0 +1,142 @@
+#ifndef JML_TOP_K_HPP
+#define JML_TOP_K_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Heap.h"
+
+namespace JML
+{
+	// Inverts the given comparator so that the worst kept item sits at the top of the heap
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	bool topKWorse(const T& x, const T& y)
+	{
+		return comparator(y, x);
+	}
+
+	// Creates a selector for the k best items. Storage for all k items is allocated up front
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	TopK<T, comparator>::TopK(std::size_t k) :
+		k{k}, heap{ k ? k : 1 }
+	{}
+
+	// Returns the number of items currently kept
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	std::size_t TopK<T, comparator>::size() const
+	{
+		return heap.size();
+	}
+
+	// Returns true if no items are kept
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	bool TopK<T, comparator>::empty() const
+	{
+		return heap.empty();
+	}
+
+	// Returns true if k items are kept, meaning that new items have to beat the threshold
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	bool TopK<T, comparator>::full() const
+	{
+		return heap.size() == k;
+	}
+
+	// Returns k
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	std::size_t TopK<T, comparator>::capacity() const
+	{
+		return k;
+	}
+
+	// Discards all kept items without releasing storage
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void TopK<T, comparator>::clear()
+	{
+		while (!heap.empty())
+		{
+			heap.pop();
+		}
+	}
+
+	// Offers the given item to the selector. Returns true if it's one of the k best seen so far. Supports perfect forwarding
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	template <typename U> bool TopK<T, comparator>::offer(U&& item)
+	{
+		if (heap.size() < k)
+		{
+			heap.insert(static_cast<U&&>(item));
+			return true;
+		}
+		if (k == 0 || !comparator(item, heap.top()))
+			return false;
+
+		heap.replaceTop(static_cast<U&&>(item));
+		return true;
+	}
+
+	// Offers count items from the given array. For arithmetic types, blocks of items are first checked against the threshold
+	// with a branch-free loop the compiler can vectorize, and blocks without a single candidate are skipped entirely
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	void TopK<T, comparator>::offerMany(const T* items, std::size_t count)
+	{
+		std::size_t i{ 0 };
+		if constexpr (std::is_arithmetic_v<T>)
+		{
+			while (i < count && !full())
+			{
+				offer(items[i++]);
+			}
+			if (k == 0)
+				return;
+
+			while (i + FILTERSIZE <= count)
+			{
+				// Copying the threshold so that the compiler knows the filter loop can't modify it
+				T current{ heap.top() };
+				unsigned int candidates{ 0 };
+				for (std::size_t j{ 0 }; j < FILTERSIZE; ++j)
+				{
+					candidates += comparator(items[i + j], current);
+				}
+				if (candidates)
+				{
+					for (std::size_t j{ 0 }; j < FILTERSIZE; ++j)
+					{
+						offer(items[i + j]);
+					}
+				}
+				i += FILTERSIZE;
+			}
+		}
+		for (; i < count; ++i)
+		{
+			offer(items[i]);
+		}
+	}
+
+	// Returns a reference to the worst kept item, which new items have to beat once the selector is full. Raises std::range_error if no items are kept
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	const T& TopK<T, comparator>::threshold() const
+	{
+		if (heap.empty())
+			throw std::range_error("Cannot return the threshold of an empty selector");
+
+		return heap.top();
+	}
+
+	// Moves the kept items into output from best to worst and empties the selector. Output must have room for size() items. Returns the number of items written
+	template <typename T, bool (*comparator)(const T&, const T&)>
+	std::size_t TopK<T, comparator>::drainSorted(T* output)
+	{
+		std::size_t count{ heap.size() };
+		for (std::size_t i{ count }; i > 0; --i)
+		{
+			output[i - 1] = static_cast<T&&>(heap.top());
+			heap.pop();
+		}
+		return count;
+	}
+}
+#endif
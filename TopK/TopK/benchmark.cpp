@@ -0,0 +1,92 @@
+#if 0
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+
+#include "Heap.h"
+#include "TopK.h"
+
+constexpr std::size_t STREAM_SIZE{ 100000000 };
+constexpr std::size_t CHUNK_SIZE{ 1000000 };
+constexpr std::size_t K{ 1000 };
+
+// Fills the chunk with the next pseudo-random scores of the stream
+void nextChunk(std::mt19937& generator, float* chunk)
+{
+	std::uniform_real_distribution<float> distribution{ 0.0f, 1.0f };
+	for (std::size_t i{ 0 }; i < CHUNK_SIZE; ++i)
+	{
+		chunk[i] = distribution(generator);
+	}
+}
+
+int main()
+{
+	float* chunk{ new float[CHUNK_SIZE] };
+	float* output{ new float[K] };
+	std::cout << "Top " << K << " of " << STREAM_SIZE << " scores\n";
+
+	// Generating the stream is timed separately so that it can be subtracted from the results below
+	std::mt19937 generator{ 1 };
+	auto start{ std::chrono::steady_clock::now() };
+	for (std::size_t done{ 0 }; done < STREAM_SIZE; done += CHUNK_SIZE)
+	{
+		nextChunk(generator, chunk);
+	}
+	auto end{ std::chrono::steady_clock::now() };
+	std::cout << "Generating the stream: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms\n";
+
+	// Baseline: a min-heap managed by hand with pop and insert
+	generator.seed(1);
+	start = std::chrono::steady_clock::now();
+	JML::Heap<float, JML::topKWorse<float, JML::heapGreater>> heap{ K };
+	for (std::size_t done{ 0 }; done < STREAM_SIZE; done += CHUNK_SIZE)
+	{
+		nextChunk(generator, chunk);
+		for (std::size_t i{ 0 }; i < CHUNK_SIZE; ++i)
+		{
+			if (heap.size() < K)
+				heap.insert(chunk[i]);
+			else if (chunk[i] > heap.top())
+			{
+				heap.pop();
+				heap.insert(chunk[i]);
+			}
+		}
+	}
+	end = std::chrono::steady_clock::now();
+	std::cout << "Heap with pop and insert: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, threshold "
+		<< heap.top() << '\n';
+
+	generator.seed(1);
+	start = std::chrono::steady_clock::now();
+	JML::TopK<float> topK{ K };
+	for (std::size_t done{ 0 }; done < STREAM_SIZE; done += CHUNK_SIZE)
+	{
+		nextChunk(generator, chunk);
+		for (std::size_t i{ 0 }; i < CHUNK_SIZE; ++i)
+		{
+			topK.offer(chunk[i]);
+		}
+	}
+	topK.drainSorted(output);
+	end = std::chrono::steady_clock::now();
+	std::cout << "TopK::offer: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, threshold " << output[K - 1] << '\n';
+
+	generator.seed(1);
+	start = std::chrono::steady_clock::now();
+	for (std::size_t done{ 0 }; done < STREAM_SIZE; done += CHUNK_SIZE)
+	{
+		nextChunk(generator, chunk);
+		topK.offerMany(chunk, CHUNK_SIZE);
+	}
+	topK.drainSorted(output);
+	end = std::chrono::steady_clock::now();
+	std::cout << "TopK::offerMany: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, threshold " << output[K - 1] << '\n';
+
+	delete[] output;
+	delete[] chunk;
+	return 0;
+}
+#endif
@@ -0,0 +1,40 @@
+#if 1
+#include <iostream>
+
+#include "TopK.h"
+
+bool lessThan(const int& x, const int& y)
+{
+	return x < y;
+}
+
+int main()
+{
+	int stream[]{ 5, 17, 3, 0, 6, 42, 8, 23, 1, 11 };
+	int output[4]{};
+
+	std::cout << "Four largest items:\n";
+	JML::TopK<int> largest{ 4 };
+	for (int item : stream)
+	{
+		std::cout << "Offering " << item << (largest.offer(item) ? ": kept" : ": rejected") << '\n';
+	}
+	std::cout << "Threshold: " << largest.threshold() << '\n';
+	std::size_t count{ largest.drainSorted(output) };
+	for (std::size_t i{ 0 }; i < count; ++i)
+	{
+		std::cout << output[i] << '\n';
+	}
+
+	std::cout << '\n';
+	std::cout << "Four smallest items (batched):\n";
+	JML::TopK<int, lessThan> smallest{ 4 };
+	smallest.offerMany(stream, 10);
+	count = smallest.drainSorted(output);
+	for (std::size_t i{ 0 }; i < count; ++i)
+	{
+		std::cout << output[i] << '\n';
+	}
+	return 0;
+}
+#endif
@@ -0,0 +1,38 @@
+#ifndef JML_UNION_FIND_H
+#define JML_UNION_FIND_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace JML
+{
+	// Disjoint sets over the elements 0 to size() - 1, stored as flat arrays of parents and ranks. Union by rank keeps the trees shallow and
+	// every find halves the path it walks, so any sequence of operations runs in near-constant amortized time per operation
+	class UnionFind
+	{
+	public:
+		UnionFind(std::size_t numElements = 0);
+		UnionFind(const UnionFind& sets);  // Copy constructor
+		UnionFind(UnionFind&& sets) noexcept;  // Move constructor
+		~UnionFind();
+		UnionFind& operator=(const UnionFind& sets);  // Copy assignment
+		UnionFind& operator=(UnionFind&& sets) noexcept;  // Move assignment
+		std::size_t size() const;
+		std::size_t setCount() const;
+		std::uint32_t find(std::uint32_t element);
+		bool unite(std::uint32_t element1, std::uint32_t element2);
+		bool connected(std::uint32_t element1, std::uint32_t element2);
+		void reset();
+
+	private:
+		std::size_t numElements{ 0 };
+		std::size_t numSets{ 0 };
+		std::uint32_t* parents{ nullptr };  // Roots are their own parents
+		std::uint8_t* ranks{ nullptr };  // Upper bound on the height of the tree under each root
+
+		void copyFrom(const UnionFind& sets);
+		void checkElement(std::uint32_t element) const;
+	};
+}
+#include "UnionFind.hpp"
+#endif
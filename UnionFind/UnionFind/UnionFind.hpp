@@ -0,0 +1,162 @@
+#ifndef JML_UNION_FIND_HPP
+#define JML_UNION_FIND_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace JML
+{
+	// Creates numElements singleton sets. Raises std::length_error if the elements don't fit in 32-bit ids
+	inline UnionFind::UnionFind(std::size_t numElements) :
+		numElements{ numElements }, numSets{ numElements }
+	{
+		if (numElements > UINT32_MAX)
+			throw std::length_error("UnionFind supports at most 2^32 - 1 elements");
+
+		parents = new std::uint32_t[numElements];
+		ranks = new std::uint8_t[numElements];
+		reset();
+	}
+
+	// Copy constructor
+	inline UnionFind::UnionFind(const UnionFind& sets)
+	{
+		copyFrom(sets);
+	}
+
+	// Move constructor
+	inline UnionFind::UnionFind(UnionFind&& sets) noexcept :
+		numElements{ sets.numElements }, numSets{ sets.numSets }, parents{ sets.parents }, ranks{ sets.ranks }
+	{
+		sets.numElements = 0;
+		sets.numSets = 0;
+		sets.parents = nullptr;
+		sets.ranks = nullptr;
+	}
+
+	inline UnionFind::~UnionFind()
+	{
+		delete[] parents;
+		delete[] ranks;
+	}
+
+	// Copy assignment
+	inline UnionFind& UnionFind::operator=(const UnionFind& sets)
+	{
+		if (&sets == this)
+			return *this;
+
+		delete[] parents;
+		delete[] ranks;
+		copyFrom(sets);
+		return *this;
+	}
+
+	// Move assignment
+	inline UnionFind& UnionFind::operator=(UnionFind&& sets) noexcept
+	{
+		if (&sets == this)
+			return *this;
+
+		delete[] parents;
+		delete[] ranks;
+		numElements = sets.numElements;
+		numSets = sets.numSets;
+		parents = sets.parents;
+		ranks = sets.ranks;
+
+		sets.numElements = 0;
+		sets.numSets = 0;
+		sets.parents = nullptr;
+		sets.ranks = nullptr;
+
+		return *this;
+	}
+
+	// Returns the number of elements
+	inline std::size_t UnionFind::size() const
+	{
+		return numElements;
+	}
+
+	// Returns the number of disjoint sets
+	inline std::size_t UnionFind::setCount() const
+	{
+		return numSets;
+	}
+
+	// Returns the representative of the set containing the given element. Raises std::out_of_range for an element outside the sets
+	inline std::uint32_t UnionFind::find(std::uint32_t element)
+	{
+		checkElement(element);
+
+		// Path halving: every visited element skips to its grandparent, which flattens the path without a second pass or a stack
+		while (parents[element] != element)
+		{
+			parents[element] = parents[parents[element]];
+			element = parents[element];
+		}
+		return element;
+	}
+
+	// Merges the sets containing the given elements. Returns false if they were already in the same set
+	inline bool UnionFind::unite(std::uint32_t element1, std::uint32_t element2)
+	{
+		std::uint32_t root1{ find(element1) };
+		std::uint32_t root2{ find(element2) };
+		if (root1 == root2)
+			return false;
+
+		// Hanging the shorter tree under the taller one. Ranks only grow when two trees of equal rank meet, so they stay below 32
+		if (ranks[root1] < ranks[root2])
+			parents[root1] = root2;
+		else
+		{
+			parents[root2] = root1;
+			if (ranks[root1] == ranks[root2])
+				++ranks[root1];
+		}
+		--numSets;
+		return true;
+	}
+
+	// Returns true if the given elements are in the same set
+	inline bool UnionFind::connected(std::uint32_t element1, std::uint32_t element2)
+	{
+		return find(element1) == find(element2);
+	}
+
+	// Puts every element back into its own set
+	inline void UnionFind::reset()
+	{
+		for (std::size_t i{ 0 }; i < numElements; ++i)
+		{
+			parents[i] = static_cast<std::uint32_t>(i);
+			ranks[i] = 0;
+		}
+		numSets = numElements;
+	}
+
+	// Copies the given sets into fresh arrays. Any previous arrays must already be freed
+	inline void UnionFind::copyFrom(const UnionFind& sets)
+	{
+		numElements = sets.numElements;
+		numSets = sets.numSets;
+		parents = new std::uint32_t[numElements];
+		ranks = new std::uint8_t[numElements];
+		for (std::size_t i{ 0 }; i < numElements; ++i)
+		{
+			parents[i] = sets.parents[i];
+			ranks[i] = sets.ranks[i];
+		}
+	}
+
+	// Raises std::out_of_range if the given element is outside the sets
+	inline void UnionFind::checkElement(std::uint32_t element) const
+	{
+		if (element >= numElements)
+			throw std::out_of_range("Element is outside the sets");
+	}
+}
+#endif
@@ -0,0 +1,129 @@
+#if 0
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#include "UnionFind.h"
+
+// Sizes are kept small because the naive baseline takes quadratic time, both on random unions and on a chain
+constexpr std::uint32_t NUM_ELEMENTS{ 100000 };
+constexpr std::uint32_t NUM_UNIONS{ 100000 };
+constexpr std::uint32_t NUM_FINDS{ 100000 };
+constexpr std::uint32_t CHAIN_LENGTH{ 30000 };
+
+// Baseline: every union hangs the first root under the second and finds walk the whole path without shortening it
+class NaiveUnionFind
+{
+public:
+	NaiveUnionFind(std::uint32_t numElements) :
+		parents{ new std::uint32_t[numElements] }
+	{
+		for (std::uint32_t i{ 0 }; i < numElements; ++i)
+		{
+			parents[i] = i;
+		}
+	}
+
+	~NaiveUnionFind()
+	{
+		delete[] parents;
+	}
+
+	std::uint32_t find(std::uint32_t element) const
+	{
+		while (parents[element] != element)
+		{
+			element = parents[element];
+		}
+		return element;
+	}
+
+	bool unite(std::uint32_t element1, std::uint32_t element2)
+	{
+		std::uint32_t root1{ find(element1) };
+		std::uint32_t root2{ find(element2) };
+		if (root1 == root2)
+			return false;
+
+		parents[root1] = root2;
+		return true;
+	}
+
+private:
+	std::uint32_t* parents{};
+};
+
+// Returns the milliseconds elapsed since start
+long long elapsed(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Unites random pairs and then finds random elements. Returns the number of unions that merged two sets plus the sum of the representatives
+template <typename Sets>
+std::uint64_t randomWorkload(Sets& sets)
+{
+	std::mt19937 generator{ 1 };
+	std::uniform_int_distribution<std::uint32_t> distribution{ 0, NUM_ELEMENTS - 1 };
+	std::uint64_t checksum{ 0 };
+	for (std::uint32_t i{ 0 }; i < NUM_UNIONS; ++i)
+	{
+		checksum += sets.unite(distribution(generator), distribution(generator));
+	}
+	for (std::uint32_t i{ 0 }; i < NUM_FINDS; ++i)
+	{
+		checksum += sets.find(distribution(generator));
+	}
+	return checksum;
+}
+
+// Unites each element with the next one and then finds the first element repeatedly, which builds one long path for the naive version
+template <typename Sets>
+std::uint64_t chainWorkload(Sets& sets)
+{
+	std::uint64_t checksum{ 0 };
+	for (std::uint32_t i{ 0 }; i + 1 < CHAIN_LENGTH; ++i)
+	{
+		checksum += sets.unite(i, i + 1);
+	}
+	for (std::uint32_t i{ 0 }; i < CHAIN_LENGTH; ++i)
+	{
+		checksum += sets.find(0);
+	}
+	return checksum;
+}
+
+int main()
+{
+	std::cout << NUM_UNIONS << " random unions and " << NUM_FINDS << " random finds over " << NUM_ELEMENTS << " elements:\n";
+	auto start{ std::chrono::steady_clock::now() };
+	{
+		NaiveUnionFind naive{ NUM_ELEMENTS };
+		std::uint64_t checksum{ randomWorkload(naive) };
+		std::cout << "  naive: " << elapsed(start) << " ms (checksum " << checksum << ")\n";
+	}
+	start = std::chrono::steady_clock::now();
+	{
+		JML::UnionFind sets{ NUM_ELEMENTS };
+		std::uint64_t checksum{ randomWorkload(sets) };
+		std::cout << "  UnionFind: " << elapsed(start) << " ms (checksum " << checksum << ", " << sets.setCount() << " sets)\n";
+	}
+
+	std::cout << "Chain of " << CHAIN_LENGTH << " unions followed by " << CHAIN_LENGTH << " finds from its end:\n";
+	start = std::chrono::steady_clock::now();
+	{
+		NaiveUnionFind naive{ CHAIN_LENGTH };
+		std::uint64_t checksum{ chainWorkload(naive) };
+		std::cout << "  naive: " << elapsed(start) << " ms (checksum " << checksum << ")\n";
+	}
+	start = std::chrono::steady_clock::now();
+	{
+		JML::UnionFind sets{ CHAIN_LENGTH };
+		std::uint64_t checksum{ chainWorkload(sets) };
+		std::cout << "  UnionFind: " << elapsed(start) << " ms (checksum " << checksum << ")\n";
+	}
+	return 0;
+}
+#endif
@@ -0,0 +1,25 @@
+#if 1
+#include <iostream>
+
+#include "UnionFind.h"
+
+int main()
+{
+	std::cout << "Ten elements in their own sets:\n";
+	JML::UnionFind sets{ 10 };
+	std::cout << "Sets: " << sets.setCount() << '\n';
+
+	sets.unite(0, 1);
+	sets.unite(2, 3);
+	sets.unite(1, 3);
+	sets.unite(7, 8);
+	std::cout << "Uniting 0 and 1, 2 and 3, 1 and 3, 7 and 8 leaves " << sets.setCount() << " sets\n";
+	std::cout << "Uniting 0 and 2 again merges: " << sets.unite(0, 2) << '\n';
+	std::cout << "0 and 3 connected: " << sets.connected(0, 3) << ", 0 and 7 connected: " << sets.connected(0, 7) << '\n';
+	std::cout << "Representative of 2: " << sets.find(2) << ", representative of 8: " << sets.find(8) << '\n';
+
+	sets.reset();
+	std::cout << "Sets after reset: " << sets.setCount() << '\n';
+	return 0;
+}
+#endif